@@ -0,0 +1,322 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "../ds/Vector.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Parallel algorithms over random-access ranges (and Vector), run on a ThreadPool.
+//
+// Every algorithm takes a grain size: the number of elements below which a piece of
+// work is no longer split and runs serially. Larger grains mean less scheduling
+// overhead, smaller grains better load balance when the per-element cost varies.
+// Pass 0 to let the algorithm pick one (about eight chunks per thread, and never
+// fewer than AUTO_GRAIN_MIN elements per chunk).
+//
+// The reductions (parallelReduce, parallelInclusiveScan) require op to be associative;
+// they combine partial results in order, so op need not be commutative.
+
+constexpr std::size_t AUTO_GRAIN_MIN = 1024;
+
+// Keeps the iterator overloads out of overload resolution for the Vector overloads
+template <typename It>
+using RequireRandomAccess = std::enable_if_t<std::is_base_of_v<
+    std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>>;
+
+// @brief The grain used when a caller passes 0.
+// @param count Number of elements in the range.
+// @param pool The pool the work will run on.
+inline std::size_t autoGrain(std::size_t count, const ThreadPool& pool) noexcept {
+  return std::max(AUTO_GRAIN_MIN, count / (pool.concurrency() * 8));
+}
+
+// Recursively halves [begin, end) until pieces are at most grain long, handing the
+// upper halves to the group so idle workers can steal them.
+template <typename Fn>
+void splitRange(TaskGroup& group, std::size_t begin, std::size_t end, std::size_t grain,
+                const Fn& fn) {
+  while (end - begin > grain) {
+    const std::size_t mid = begin + (end - begin) / 2;
+    group.run([&group, mid, end, grain, &fn] { splitRange(group, mid, end, grain, fn); });
+    end = mid;
+  }
+
+  fn(begin, end);
+}
+
+// @brief Run fn(begin, end) over pieces covering [0, count), in parallel.
+// @param pool The pool to run on.
+// @param count Size of the index range.
+// @param grain Maximum piece length (must be positive).
+// @param fn Callable taking (std::size_t begin, std::size_t end).
+template <typename Fn>
+void parallelChunks(ThreadPool& pool, std::size_t count, std::size_t grain, const Fn& fn) {
+  if (count == 0) {
+    return;
+  }
+
+  TaskGroup group(pool);
+  splitRange(group, 0, count, grain, fn);
+  group.wait();
+}
+
+
+// @brief Apply fn to every element of [first, last).
+// @param grain Elements per task (0: automatic).
+template <typename RandomIt, typename Fn, typename = RequireRandomAccess<RandomIt>>
+void parallelForEach(ThreadPool& pool, RandomIt first, RandomIt last, Fn fn,
+                     std::size_t grain = 0) {
+  const std::size_t count = static_cast<std::size_t>(last - first);
+  parallelChunks(pool, count, grain ? grain : autoGrain(count, pool),
+                 [&](std::size_t begin, std::size_t end) {
+                   std::for_each(first + begin, first + end, fn);
+                 });
+}
+
+// @brief Write fn(x) for every x in [first, last) to the range starting at out.
+// @param grain Elements per task (0: automatic).
+template <typename RandomIt, typename OutputIt, typename Fn,
+          typename = RequireRandomAccess<RandomIt>>
+void parallelTransform(ThreadPool& pool, RandomIt first, RandomIt last, OutputIt out, Fn fn,
+                       std::size_t grain = 0) {
+  const std::size_t count = static_cast<std::size_t>(last - first);
+  parallelChunks(pool, count, grain ? grain : autoGrain(count, pool),
+                 [&](std::size_t begin, std::size_t end) {
+                   std::transform(first + begin, first + end, out + begin, fn);
+                 });
+}
+
+// @brief Fold [first, last) into init with an associative op.
+// @param grain Elements per task (0: automatic).
+// @return init op x0 op x1 op ... op xn-1.
+template <typename RandomIt, typename T, typename BinaryOp = std::plus<>,
+          typename = RequireRandomAccess<RandomIt>>
+T parallelReduce(ThreadPool& pool, RandomIt first, RandomIt last, T init, BinaryOp op = {},
+                 std::size_t grain = 0) {
+  const std::size_t count = static_cast<std::size_t>(last - first);
+  if (count == 0) {
+    return init;
+  }
+  if (grain == 0) {
+    grain = autoGrain(count, pool);
+  }
+
+  // One partial per fixed block, so the combine order is deterministic
+  const std::size_t blocks = (count + grain - 1) / grain;
+  Vector<T> partials(blocks, init);
+
+  parallelChunks(pool, blocks, 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t b = begin; b < end; ++b) {
+      RandomIt it = first + b * grain;
+      RandomIt stop = first + std::min(count, (b + 1) * grain);
+      T acc = *it;
+      while (++it != stop) {
+        acc = op(std::move(acc), *it);
+      }
+      partials[b] = std::move(acc);
+    }
+  });
+
+  for (std::size_t b = 0; b < blocks; ++b) {
+    init = op(std::move(init), std::move(partials[b]));
+  }
+  return init;
+}
+
+// @brief Write the running op-fold of [first, last) to the range starting at out.
+// @param grain Elements per block (0: automatic).
+//
+// Two passes over the input: block totals in parallel, a short serial scan of the
+// totals, then every block is scanned again in parallel starting from its carry-in.
+template <typename RandomIt, typename OutputIt, typename BinaryOp = std::plus<>,
+          typename = RequireRandomAccess<RandomIt>>
+void parallelInclusiveScan(ThreadPool& pool, RandomIt first, RandomIt last, OutputIt out,
+                           BinaryOp op = {}, std::size_t grain = 0) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+
+  const std::size_t count = static_cast<std::size_t>(last - first);
+  if (count == 0) {
+    return;
+  }
+  if (grain == 0) {
+    grain = autoGrain(count, pool);
+  }
+
+  const std::size_t blocks = (count + grain - 1) / grain;
+  Vector<T> carries(blocks, *first);
+
+  // Pass 1: totals of every block but the last (the last total is never a carry)
+  parallelChunks(pool, blocks - 1, 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t b = begin; b < end; ++b) {
+      RandomIt it = first + b * grain;
+      RandomIt stop = it + grain;
+      T acc = *it;
+      while (++it != stop) {
+        acc = op(std::move(acc), *it);
+      }
+      carries[b + 1] = std::move(acc);
+    }
+  });
+
+  // carries[b] becomes the fold of all blocks before b
+  for (std::size_t b = 2; b < blocks; ++b) {
+    carries[b] = op(carries[b - 1], carries[b]);
+  }
+
+  // Pass 2: scan each block from its carry-in
+  parallelChunks(pool, blocks, 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t b = begin; b < end; ++b) {
+      const std::size_t blockBegin = b * grain;
+      const std::size_t blockEnd = std::min(count, blockBegin + grain);
+
+      T acc = b == 0 ? T(first[blockBegin]) : op(carries[b], first[blockBegin]);
+      out[blockBegin] = acc;
+      for (std::size_t i = blockBegin + 1; i < blockEnd; ++i) {
+        acc = op(std::move(acc), first[i]);
+        out[i] = acc;
+      }
+    }
+  });
+}
+
+// Reverses [first, last), swapping mirrored pieces of at most grain pairs in parallel
+template <typename RandomIt>
+void parallelReverse(ThreadPool& pool, RandomIt first, RandomIt last, std::size_t grain) {
+  const std::size_t half = static_cast<std::size_t>(last - first) / 2;
+  if (half <= grain) {
+    std::reverse(first, last);
+    return;
+  }
+
+  parallelChunks(pool, half, grain, [first, last](std::size_t begin, std::size_t end) {
+    std::swap_ranges(first + begin, first + end, std::reverse_iterator<RandomIt>(last - begin));
+  });
+}
+
+// Rotates [first, last) so that middle comes first (three parallel reversals); returns
+// the new position of *first
+template <typename RandomIt>
+RandomIt parallelRotate(ThreadPool& pool, RandomIt first, RandomIt middle, RandomIt last,
+                        std::size_t grain) {
+  if (static_cast<std::size_t>(last - first) <= grain) {
+    return std::rotate(first, middle, last);
+  }
+
+  parallelReverse(pool, first, middle, grain);
+  parallelReverse(pool, middle, last, grain);
+  parallelReverse(pool, first, last, grain);
+  return first + (last - middle);
+}
+
+// Merges the sorted runs [first, mid) and [mid, last) in place. Above the grain, the
+// median of the longer run and its partner position in the other run are rotated past
+// each other and the two sides merge as separate tasks, so no level of the sort ends in
+// a serial pass over the whole range.
+template <typename RandomIt, typename Compare>
+void parallelMerge(ThreadPool& pool, RandomIt first, RandomIt mid, RandomIt last,
+                   Compare& comp, std::size_t grain) {
+  if (first == mid || mid == last) {
+    return;
+  }
+  if (static_cast<std::size_t>(last - first) <= grain) {
+    std::inplace_merge(first, mid, last, comp);
+    return;
+  }
+
+  RandomIt leftCut;
+  RandomIt rightCut;
+  if (mid - first >= last - mid) {
+    leftCut = first + (mid - first) / 2;
+    rightCut = std::lower_bound(mid, last, *leftCut, comp);
+  } else {
+    rightCut = mid + (last - mid) / 2;
+    leftCut = std::upper_bound(first, mid, *rightCut, comp);
+  }
+  const RandomIt split = parallelRotate(pool, leftCut, mid, rightCut, grain);
+
+  TaskGroup group(pool);
+  group.run([&pool, first, leftCut, split, &comp, grain] {
+    parallelMerge(pool, first, leftCut, split, comp, grain);
+  });
+  parallelMerge(pool, split, rightCut, last, comp, grain);
+  group.wait();
+}
+
+// Sorts both halves in parallel, then merges them with parallelMerge
+template <typename RandomIt, typename Compare>
+void parallelSortImpl(ThreadPool& pool, RandomIt first, RandomIt last, Compare& comp,
+                      std::size_t grain) {
+  const std::size_t count = static_cast<std::size_t>(last - first);
+  if (count <= grain) {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  const RandomIt mid = first + count / 2;
+  TaskGroup group(pool);
+  group.run([&pool, first, mid, &comp, grain] {
+    parallelSortImpl(pool, first, mid, comp, grain);
+  });
+  parallelSortImpl(pool, mid, last, comp, grain);
+  group.wait();
+
+  parallelMerge(pool, first, mid, last, comp, grain);
+}
+
+// @brief Sort [first, last) (not stable).
+// @param grain Elements sorted serially per task (0: automatic).
+template <typename RandomIt, typename Compare = std::less<>,
+          typename = RequireRandomAccess<RandomIt>>
+void parallelSort(ThreadPool& pool, RandomIt first, RandomIt last, Compare comp = {},
+                  std::size_t grain = 0) {
+  const std::size_t count = static_cast<std::size_t>(last - first);
+  parallelSortImpl(pool, first, last, comp, grain ? grain : autoGrain(count, pool));
+}
+
+
+// Vector overloads
+
+template <typename T, typename Allocator, typename Growth, typename Fn>
+void parallelForEach(ThreadPool& pool, Vector<T, Allocator, Growth>& vec, Fn fn,
+                     std::size_t grain = 0) {
+  parallelForEach(pool, vec.begin(), vec.end(), std::move(fn), grain);
+}
+
+// @brief Resizes out to vec.size() and fills it with fn applied to vec.
+template <typename T, typename A1, typename G1, typename U, typename A2, typename G2,
+          typename Fn>
+void parallelTransform(ThreadPool& pool, const Vector<T, A1, G1>& vec,
+                       Vector<U, A2, G2>& out, Fn fn, std::size_t grain = 0) {
+  out.resize(vec.size());
+  parallelTransform(pool, vec.begin(), vec.end(), out.begin(), std::move(fn), grain);
+}
+
+template <typename T, typename Allocator, typename Growth, typename U,
+          typename BinaryOp = std::plus<>>
+U parallelReduce(ThreadPool& pool, const Vector<T, Allocator, Growth>& vec, U init,
+                 BinaryOp op = {}, std::size_t grain = 0) {
+  return parallelReduce(pool, vec.begin(), vec.end(), std::move(init), std::move(op), grain);
+}
+
+template <typename T, typename Allocator, typename Growth, typename Compare = std::less<>>
+void parallelSort(ThreadPool& pool, Vector<T, Allocator, Growth>& vec, Compare comp = {},
+                  std::size_t grain = 0) {
+  parallelSort(pool, vec.begin(), vec.end(), std::move(comp), grain);
+}
+
+// @brief Resizes out to vec.size() and fills it with the inclusive scan of vec.
+template <typename T, typename A1, typename G1, typename A2, typename G2,
+          typename BinaryOp = std::plus<>>
+void parallelInclusiveScan(ThreadPool& pool, const Vector<T, A1, G1>& vec,
+                           Vector<T, A2, G2>& out, BinaryOp op = {}, std::size_t grain = 0) {
+  out.resize(vec.size());
+  parallelInclusiveScan(pool, vec.begin(), vec.end(), out.begin(), std::move(op), grain);
+}
+
+#endif // PARALLEL_H
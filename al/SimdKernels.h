@@ -0,0 +1,908 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include "../ds/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+// Vectorized search and reduction kernels over contiguous arrays of int32_t, float and
+// uint8_t: find, contains, count, min, max and sum; plus a population count over arrays
+// of 64-bit words and the unpacking of fixed-width bit-packed integers.
+//
+// Each kernel exists in four flavours -- scalar, SSE4.2, AVX2 and AVX-512 (F + BW) --
+// all compiled into the same binary via function target attributes. The best one the
+// running CPU supports is picked once at startup (simdLevel()), so a binary built for
+// baseline x86-64 still uses AVX-512 where available. On other architectures and
+// compilers only the scalar path exists.
+//
+// Results are identical across paths, except that a float sum is reassociated by the
+// vector paths (lane-wise partial sums) and may differ in the last bits, and that min/max
+// over floats containing NaN is unspecified.
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DS_SIMD_X86 1
+#include <immintrin.h>
+#define DS_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define DS_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define DS_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,popcnt")))
+#else
+#define DS_SIMD_X86 0
+#endif
+
+// @brief Instruction set levels, ordered from least to most capable.
+enum class SimdLevel { Scalar, SSE42, AVX2, AVX512 };
+
+// @brief Query the CPU for the widest supported instruction set.
+inline SimdLevel detectSimdLevel() noexcept {
+#if DS_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+    return SimdLevel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+    return SimdLevel::SSE42;
+  }
+#endif
+  return SimdLevel::Scalar;
+}
+
+// @brief The level the kernels dispatch to by default (detected once, then cached).
+inline SimdLevel simdLevel() noexcept {
+  static const SimdLevel level = detectSimdLevel();
+  return level;
+}
+
+// @brief Accumulator type of simdSum: wide enough that summing any Vector cannot overflow.
+template <typename T>
+struct SimdSumType;
+
+template <>
+struct SimdSumType<std::int32_t> {
+  using type = std::int64_t;
+};
+
+template <>
+struct SimdSumType<std::uint8_t> {
+  using type = std::uint64_t;
+};
+
+template <>
+struct SimdSumType<float> {
+  using type = float;
+};
+
+template <typename T>
+using SimdSum = typename SimdSumType<T>::type;
+
+template <typename T>
+inline constexpr bool isSimdElement_v = std::is_same_v<T, std::int32_t> ||
+                                        std::is_same_v<T, std::uint8_t> ||
+                                        std::is_same_v<T, float>;
+
+// @brief Number of set bits in one word.
+//
+// Without a popcnt target the builtin expands to the same bit-parallel sequence as the
+// portable fallback, so callers that count many words should use simdPopcount instead.
+constexpr unsigned popcountWord(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// @brief Read the width-bit integer starting at bit position bit of a packed word array.
+//
+// Bits are numbered from the least significant bit of words[0]; a value may straddle two
+// words. width may be 0 (the result is 0, and nothing is read) up to 64.
+constexpr std::uint64_t extractBits(const std::uint64_t* words, std::size_t bit,
+                                    unsigned width) noexcept {
+  if (width == 0) {
+    return 0;
+  }
+
+  const std::size_t shift = bit % 64;
+  std::uint64_t value = words[bit / 64] >> shift;
+  if (shift + width > 64) {
+    value |= words[bit / 64 + 1] << (64 - shift);
+  }
+  return width == 64 ? value : value & ((std::uint64_t{1} << width) - 1);
+}
+
+
+// @brief Portable reference kernels; also used for the tails of the vector kernels.
+struct SimdScalar {
+  template <typename T>
+  static std::size_t find(const T* data, std::size_t count, T value) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (data[i] == value) {
+        return i;
+      }
+    }
+    return count;
+  }
+
+  template <typename T>
+  static std::size_t count(const T* data, std::size_t count, T value) noexcept {
+    std::size_t matches = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      matches += data[i] == value;
+    }
+    return matches;
+  }
+
+  // Precondition for min/max: count > 0
+  template <typename T>
+  static T min(const T* data, std::size_t count) noexcept {
+    T result = data[0];
+    for (std::size_t i = 1; i < count; ++i) {
+      result = data[i] < result ? data[i] : result;
+    }
+    return result;
+  }
+
+  template <typename T>
+  static T max(const T* data, std::size_t count) noexcept {
+    T result = data[0];
+    for (std::size_t i = 1; i < count; ++i) {
+      result = result < data[i] ? data[i] : result;
+    }
+    return result;
+  }
+
+  template <typename T>
+  static SimdSum<T> sum(const T* data, std::size_t count) noexcept {
+    SimdSum<T> total = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      total += data[i];
+    }
+    return total;
+  }
+
+  static std::size_t popcount(const std::uint64_t* words, std::size_t count) noexcept {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      total += popcountWord(words[i]);
+    }
+    return total;
+  }
+
+  // Precondition for unpack32: width <= 32
+  static void unpack32(const std::uint64_t* words, unsigned width, std::uint32_t* out,
+                       std::size_t count) noexcept {
+    unpack32From(words, width, out, 0, count);
+  }
+
+  // Unpacks values [first, count), for the tails of the vector kernels
+  static void unpack32From(const std::uint64_t* words, unsigned width, std::uint32_t* out,
+                           std::size_t first, std::size_t count) noexcept {
+    for (std::size_t i = first; i < count; ++i) {
+      out[i] = static_cast<std::uint32_t>(extractBits(words, i * width, width));
+    }
+  }
+};
+
+
+#if DS_SIMD_X86
+
+// The three vector levels share one shape: a Lanes<T> table of register operations,
+// and generic kernels written against it. Both carry the level's target attribute, so
+// the generic code is compiled once per level with the right instruction set.
+//
+// Lanes<T> provides: width (elements per register), load, broadcast, equalMask (one bit
+// per lane), min, max, store, and a widened sum accumulator (sumZero/sumAdd/sumReduce).
+
+#define DS_SIMD_GENERIC_KERNELS(TARGET)                                                     \
+  template <typename T>                                                                     \
+  TARGET static std::size_t find(const T* data, std::size_t count, T value) noexcept {     \
+    using L = Lanes<T>;                                                                     \
+    const auto needle = L::broadcast(value);                                                \
+    std::size_t i = 0;                                                                      \
+    for (; i + L::width <= count; i += L::width) {                                          \
+      const std::uint64_t mask = L::equalMask(L::load(data + i), needle);                   \
+      if (mask != 0) {                                                                      \
+        return i + static_cast<std::size_t>(__builtin_ctzll(mask));                         \
+      }                                                                                     \
+    }                                                                                       \
+    return i + SimdScalar::find(data + i, count - i, value);                                \
+  }                                                                                         \
+                                                                                            \
+  template <typename T>                                                                     \
+  TARGET static std::size_t count(const T* data, std::size_t count, T value) noexcept {    \
+    using L = Lanes<T>;                                                                     \
+    const auto needle = L::broadcast(value);                                                \
+    std::size_t matches = 0;                                                                \
+    std::size_t i = 0;                                                                      \
+    for (; i + L::width <= count; i += L::width) {                                          \
+      matches += static_cast<std::size_t>(                                                  \
+          __builtin_popcountll(L::equalMask(L::load(data + i), needle)));                   \
+    }                                                                                       \
+    return matches + SimdScalar::count(data + i, count - i, value);                         \
+  }                                                                                         \
+                                                                                            \
+  template <typename T>                                                                     \
+  TARGET static T min(const T* data, std::size_t count) noexcept {                          \
+    using L = Lanes<T>;                                                                     \
+    if (count < L::width) {                                                                 \
+      return SimdScalar::min(data, count);                                                  \
+    }                                                                                       \
+    auto acc = L::load(data);                                                               \
+    std::size_t i = L::width;                                                               \
+    for (; i + L::width <= count; i += L::width) {                                          \
+      acc = L::min(acc, L::load(data + i));                                                 \
+    }                                                                                       \
+    alignas(64) T lanes[L::width];                                                          \
+    L::store(lanes, acc);                                                                   \
+    T result = SimdScalar::min(lanes, L::width);                                            \
+    if (i < count) {                                                                        \
+      const T tail = SimdScalar::min(data + i, count - i);                                  \
+      result = tail < result ? tail : result;                                               \
+    }                                                                                       \
+    return result;                                                                          \
+  }                                                                                         \
+                                                                                            \
+  template <typename T>                                                                     \
+  TARGET static T max(const T* data, std::size_t count) noexcept {                          \
+    using L = Lanes<T>;                                                                     \
+    if (count < L::width) {                                                                 \
+      return SimdScalar::max(data, count);                                                  \
+    }                                                                                       \
+    auto acc = L::load(data);                                                               \
+    std::size_t i = L::width;                                                               \
+    for (; i + L::width <= count; i += L::width) {                                          \
+      acc = L::max(acc, L::load(data + i));                                                 \
+    }                                                                                       \
+    alignas(64) T lanes[L::width];                                                          \
+    L::store(lanes, acc);                                                                   \
+    T result = SimdScalar::max(lanes, L::width);                                            \
+    if (i < count) {                                                                        \
+      const T tail = SimdScalar::max(data + i, count - i);                                  \
+      result = result < tail ? tail : result;                                               \
+    }                                                                                       \
+    return result;                                                                          \
+  }                                                                                         \
+                                                                                            \
+  template <typename T>                                                                     \
+  TARGET static SimdSum<T> sum(const T* data, std::size_t count) noexcept {                 \
+    using L = Lanes<T>;                                                                     \
+    auto acc = L::sumZero();                                                                \
+    std::size_t i = 0;                                                                      \
+    for (; i + L::width <= count; i += L::width) {                                          \
+      acc = L::sumAdd(acc, L::load(data + i));                                              \
+    }                                                                                       \
+    return L::sumReduce(acc) + SimdScalar::sum(data + i, count - i);                        \
+  }
+
+
+// @brief SSE4.2 kernels: 128-bit registers.
+struct SimdSse42 {
+  template <typename T>
+  struct Lanes;
+
+  DS_SIMD_GENERIC_KERNELS(DS_TARGET_SSE42)
+
+  // One popcnt instruction per word
+  DS_TARGET_SSE42 static std::size_t popcount(const std::uint64_t* words,
+                                              std::size_t count) noexcept {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      total += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return total;
+  }
+
+  // No variable per-lane shifts before AVX2
+  static void unpack32(const std::uint64_t* words, unsigned width, std::uint32_t* out,
+                       std::size_t count) noexcept {
+    SimdScalar::unpack32(words, width, out, count);
+  }
+};
+
+template <>
+struct SimdSse42::Lanes<std::int32_t> {
+  static constexpr std::size_t width = 4;
+
+  DS_TARGET_SSE42 static __m128i load(const std::int32_t* p) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  DS_TARGET_SSE42 static __m128i broadcast(std::int32_t v) noexcept {
+    return _mm_set1_epi32(v);
+  }
+  DS_TARGET_SSE42 static std::uint64_t equalMask(__m128i a, __m128i b) noexcept {
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+  }
+  DS_TARGET_SSE42 static __m128i min(__m128i a, __m128i b) noexcept {
+    return _mm_min_epi32(a, b);
+  }
+  DS_TARGET_SSE42 static __m128i max(__m128i a, __m128i b) noexcept {
+    return _mm_max_epi32(a, b);
+  }
+  DS_TARGET_SSE42 static void store(std::int32_t* p, __m128i v) noexcept {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+  }
+
+  // Two 64-bit lanes, fed by sign-extending each half of the register
+  DS_TARGET_SSE42 static __m128i sumZero() noexcept {
+    return _mm_setzero_si128();
+  }
+  DS_TARGET_SSE42 static __m128i sumAdd(__m128i acc, __m128i v) noexcept {
+    acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(v));
+    return _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+  }
+  DS_TARGET_SSE42 static std::int64_t sumReduce(__m128i acc) noexcept {
+    alignas(16) std::int64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1];
+  }
+};
+
+template <>
+struct SimdSse42::Lanes<std::uint8_t> {
+  static constexpr std::size_t width = 16;
+
+  DS_TARGET_SSE42 static __m128i load(const std::uint8_t* p) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  DS_TARGET_SSE42 static __m128i broadcast(std::uint8_t v) noexcept {
+    return _mm_set1_epi8(static_cast<char>(v));
+  }
+  DS_TARGET_SSE42 static std::uint64_t equalMask(__m128i a, __m128i b) noexcept {
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+  }
+  DS_TARGET_SSE42 static __m128i min(__m128i a, __m128i b) noexcept {
+    return _mm_min_epu8(a, b);
+  }
+  DS_TARGET_SSE42 static __m128i max(__m128i a, __m128i b) noexcept {
+    return _mm_max_epu8(a, b);
+  }
+  DS_TARGET_SSE42 static void store(std::uint8_t* p, __m128i v) noexcept {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+  }
+
+  // psadbw against zero sums each group of 8 bytes into a 64-bit lane
+  DS_TARGET_SSE42 static __m128i sumZero() noexcept {
+    return _mm_setzero_si128();
+  }
+  DS_TARGET_SSE42 static __m128i sumAdd(__m128i acc, __m128i v) noexcept {
+    return _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+  }
+  DS_TARGET_SSE42 static std::uint64_t sumReduce(__m128i acc) noexcept {
+    alignas(16) std::uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1];
+  }
+};
+
+template <>
+struct SimdSse42::Lanes<float> {
+  static constexpr std::size_t width = 4;
+
+  DS_TARGET_SSE42 static __m128 load(const float* p) noexcept {
+    return _mm_loadu_ps(p);
+  }
+  DS_TARGET_SSE42 static __m128 broadcast(float v) noexcept {
+    return _mm_set1_ps(v);
+  }
+  DS_TARGET_SSE42 static std::uint64_t equalMask(__m128 a, __m128 b) noexcept {
+    return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(a, b)));
+  }
+  DS_TARGET_SSE42 static __m128 min(__m128 a, __m128 b) noexcept {
+    return _mm_min_ps(a, b);
+  }
+  DS_TARGET_SSE42 static __m128 max(__m128 a, __m128 b) noexcept {
+    return _mm_max_ps(a, b);
+  }
+  DS_TARGET_SSE42 static void store(float* p, __m128 v) noexcept {
+    _mm_storeu_ps(p, v);
+  }
+
+  DS_TARGET_SSE42 static __m128 sumZero() noexcept {
+    return _mm_setzero_ps();
+  }
+  DS_TARGET_SSE42 static __m128 sumAdd(__m128 acc, __m128 v) noexcept {
+    return _mm_add_ps(acc, v);
+  }
+  DS_TARGET_SSE42 static float sumReduce(__m128 acc) noexcept {
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  }
+};
+
+
+// @brief AVX2 kernels: 256-bit registers.
+struct SimdAvx2 {
+  template <typename T>
+  struct Lanes;
+
+  DS_SIMD_GENERIC_KERNELS(DS_TARGET_AVX2)
+
+  // Nibble lookup with vpshufb, byte counts summed into 64-bit lanes with vpsadbw;
+  // outruns scalar popcnt once the words no longer fit in L1
+  DS_TARGET_AVX2 static std::size_t popcount(const std::uint64_t* words,
+                                             std::size_t count) noexcept {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibble = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+      const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, lowNibble));
+      const __m256i hi =
+          _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibble));
+      acc = _mm256_add_epi64(
+          acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    std::size_t total = static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    for (; i < count; ++i) {
+      total += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return total;
+  }
+
+  // Eight values span exactly width bytes, so every group gathers the same byte offsets
+  // (relative to a pointer advanced by width) and shifts by the same amounts. A 32-bit
+  // load at a value's first byte holds all of it while width <= 25; wider values go
+  // through the scalar path.
+  DS_TARGET_AVX2 static void unpack32(const std::uint64_t* words, unsigned width,
+                                      std::uint32_t* out, std::size_t count) noexcept {
+    if (width == 0 || width > 25) {
+      SimdScalar::unpack32(words, width, out, count);
+      return;
+    }
+
+    const __m256i bit =
+        _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                           _mm256_set1_epi32(static_cast<int>(width)));
+    const __m256i offsets = _mm256_srli_epi32(bit, 3);
+    const __m256i shifts = _mm256_and_si256(bit, _mm256_set1_epi32(7));
+    const __m256i mask = _mm256_set1_epi32(static_cast<int>((1u << width) - 1));
+
+    const char* group = reinterpret_cast<const char*>(words);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8, group += width) {
+      const __m256i raw = _mm256_i32gather_epi32(reinterpret_cast<const int*>(group), offsets, 1);
+      const __m256i values = _mm256_and_si256(_mm256_srlv_epi32(raw, shifts), mask);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+    }
+    SimdScalar::unpack32From(words, width, out, i, count);
+  }
+};
+
+template <>
+struct SimdAvx2::Lanes<std::int32_t> {
+  static constexpr std::size_t width = 8;
+
+  DS_TARGET_AVX2 static __m256i load(const std::int32_t* p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  DS_TARGET_AVX2 static __m256i broadcast(std::int32_t v) noexcept {
+    return _mm256_set1_epi32(v);
+  }
+  DS_TARGET_AVX2 static std::uint64_t equalMask(__m256i a, __m256i b) noexcept {
+    return static_cast<unsigned>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+  }
+  DS_TARGET_AVX2 static __m256i min(__m256i a, __m256i b) noexcept {
+    return _mm256_min_epi32(a, b);
+  }
+  DS_TARGET_AVX2 static __m256i max(__m256i a, __m256i b) noexcept {
+    return _mm256_max_epi32(a, b);
+  }
+  DS_TARGET_AVX2 static void store(std::int32_t* p, __m256i v) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+
+  DS_TARGET_AVX2 static __m256i sumZero() noexcept {
+    return _mm256_setzero_si256();
+  }
+  DS_TARGET_AVX2 static __m256i sumAdd(__m256i acc, __m256i v) noexcept {
+    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+    return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+  }
+  DS_TARGET_AVX2 static std::int64_t sumReduce(__m256i acc) noexcept {
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  }
+};
+
+template <>
+struct SimdAvx2::Lanes<std::uint8_t> {
+  static constexpr std::size_t width = 32;
+
+  DS_TARGET_AVX2 static __m256i load(const std::uint8_t* p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  DS_TARGET_AVX2 static __m256i broadcast(std::uint8_t v) noexcept {
+    return _mm256_set1_epi8(static_cast<char>(v));
+  }
+  DS_TARGET_AVX2 static std::uint64_t equalMask(__m256i a, __m256i b) noexcept {
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+  }
+  DS_TARGET_AVX2 static __m256i min(__m256i a, __m256i b) noexcept {
+    return _mm256_min_epu8(a, b);
+  }
+  DS_TARGET_AVX2 static __m256i max(__m256i a, __m256i b) noexcept {
+    return _mm256_max_epu8(a, b);
+  }
+  DS_TARGET_AVX2 static void store(std::uint8_t* p, __m256i v) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+
+  DS_TARGET_AVX2 static __m256i sumZero() noexcept {
+    return _mm256_setzero_si256();
+  }
+  DS_TARGET_AVX2 static __m256i sumAdd(__m256i acc, __m256i v) noexcept {
+    return _mm256_add_epi64(acc, _mm256_sad_epu8(v, _mm256_setzero_si256()));
+  }
+  DS_TARGET_AVX2 static std::uint64_t sumReduce(__m256i acc) noexcept {
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  }
+};
+
+template <>
+struct SimdAvx2::Lanes<float> {
+  static constexpr std::size_t width = 8;
+
+  DS_TARGET_AVX2 static __m256 load(const float* p) noexcept {
+    return _mm256_loadu_ps(p);
+  }
+  DS_TARGET_AVX2 static __m256 broadcast(float v) noexcept {
+    return _mm256_set1_ps(v);
+  }
+  DS_TARGET_AVX2 static std::uint64_t equalMask(__m256 a, __m256 b) noexcept {
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+  }
+  DS_TARGET_AVX2 static __m256 min(__m256 a, __m256 b) noexcept {
+    return _mm256_min_ps(a, b);
+  }
+  DS_TARGET_AVX2 static __m256 max(__m256 a, __m256 b) noexcept {
+    return _mm256_max_ps(a, b);
+  }
+  DS_TARGET_AVX2 static void store(float* p, __m256 v) noexcept {
+    _mm256_storeu_ps(p, v);
+  }
+
+  DS_TARGET_AVX2 static __m256 sumZero() noexcept {
+    return _mm256_setzero_ps();
+  }
+  DS_TARGET_AVX2 static __m256 sumAdd(__m256 acc, __m256 v) noexcept {
+    return _mm256_add_ps(acc, v);
+  }
+  DS_TARGET_AVX2 static float sumReduce(__m256 acc) noexcept {
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, acc);
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+           ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+  }
+};
+
+
+// @brief AVX-512 kernels: 512-bit registers and native compare masks.
+struct SimdAvx512 {
+  template <typename T>
+  struct Lanes;
+
+  DS_SIMD_GENERIC_KERNELS(DS_TARGET_AVX512)
+
+  // The AVX2 nibble lookup at twice the width (vpshufb and vpsadbw need AVX-512 BW)
+  DS_TARGET_AVX512 static std::size_t popcount(const std::uint64_t* words,
+                                               std::size_t count) noexcept {
+    const __m512i lookup = _mm512_broadcast_i32x4(
+        _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const __m512i lowNibble = _mm512_set1_epi8(0x0f);
+    __m512i acc = _mm512_setzero_si512();
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+      const __m512i v = _mm512_loadu_si512(words + i);
+      const __m512i lo = _mm512_shuffle_epi8(lookup, _mm512_and_si512(v, lowNibble));
+      const __m512i hi =
+          _mm512_shuffle_epi8(lookup, _mm512_and_si512(_mm512_srli_epi16(v, 4), lowNibble));
+      acc = _mm512_add_epi64(
+          acc, _mm512_sad_epu8(_mm512_add_epi8(lo, hi), _mm512_setzero_si512()));
+    }
+
+    std::size_t total = static_cast<std::size_t>(_mm512_reduce_add_epi64(acc));
+    for (; i < count; ++i) {
+      total += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return total;
+  }
+
+  // The AVX2 gather scheme with sixteen values (2 * width bytes) per group
+  DS_TARGET_AVX512 static void unpack32(const std::uint64_t* words, unsigned width,
+                                        std::uint32_t* out, std::size_t count) noexcept {
+    if (width == 0 || width > 25) {
+      SimdScalar::unpack32(words, width, out, count);
+      return;
+    }
+
+    const __m512i bit = _mm512_mullo_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm512_set1_epi32(static_cast<int>(width)));
+    const __m512i offsets = _mm512_srli_epi32(bit, 3);
+    const __m512i shifts = _mm512_and_si512(bit, _mm512_set1_epi32(7));
+    const __m512i mask = _mm512_set1_epi32(static_cast<int>((1u << width) - 1));
+
+    const char* group = reinterpret_cast<const char*>(words);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16, group += 2 * width) {
+      const __m512i raw = _mm512_i32gather_epi32(offsets, group, 1);
+      const __m512i values = _mm512_and_si512(_mm512_srlv_epi32(raw, shifts), mask);
+      _mm512_storeu_si512(out + i, values);
+    }
+    SimdScalar::unpack32From(words, width, out, i, count);
+  }
+};
+
+template <>
+struct SimdAvx512::Lanes<std::int32_t> {
+  static constexpr std::size_t width = 16;
+
+  DS_TARGET_AVX512 static __m512i load(const std::int32_t* p) noexcept {
+    return _mm512_loadu_si512(p);
+  }
+  DS_TARGET_AVX512 static __m512i broadcast(std::int32_t v) noexcept {
+    return _mm512_set1_epi32(v);
+  }
+  DS_TARGET_AVX512 static std::uint64_t equalMask(__m512i a, __m512i b) noexcept {
+    return _mm512_cmpeq_epi32_mask(a, b);
+  }
+  DS_TARGET_AVX512 static __m512i min(__m512i a, __m512i b) noexcept {
+    return _mm512_min_epi32(a, b);
+  }
+  DS_TARGET_AVX512 static __m512i max(__m512i a, __m512i b) noexcept {
+    return _mm512_max_epi32(a, b);
+  }
+  DS_TARGET_AVX512 static void store(std::int32_t* p, __m512i v) noexcept {
+    _mm512_storeu_si512(p, v);
+  }
+
+  DS_TARGET_AVX512 static __m512i sumZero() noexcept {
+    return _mm512_setzero_si512();
+  }
+  DS_TARGET_AVX512 static __m512i sumAdd(__m512i acc, __m512i v) noexcept {
+    acc = _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+    return _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+  }
+  DS_TARGET_AVX512 static std::int64_t sumReduce(__m512i acc) noexcept {
+    return _mm512_reduce_add_epi64(acc);
+  }
+};
+
+template <>
+struct SimdAvx512::Lanes<std::uint8_t> {
+  static constexpr std::size_t width = 64;
+
+  DS_TARGET_AVX512 static __m512i load(const std::uint8_t* p) noexcept {
+    return _mm512_loadu_si512(p);
+  }
+  DS_TARGET_AVX512 static __m512i broadcast(std::uint8_t v) noexcept {
+    return _mm512_set1_epi8(static_cast<char>(v));
+  }
+  DS_TARGET_AVX512 static std::uint64_t equalMask(__m512i a, __m512i b) noexcept {
+    return _mm512_cmpeq_epi8_mask(a, b);
+  }
+  DS_TARGET_AVX512 static __m512i min(__m512i a, __m512i b) noexcept {
+    return _mm512_min_epu8(a, b);
+  }
+  DS_TARGET_AVX512 static __m512i max(__m512i a, __m512i b) noexcept {
+    return _mm512_max_epu8(a, b);
+  }
+  DS_TARGET_AVX512 static void store(std::uint8_t* p, __m512i v) noexcept {
+    _mm512_storeu_si512(p, v);
+  }
+
+  DS_TARGET_AVX512 static __m512i sumZero() noexcept {
+    return _mm512_setzero_si512();
+  }
+  DS_TARGET_AVX512 static __m512i sumAdd(__m512i acc, __m512i v) noexcept {
+    return _mm512_add_epi64(acc, _mm512_sad_epu8(v, _mm512_setzero_si512()));
+  }
+  DS_TARGET_AVX512 static std::uint64_t sumReduce(__m512i acc) noexcept {
+    return static_cast<std::uint64_t>(_mm512_reduce_add_epi64(acc));
+  }
+};
+
+template <>
+struct SimdAvx512::Lanes<float> {
+  static constexpr std::size_t width = 16;
+
+  DS_TARGET_AVX512 static __m512 load(const float* p) noexcept {
+    return _mm512_loadu_ps(p);
+  }
+  DS_TARGET_AVX512 static __m512 broadcast(float v) noexcept {
+    return _mm512_set1_ps(v);
+  }
+  DS_TARGET_AVX512 static std::uint64_t equalMask(__m512 a, __m512 b) noexcept {
+    return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+  }
+  DS_TARGET_AVX512 static __m512 min(__m512 a, __m512 b) noexcept {
+    return _mm512_min_ps(a, b);
+  }
+  DS_TARGET_AVX512 static __m512 max(__m512 a, __m512 b) noexcept {
+    return _mm512_max_ps(a, b);
+  }
+  DS_TARGET_AVX512 static void store(float* p, __m512 v) noexcept {
+    _mm512_storeu_ps(p, v);
+  }
+
+  DS_TARGET_AVX512 static __m512 sumZero() noexcept {
+    return _mm512_setzero_ps();
+  }
+  DS_TARGET_AVX512 static __m512 sumAdd(__m512 acc, __m512 v) noexcept {
+    return _mm512_add_ps(acc, v);
+  }
+  DS_TARGET_AVX512 static float sumReduce(__m512 acc) noexcept {
+    return _mm512_reduce_add_ps(acc);
+  }
+};
+
+#undef DS_SIMD_GENERIC_KERNELS
+
+#endif // DS_SIMD_X86
+
+
+// @brief Invoke fn with the kernel set for level, clamped to what the CPU supports.
+// @param level Requested instruction set level.
+// @param fn Callable taking one of SimdScalar, SimdSse42, SimdAvx2, SimdAvx512.
+template <typename Fn>
+decltype(auto) simdDispatch(SimdLevel level, Fn&& fn) {
+  if (level > simdLevel()) {
+    level = simdLevel();
+  }
+
+  switch (level) {
+#if DS_SIMD_X86
+  case SimdLevel::AVX512:
+    return fn(SimdAvx512{});
+  case SimdLevel::AVX2:
+    return fn(SimdAvx2{});
+  case SimdLevel::SSE42:
+    return fn(SimdSse42{});
+#endif
+  default:
+    return fn(SimdScalar{});
+  }
+}
+
+
+// @brief Index of the first element equal to value.
+// @param data Start of the array.
+// @param count Number of elements.
+// @param value The value to search for.
+// @param level Instruction set to use (default: the best available).
+// @return Index of the match, or count if there is none.
+template <typename T>
+std::size_t simdFind(const T* data, std::size_t count, T value, SimdLevel level = simdLevel()) {
+  static_assert(isSimdElement_v<T>, "simdFind: element type must be int32_t, uint8_t or float");
+  return simdDispatch(level, [&](auto kernels) {
+    return decltype(kernels)::find(data, count, value);
+  });
+}
+
+// @brief Check whether any element equals value.
+template <typename T>
+bool simdContains(const T* data, std::size_t count, T value, SimdLevel level = simdLevel()) {
+  return simdFind(data, count, value, level) != count;
+}
+
+// @brief Number of elements equal to value.
+template <typename T>
+std::size_t simdCount(const T* data, std::size_t count, T value, SimdLevel level = simdLevel()) {
+  static_assert(isSimdElement_v<T>, "simdCount: element type must be int32_t, uint8_t or float");
+  return simdDispatch(level, [&](auto kernels) {
+    return decltype(kernels)::count(data, count, value);
+  });
+}
+
+// @brief Smallest element.
+// @throws std::out_of_range if count is 0.
+template <typename T>
+T simdMin(const T* data, std::size_t count, SimdLevel level = simdLevel()) {
+  static_assert(isSimdElement_v<T>, "simdMin: element type must be int32_t, uint8_t or float");
+  if (count == 0) {
+    throw std::out_of_range("Minimum of an empty range");
+  }
+  return simdDispatch(level, [&](auto kernels) { return decltype(kernels)::min(data, count); });
+}
+
+// @brief Largest element.
+// @throws std::out_of_range if count is 0.
+template <typename T>
+T simdMax(const T* data, std::size_t count, SimdLevel level = simdLevel()) {
+  static_assert(isSimdElement_v<T>, "simdMax: element type must be int32_t, uint8_t or float");
+  if (count == 0) {
+    throw std::out_of_range("Maximum of an empty range");
+  }
+  return simdDispatch(level, [&](auto kernels) { return decltype(kernels)::max(data, count); });
+}
+
+// @brief Sum of the elements, accumulated in SimdSum<T>.
+template <typename T>
+SimdSum<T> simdSum(const T* data, std::size_t count, SimdLevel level = simdLevel()) {
+  static_assert(isSimdElement_v<T>, "simdSum: element type must be int32_t, uint8_t or float");
+  return simdDispatch(level, [&](auto kernels) { return decltype(kernels)::sum(data, count); });
+}
+
+// @brief Number of set bits in an array of 64-bit words.
+// @param words Start of the array.
+// @param count Number of words.
+// @param level Instruction set to use (default: the best available).
+inline std::size_t simdPopcount(const std::uint64_t* words, std::size_t count,
+                                SimdLevel level = simdLevel()) {
+  return simdDispatch(level, [&](auto kernels) {
+    return decltype(kernels)::popcount(words, count);
+  });
+}
+
+// @brief Unpack count integers of width bits each, stored back to back from bit 0 of words.
+// @param words The packed values. The vector paths load 32 bits at byte offsets, so up to
+//        3 bytes past the byte holding the last packed bit must be readable.
+// @param width Bits per value, 0 to 32.
+// @param out Destination for count values.
+// @param level Instruction set to use (default: the best available).
+// @throws std::out_of_range if width > 32.
+inline void simdUnpack32(const std::uint64_t* words, unsigned width, std::uint32_t* out,
+                         std::size_t count, SimdLevel level = simdLevel()) {
+  if (width > 32) {
+    throw std::out_of_range("simdUnpack32: width exceeds 32 bits");
+  }
+  simdDispatch(level, [&](auto kernels) { decltype(kernels)::unpack32(words, width, out, count); });
+}
+
+
+// Vector overloads; value is not deduced, so simdFind(floats, 0) works
+
+template <typename T, typename Allocator, typename Growth>
+std::size_t simdFind(const Vector<T, Allocator, Growth>& vec,
+                     typename Vector<T, Allocator, Growth>::value_type value) {
+  return simdFind(vec.data(), vec.size(), value);
+}
+
+template <typename T, typename Allocator, typename Growth>
+bool simdContains(const Vector<T, Allocator, Growth>& vec,
+                  typename Vector<T, Allocator, Growth>::value_type value) {
+  return simdContains(vec.data(), vec.size(), value);
+}
+
+template <typename T, typename Allocator, typename Growth>
+std::size_t simdCount(const Vector<T, Allocator, Growth>& vec,
+                      typename Vector<T, Allocator, Growth>::value_type value) {
+  return simdCount(vec.data(), vec.size(), value);
+}
+
+template <typename T, typename Allocator, typename Growth>
+T simdMin(const Vector<T, Allocator, Growth>& vec) {
+  return simdMin(vec.data(), vec.size());
+}
+
+template <typename T, typename Allocator, typename Growth>
+T simdMax(const Vector<T, Allocator, Growth>& vec) {
+  return simdMax(vec.data(), vec.size());
+}
+
+template <typename T, typename Allocator, typename Growth>
+SimdSum<T> simdSum(const Vector<T, Allocator, Growth>& vec) {
+  return simdSum(vec.data(), vec.size());
+}
+
+#endif // SIMDKERNELS_H
@@ -0,0 +1,264 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// @brief Fixed-size work-stealing thread pool.
+//
+// Every worker owns a deque of tasks. A worker pushes the tasks it spawns onto the back
+// of its own deque and pops from the back (LIFO, so recently split work stays hot in
+// cache); idle workers steal from the front of other workers' deques, which takes the
+// oldest and therefore largest pieces of recursively split work. Tasks submitted from
+// outside the pool are spread round-robin over the deques.
+//
+// A thread that waits on a TaskGroup runs queued tasks while it waits, so a pool with
+// N workers keeps N + 1 cores busy and nested parallelism cannot deadlock. A pool with
+// zero workers is valid: everything then runs on the waiting thread.
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+  // @brief Start the workers.
+  // @param workers Number of worker threads (default: one per core, minus the caller).
+  explicit ThreadPool(std::size_t workers = defaultWorkerCount())
+      : queues_(std::max<std::size_t>(workers, 1)) {
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+      threads_.emplace_back([this, i] { workerLoop(i); });
+    }
+  }
+
+  // @brief Finish all queued tasks, then join the workers.
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (std::thread& thread : threads_) {
+      thread.join();
+    }
+
+    // Without workers nobody drained the queues
+    while (tryRunOne()) {
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // @brief Number of worker threads.
+  std::size_t workerCount() const noexcept {
+    return threads_.size();
+  }
+
+  // @brief Number of threads that run tasks while a caller waits (workers + caller).
+  std::size_t concurrency() const noexcept {
+    return threads_.size() + 1;
+  }
+
+  // @brief Queue a task. Tasks must not throw; use TaskGroup to propagate exceptions.
+  // @param task The task to run.
+  void submit(Task task) {
+    std::size_t index;
+    if (currentPool_ == this) {
+      index = currentIndex_;
+    } else {
+      index = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(queues_[index].mutex);
+      queues_[index].tasks.push_back(std::move(task));
+    }
+
+    queued_.fetch_add(1, std::memory_order_release);
+    {
+      // Pairs with the predicate check in workerLoop so the wakeup cannot be lost
+      std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_one();
+  }
+
+  // @brief Run one queued task on the calling thread, if there is one.
+  // @return true if a task was run.
+  bool tryRunOne() {
+    Task task;
+    if (!popOwn(task) && !steal(task)) {
+      return false;
+    }
+
+    task();
+    return true;
+  }
+
+  // @brief Suggested worker count: hardware threads minus the calling thread.
+  static std::size_t defaultWorkerCount() noexcept {
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+  }
+
+private:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<WorkQueue> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<std::size_t> queued_{0};
+  std::atomic<std::size_t> nextQueue_{0};
+
+  std::mutex sleepMutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+
+  // Identifies the worker running on this thread, if any
+  static inline thread_local const ThreadPool* currentPool_ = nullptr;
+  static inline thread_local std::size_t currentIndex_ = 0;
+
+  void workerLoop(std::size_t index) {
+    currentPool_ = this;
+    currentIndex_ = index;
+
+    while (true) {
+      if (tryRunOne()) {
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(sleepMutex_);
+      wake_.wait(lock, [this] {
+        return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+      });
+
+      if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+    }
+  }
+
+  // Workers take the newest task from their own deque
+  bool popOwn(Task& task) {
+    if (currentPool_ != this) {
+      return false;
+    }
+
+    WorkQueue& queue = queues_[currentIndex_];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Everyone else takes the oldest task from the first non-empty deque
+  bool steal(Task& task) {
+    if (queued_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+
+    const std::size_t start = currentPool_ == this ? currentIndex_ + 1 : 0;
+    for (std::size_t i = 0; i < queues_.size(); ++i) {
+      WorkQueue& queue = queues_[(start + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
+
+// @brief A set of tasks that can be waited on together.
+//
+// run() may be called from inside the group's own tasks (recursive fork-join). wait()
+// runs pool tasks until every task of the group has finished, then rethrows the first
+// exception any of them threw.
+class TaskGroup {
+public:
+  explicit TaskGroup(ThreadPool& pool) : pool_(pool) {
+  }
+
+  // Waits, but swallows exceptions: call wait() explicitly to observe them
+  ~TaskGroup() {
+    try {
+      wait();
+    } catch (...) {
+    }
+  }
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  // @brief Queue a task belonging to this group.
+  // @param fn Callable taking no arguments.
+  template <typename Fn>
+  void run(Fn&& fn) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_.submit([this, fn = std::forward<Fn>(fn)]() mutable {
+      try {
+        fn();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+      }
+      pending_.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  // @brief Help run tasks until the group is done.
+  // @throws The first exception thrown by a task of the group.
+  void wait() {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+      if (!pool_.tryRunOne()) {
+        std::this_thread::yield();
+      }
+    }
+
+    std::exception_ptr error;
+    {
+      std::lock_guard<std::mutex> lock(errorMutex_);
+      std::swap(error, error_);
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  ThreadPool& pool_;
+  std::atomic<std::size_t> pending_{0};
+  std::mutex errorMutex_;
+  std::exception_ptr error_;
+};
+
+// @brief Process-wide pool used when a caller does not bring its own.
+inline ThreadPool& defaultThreadPool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+#endif // THREADPOOL_H
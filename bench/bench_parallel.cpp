@@ -0,0 +1,96 @@
+// Scaling benchmark for the parallel algorithms: runs each one with 1..N threads and
+// prints the wall time and speedup over a single thread.
+//
+// Usage: bench_parallel [elements] [max threads]
+
+#include "../al/Parallel.h"
+#include "../ds/Vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace {
+  template <typename Fn>
+  double timeMs(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+  }
+
+  Vector<float> makeInput(std::size_t count) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    Vector<float> vec;
+    vec.resize_default_init(count);
+    for (float& x : vec) {
+      x = dist(gen);
+    }
+    return vec;
+  }
+
+  // Doubles, but always finishes with the full machine even when it is not a power of two
+  std::size_t nextThreadCount(std::size_t threads, std::size_t maxThreads) {
+    if (threads == maxThreads) {
+      return maxThreads + 1;
+    }
+    return std::min(threads * 2, maxThreads);
+  }
+} // namespace
+
+int main(int argc, char** argv) {
+  const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50'000'000;
+  const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t maxThreads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : hardware;
+
+  const Vector<float> input = makeInput(count);
+  Vector<float> output = input; // Pre-faulted, so the first run is not charged for it
+
+  std::printf("%zu elements\n", count);
+  std::printf("%8s %12s %12s %12s %12s %12s\n", "threads", "for_each", "transform", "reduce",
+              "scan", "sort");
+
+  double base[5] = {};
+  for (std::size_t threads = 1; threads <= maxThreads;
+       threads = nextThreadCount(threads, maxThreads)) {
+    // The waiting thread runs tasks too, so threads - 1 workers give `threads` cores
+    ThreadPool pool(threads - 1);
+    double ms[5];
+
+    ms[0] = timeMs([&] {
+      parallelForEach(pool, output, [](float& x) { x = std::sqrt(x + 1.0f); });
+    });
+    ms[1] = timeMs([&] {
+      parallelTransform(pool, input.begin(), input.end(), output.begin(),
+                        [](float x) { return std::sin(x) * std::cos(x); });
+    });
+    volatile double sum = 0;
+    ms[2] = timeMs([&] {
+      sum = parallelReduce(pool, input.begin(), input.end(), 0.0, std::plus<>{});
+    });
+    ms[3] = timeMs([&] {
+      parallelInclusiveScan(pool, input.begin(), input.end(), output.begin());
+    });
+    std::copy(input.begin(), input.end(), output.begin());
+    ms[4] = timeMs([&] { parallelSort(pool, output.begin(), output.end()); });
+
+    if (threads == 1) {
+      std::copy(ms, ms + 5, base);
+    }
+
+    std::printf("%8zu", threads);
+    for (int i = 0; i < 5; ++i) {
+      std::printf(" %7.1fms x%-3.1f", ms[i], base[i] / ms[i]);
+    }
+    std::printf("\n");
+  }
+
+  return 0;
+}
@@ -1,88 +1,188 @@
 #ifndef ALIST_H
 #define ALIST_H
 
+#include "ContainerStats.h"
+#include "GrowthPolicy.h"
 #include "List.h"
+#include "Relocate.h"
+#include "Uninitialized.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 
 // @brief Array-based list implementation.
 // @tparam E The type of elements stored in the list.
+// @tparam Allocator Allocator used for storage and element construction.
+// @tparam Growth Growth policy deciding the new capacity when the list is full
+//         (see GrowthPolicy.h).
 //
 // Implements the List interface using a dynamically-resizable array.
 // Provides O(1) access and O(n) insertion/deletion at arbitrary positions.
-template <typename E>
-class AList : public List<E> {
+// Storage is allocated uninitialized; only elements in [0, size) are constructed.
+// With DS_CONTAINER_STATS defined, stats() reports allocations and element transfers.
+template <typename E, typename Allocator = std::allocator<E>, typename Growth = DoublingGrowth>
+class AList : public List<E>, private ContainerStatsRecorder {
 private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  static_assert(std::is_same_v<typename AllocTraits::value_type, E>,
+                "AList: Allocator::value_type must be E");
+  static_assert(std::is_same_v<typename AllocTraits::pointer, E*>,
+                "AList: Allocator must use raw pointers");
+
   static constexpr std::size_t DEFAULT_CAPACITY = 10; // Default initial capacity
-  static constexpr std::size_t GROWTH_FACTOR = 2;     // Capacity growth multiplier
 
-  std::unique_ptr<E[]> listArray_; // Array holding list elements
-  std::size_t capacity_;           // Maximum capacity before reallocation
-  std::size_t size_;               // Number of elements in the list
-  std::size_t curr_;               // Position of current element
+  Allocator alloc_;       // Allocator for storage and element lifetimes
+  E* listArray_;         // Uninitialized storage; [0, size_) holds list elements
+  std::size_t capacity_; // Maximum capacity before reallocation
+  std::size_t size_;     // Number of elements in the list
+  std::size_t curr_;     // Position of current element
+
+  // @brief Allocate uninitialized storage for n elements.
+  E* allocate(std::size_t n) {
+    if (n == 0) {
+      return nullptr;
+    }
+
+    E* p = AllocTraits::allocate(alloc_, n);
+    recordAllocation(n * sizeof(E));
+    recordCapacity(n);
+    return p;
+  }
+
+  // @brief Free storage obtained from allocate(). Elements must already be destroyed.
+  void deallocate(E* p, std::size_t n) noexcept {
+    if (p != nullptr) {
+      AllocTraits::deallocate(alloc_, p, n);
+    }
+  }
+
+  // @brief Exchange storage and cursor (but not allocators) with another list.
+  void swapStorage(AList& other) noexcept {
+    std::swap(listArray_, other.listArray_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(curr_, other.curr_);
+  }
+
+  // @brief Destroy all elements and free the storage.
+  void release() noexcept {
+    destroyN(alloc_, listArray_, size_);
+    deallocate(listArray_, capacity_);
+    listArray_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+    curr_ = 0;
+  }
 
   // @brief Resize the internal array to accommodate more elements.
   // @param newCapacity The new capacity (must be >= size_).
+  //
+  // Trivially relocatable elements move with a single memcpy.
   void resize(std::size_t newCapacity) {
     if (newCapacity < size_) {
       newCapacity = size_;
     }
 
-    auto newArray = std::make_unique<E[]>(newCapacity);
+    E* newArray = allocate(newCapacity);
 
-    // Move elements to new array
-    for (std::size_t i = 0; i < size_; ++i) {
-      newArray[i] = std::move(listArray_[i]);
+    try {
+      uninitializedRelocate(alloc_, listArray_, size_, newArray);
+    } catch (...) {
+      deallocate(newArray, newCapacity);
+      throw;
     }
 
-    listArray_ = std::move(newArray);
+    if (capacity_ > 0) {
+      recordReallocation();
+    }
+    recordRelocation<E>(size_);
+    deallocate(listArray_, capacity_);
+    listArray_ = newArray;
     capacity_ = newCapacity;
   }
 
 
-  // @brief Ensure there is capacity for at least one more element.
-  void ensureCapacity() {
-    if (size_ >= capacity_) {
-      std::size_t newCapacity = capacity_ * GROWTH_FACTOR;
-      if (newCapacity <= capacity_) { // Overflow check
-        newCapacity = capacity_ + 1;
-      }
-      resize(newCapacity);
+  // @brief Ensure there is capacity for at least count more elements.
+  void ensureCapacity(std::size_t count = 1) {
+    if (size_ + count > capacity_) {
+      resize(Growth::next(capacity_, size_ + count, sizeof(E)));
     }
   }
 
+  // @brief True if p points into this list's storage.
+  bool pointsInto(const E* p) const noexcept {
+    return !std::less<const E*>()(p, listArray_) &&
+           std::less<const E*>()(p, listArray_ + capacity_);
+  }
+
 public:
+  using allocator_type = Allocator;
+  using growth_policy = Growth;
+
+  // @brief Allocation statistics of this list (all zero unless DS_CONTAINER_STATS).
+  using ContainerStatsRecorder::stats;
+
   // @brief Construct an empty list with given initial capacity.
   // @param initialCapacity Initial capacity (default: DEFAULT_CAPACITY).
-  explicit AList(std::size_t initialCapacity = DEFAULT_CAPACITY)
-      : listArray_{std::make_unique<E[]>(initialCapacity)}, capacity_{initialCapacity}, size_{0},
-        curr_{0} {
+  // @param alloc Allocator instance to use.
+  explicit AList(std::size_t initialCapacity = DEFAULT_CAPACITY,
+                 const Allocator& alloc = Allocator())
+      : alloc_{alloc}, listArray_{allocate(initialCapacity)}, capacity_{initialCapacity},
+        size_{0}, curr_{0} {
+  }
+
+  // @brief Construct an empty list with default capacity using the given allocator.
+  // @param alloc Allocator instance to use.
+  explicit AList(const Allocator& alloc) : AList(DEFAULT_CAPACITY, alloc) {
   }
 
   // @brief Copy constructor - performs deep copy.
   // @param other The list to copy from.
+  //
+  // The allocator is obtained through select_on_container_copy_construction.
   AList(const AList& other)
-      : listArray_{std::make_unique<E[]>(other.capacity_)}, capacity_{other.capacity_},
-        size_{other.size_}, curr_{other.curr_} {
-    std::copy_n(other.listArray_.get(), size_, listArray_.get());
+      : AList(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+  }
+
+  // @brief Copy constructor with an explicit allocator - performs deep copy.
+  // @param other The list to copy from.
+  // @param alloc Allocator instance to use.
+  AList(const AList& other, const Allocator& alloc)
+      : alloc_{alloc}, listArray_{allocate(other.capacity_)}, capacity_{other.capacity_},
+        size_{0}, curr_{other.curr_} {
+    try {
+      uninitializedCopyN(alloc_, other.listArray_, other.size_, listArray_);
+    } catch (...) {
+      deallocate(listArray_, capacity_);
+      throw;
+    }
+    size_ = other.size_;
+    recordCopies(size_);
   }
 
   // @brief Copy assignment operator - performs deep copy.
   // @param other The list to copy from.
   // @return Reference to this list.
+  //
+  // Adopts other's allocator if propagate_on_container_copy_assignment is true.
   AList& operator=(const AList& other) {
     if (this != &other) {
-      auto newArray = std::make_unique<E[]>(other.capacity_);
-      std::copy_n(other.listArray_.get(), other.size_, newArray.get());
+      if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_) {
+          release(); // Storage must be returned to the allocator that provided it
+        }
+        alloc_ = other.alloc_;
+      }
 
-      listArray_ = std::move(newArray);
-      capacity_ = other.capacity_;
-      size_ = other.size_;
-      curr_ = other.curr_;
+      AList temp(other, alloc_);
+      swapStorage(temp);
+      absorbStats(temp);
     }
     return *this;
   }
@@ -90,8 +190,9 @@ public:
   // @brief Move constructor.
   // @param other The list to move from.
   AList(AList&& other) noexcept
-      : listArray_{std::move(other.listArray_)}, capacity_{other.capacity_}, size_{other.size_},
-        curr_{other.curr_} {
+      : alloc_{std::move(other.alloc_)}, listArray_{other.listArray_}, capacity_{other.capacity_},
+        size_{other.size_}, curr_{other.curr_} {
+    other.listArray_ = nullptr;
     other.capacity_ = 0;
     other.size_ = 0;
     other.curr_ = 0;
@@ -100,26 +201,44 @@ public:
   // @brief Move assignment operator.
   // @param other The list to move from.
   // @return Reference to this list.
-  AList& operator=(AList&& other) noexcept {
+  //
+  // Steals other's storage when the allocator propagates or compares equal. Otherwise
+  // the elements are moved one by one into storage from this list's allocator.
+  AList& operator=(AList&& other) noexcept(
+      AllocTraits::propagate_on_container_move_assignment::value ||
+      AllocTraits::is_always_equal::value) {
     if (this != &other) {
-      listArray_ = std::move(other.listArray_);
-      capacity_ = other.capacity_;
-      size_ = other.size_;
-      curr_ = other.curr_;
-
-      other.capacity_ = 0;
-      other.size_ = 0;
-      other.curr_ = 0;
+      if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+        release();
+        alloc_ = std::move(other.alloc_);
+        swapStorage(other);
+      } else if (alloc_ == other.alloc_) {
+        release();
+        swapStorage(other);
+      } else {
+        AList temp(other.capacity_, alloc_);
+        uninitializedMoveN(alloc_, other.listArray_, other.size_, temp.listArray_);
+        temp.size_ = other.size_;
+        temp.curr_ = other.curr_;
+        temp.recordMoves(temp.size_);
+        swapStorage(temp);
+        absorbStats(temp);
+        other.clear();
+      }
     }
     return *this;
   }
 
-  // Destructor - unique_ptr handles cleanup automatically
-  ~AList() override = default;
+  // @brief Destructor - destroys live elements and frees the storage.
+  ~AList() override {
+    release();
+  }
 
   // @brief Clear the list, removing all elements.
+  //
+  // Capacity remains unchanged.
   void clear() override {
-    listArray_ = std::make_unique<E[]>(capacity_);
+    destroyN(alloc_, listArray_, size_);
     size_ = 0;
     curr_ = 0;
   }
@@ -132,12 +251,22 @@ public:
   void insert(const E& item) override {
     ensureCapacity();
 
-    // Shift elements to the right
-    for (std::size_t i = size_; i > curr_; --i) {
-      listArray_[i] = std::move(listArray_[i - 1]);
+    if (curr_ == size_) {
+      AllocTraits::construct(alloc_, listArray_ + size_, item);
+    } else if constexpr (is_trivially_relocatable_v<E>) {
+      // Build the value aside, then open the gap with a single memmove
+      alignas(E) unsigned char raw[sizeof(E)];
+      E* value = reinterpret_cast<E*>(raw);
+      AllocTraits::construct(alloc_, value, item);
+      relocateWithin(alloc_, listArray_ + curr_, size_ - curr_, listArray_ + curr_ + 1);
+      uninitializedRelocate(alloc_, value, 1, listArray_ + curr_);
+    } else {
+      // Shift elements to the right
+      AllocTraits::construct(alloc_, listArray_ + size_, std::move(listArray_[size_ - 1]));
+      std::move_backward(listArray_ + curr_, listArray_ + size_ - 1, listArray_ + size_);
+      listArray_[curr_] = item;
     }
 
-    listArray_[curr_] = item;
     ++size_;
   }
 
@@ -147,7 +276,8 @@ public:
   // Time complexity: O(1) amortized.
   void append(const E& item) override {
     ensureCapacity();
-    listArray_[size_++] = item;
+    AllocTraits::construct(alloc_, listArray_ + size_, item);
+    ++size_;
   }
 
   // @brief Remove and return the current element.
@@ -162,15 +292,100 @@ public:
 
     E item = std::move(listArray_[curr_]);
 
-    // Shift elements to the left
-    for (std::size_t i = curr_; i < size_ - 1; ++i) {
-      listArray_[i] = std::move(listArray_[i + 1]);
+    if constexpr (is_trivially_relocatable_v<E>) {
+      // Close the gap with a single memmove
+      AllocTraits::destroy(alloc_, listArray_ + curr_);
+      relocateWithin(alloc_, listArray_ + curr_ + 1, size_ - curr_ - 1, listArray_ + curr_);
+    } else {
+      // Shift elements to the left
+      std::move(listArray_ + curr_ + 1, listArray_ + size_, listArray_ + curr_);
+      AllocTraits::destroy(alloc_, listArray_ + size_ - 1);
     }
 
     --size_;
     return item;
   }
 
+  // @brief Insert the elements of [first, last) at the current position, in order.
+  // @param first Start of the elements to insert.
+  // @param last One past the last element to insert.
+  //
+  // The first inserted element becomes the current element. Grows at most once and, for
+  // trivially relocatable or nothrow-movable E, shifts the tail once for the whole batch;
+  // other types fall back to one insert() per element.
+  // Time complexity: O(k + n) for k new elements and n elements after current position.
+  void insertRange(const E* first, const E* last) override {
+    if constexpr (is_trivially_relocatable_v<E> || std::is_nothrow_move_constructible_v<E>) {
+      const std::size_t count = static_cast<std::size_t>(last - first);
+      if (count == 0) {
+        return;
+      }
+      if (pointsInto(first)) {
+        // The source would move with the tail: insert from a copy instead
+        AList copy(count, alloc_);
+        copy.appendRange(first, last);
+        insertRange(copy.listArray_, copy.listArray_ + count);
+        return;
+      }
+
+      ensureCapacity(count);
+      E* gap = listArray_ + curr_;
+      const std::size_t tail = size_ - curr_;
+      relocateWithin(alloc_, gap, tail, gap + count);
+      try {
+        uninitializedCopyN(alloc_, first, count, gap);
+      } catch (...) {
+        relocateWithin(alloc_, gap + count, tail, gap);
+        throw;
+      }
+      size_ += count;
+    } else {
+      List<E>::insertRange(first, last);
+    }
+  }
+
+  // @brief Append the elements of [first, last) at the end of the list, in order.
+  // @param first Start of the elements to append.
+  // @param last One past the last element to append.
+  //
+  // Time complexity: O(k) for k new elements, with at most one reallocation.
+  void appendRange(const E* first, const E* last) override {
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if (count > capacity_ - size_ && pointsInto(first)) {
+      // Growing would free the source: append from a copy instead
+      AList copy(count, alloc_);
+      copy.appendRange(first, last);
+      appendRange(copy.listArray_, copy.listArray_ + count);
+      return;
+    }
+
+    ensureCapacity(count);
+    uninitializedCopyN(alloc_, first, count, listArray_ + size_);
+    size_ += count;
+  }
+
+  // @brief Remove count elements starting at the current element.
+  // @param count The number of elements to remove.
+  // @throws std::out_of_range if fewer than count elements are at or after the current
+  //         position; the list is left unchanged.
+  //
+  // Time complexity: O(k + n) for k removed elements and n elements after them.
+  void removeRange(std::size_t count) override {
+    if (count > size_ - curr_) {
+      throw std::out_of_range("Count out of range");
+    }
+
+    E* gap = listArray_ + curr_;
+    if constexpr (is_trivially_relocatable_v<E>) {
+      destroyN(alloc_, gap, count);
+      relocateWithin(alloc_, gap + count, size_ - curr_ - count, gap);
+    } else {
+      std::move(gap + count, listArray_ + size_, gap);
+      destroyN(alloc_, listArray_ + size_ - count, count);
+    }
+    size_ -= count;
+  }
+
   // @brief Move cursor to the start of the list.
   void moveToStart() noexcept override {
     curr_ = 0;
@@ -225,6 +440,17 @@ public:
     return listArray_[curr_];
   }
 
+  // @brief Get a copy of the allocator.
+  [[nodiscard]] allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }
+
+  // @brief Get pointer to the underlying array; elements [0, length()) are live.
+  // @return Const pointer to the first element.
+  [[nodiscard]] const E* data() const noexcept {
+    return listArray_;
+  }
+
   // @brief Get the current capacity of the internal array.
   // @return The capacity.
   [[nodiscard]] std::size_t capacity() const noexcept {
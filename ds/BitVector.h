@@ -0,0 +1,543 @@
+#ifndef BITVECTOR_H
+#define BITVECTOR_H
+
+#include "../al/SimdKernels.h"
+#include "Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+// @brief Growable array of bits packed into 64-bit words.
+// @tparam Allocator Allocator for the words.
+//
+// One bit per flag, where Vector<bool> spends a byte. Bit i lives in word i / 64 at bit
+// position i % 64, and the bits of the last word past size() are always zero, so whole
+// words can be counted and compared. setRange/resetRange/flipRange touch a range a word
+// at a time, and count() runs simdPopcount over the words.
+//
+// buildRankIndex() adds an index for rank1 (ones before a position, O(1)) and select1
+// (position of the k-th one, near O(1)). It follows the layout of Zhou, Andersen and
+// Kaminsky's "poppy": one 64-bit entry per 2048-bit superblock holds the ones before it
+// (32 bits, relative to a 64-bit base every 2^32 bits) and the counts of its first three
+// 512-bit blocks (10 bits each), which is 3.1% of the bit array; rank then popcounts at
+// most seven words. select1 samples the superblock of every 8192nd one (at most 0.8%
+// more), binary searches the superblocks between two samples and scans one block.
+//
+// The index describes the bits at the time it was built: any modifier discards it, and
+// rank1/select1 throw std::logic_error until it is rebuilt.
+template <typename Allocator = std::allocator<std::uint64_t>>
+class BitVector {
+  static_assert(std::is_same_v<typename Allocator::value_type, std::uint64_t>,
+                "BitVector: Allocator::value_type must be std::uint64_t");
+
+  using WordVector = Vector<std::uint64_t, Allocator>;
+
+public:
+  // Type definitions
+  using value_type = bool;
+  using word_type = std::uint64_t;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+  static constexpr size_type WORD_BITS = 64;
+
+  // @brief Proxy for one bit, returned by the non-const operator[].
+  class reference {
+  public:
+    reference(BitVector* owner, size_type index) noexcept : owner_{owner}, index_{index} {
+    }
+
+    reference& operator=(bool value) noexcept {
+      owner_->set(index_, value);
+      return *this;
+    }
+
+    reference& operator=(const reference& other) noexcept {
+      return *this = static_cast<bool>(other);
+    }
+
+    operator bool() const noexcept {
+      return owner_->test(index_);
+    }
+
+    void flip() noexcept {
+      owner_->flip(index_);
+    }
+
+  private:
+    BitVector* owner_;
+    size_type index_;
+  };
+
+  // @brief Construct an empty bit vector; nothing is allocated until the first append.
+  // @param alloc Allocator instance to use.
+  explicit BitVector(const Allocator& alloc = Allocator())
+      : words_(alloc), size_{0}, rankBlocks_(alloc), rankBases_(alloc), selectSamples_(alloc),
+        ones_{0}, indexed_{false} {
+  }
+
+  // @brief Construct a bit vector of count bits, all equal to value.
+  // @param count Number of bits.
+  // @param value Value of every bit.
+  // @param alloc Allocator instance to use.
+  BitVector(size_type count, bool value, const Allocator& alloc = Allocator())
+      : BitVector(alloc) {
+    resize(count, value);
+  }
+
+
+  // @brief Get a copy of the allocator.
+  allocator_type get_allocator() const noexcept {
+    return words_.get_allocator();
+  }
+
+
+  // Element access
+
+  // @brief Read bit at index (no bounds checking).
+  bool operator[](size_type index) const noexcept {
+    return test(index);
+  }
+
+  // @brief Access bit at index (no bounds checking).
+  // @return Proxy that reads and writes the bit.
+  reference operator[](size_type index) noexcept {
+    return reference(this, index);
+  }
+
+  // @brief Read bit at index (no bounds checking).
+  bool test(size_type index) const noexcept {
+    return (words_[index / WORD_BITS] >> (index % WORD_BITS)) & 1u;
+  }
+
+  // @brief Read bit at index with bounds checking.
+  // @throws std::out_of_range if index >= size.
+  bool at(size_type index) const {
+    if (index >= size_) {
+      throw std::out_of_range("BitVector::at: index out of range");
+    }
+
+    return test(index);
+  }
+
+  // @brief Get pointer to the words; bits past size() in the last word are zero.
+  const word_type* data() const noexcept {
+    return words_.data();
+  }
+
+  // @brief Number of words in use, i.e. size() / 64 rounded up.
+  size_type wordCount() const noexcept {
+    return words_.size();
+  }
+
+
+  // Capacity
+
+  // @brief Check if there are no bits.
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // @brief Get the number of bits.
+  [[nodiscard]] size_type size() const noexcept {
+    return size_;
+  }
+
+  // @brief Number of bits the allocated words can hold.
+  [[nodiscard]] size_type capacity() const noexcept {
+    return words_.capacity() * WORD_BITS;
+  }
+
+  // @brief Reserve space for at least newCapacity bits.
+  void reserve(size_type newCapacity) {
+    words_.reserve(wordsFor(newCapacity));
+  }
+
+  // @brief Shrink the capacity to the words in use.
+  void shrink_to_fit() {
+    words_.shrink_to_fit();
+  }
+
+
+  // Modifiers
+
+  // @brief Set bit at index to value (no bounds checking).
+  void set(size_type index, bool value = true) noexcept {
+    indexed_ = false;
+    const word_type mask = word_type{1} << (index % WORD_BITS);
+    word_type& word = words_[index / WORD_BITS];
+    word = value ? (word | mask) : (word & ~mask);
+  }
+
+  // @brief Clear bit at index (no bounds checking).
+  void reset(size_type index) noexcept {
+    set(index, false);
+  }
+
+  // @brief Invert bit at index (no bounds checking).
+  void flip(size_type index) noexcept {
+    indexed_ = false;
+    words_[index / WORD_BITS] ^= word_type{1} << (index % WORD_BITS);
+  }
+
+  // @brief Set the bits in [first, last) to value.
+  // @throws std::out_of_range if first > last or last > size.
+  void setRange(size_type first, size_type last, bool value = true) {
+    checkRange(first, last, "BitVector::setRange: range out of bounds");
+    if (value) {
+      applyRange(first, last, [](word_type& word, word_type mask) { word |= mask; });
+    } else {
+      applyRange(first, last, [](word_type& word, word_type mask) { word &= ~mask; });
+    }
+  }
+
+  // @brief Clear the bits in [first, last).
+  // @throws std::out_of_range if first > last or last > size.
+  void resetRange(size_type first, size_type last) {
+    checkRange(first, last, "BitVector::resetRange: range out of bounds");
+    applyRange(first, last, [](word_type& word, word_type mask) { word &= ~mask; });
+  }
+
+  // @brief Invert the bits in [first, last).
+  // @throws std::out_of_range if first > last or last > size.
+  void flipRange(size_type first, size_type last) {
+    checkRange(first, last, "BitVector::flipRange: range out of bounds");
+    applyRange(first, last, [](word_type& word, word_type mask) { word ^= mask; });
+  }
+
+  // @brief Append a bit.
+  //
+  // Time complexity: O(1) amortized.
+  void push_back(bool value) {
+    if (size_ % WORD_BITS == 0) {
+      words_.push_back(0);
+    }
+    ++size_;
+    set(size_ - 1, value);
+  }
+
+  // @brief Remove the last bit.
+  // @throws std::out_of_range if there are no bits.
+  void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("BitVector::pop_back: vector is empty");
+    }
+
+    reset(size_ - 1);
+    --size_;
+    if (size_ % WORD_BITS == 0) {
+      words_.pop_back();
+    }
+  }
+
+  // @brief Resize to count bits.
+  // @param count New number of bits.
+  // @param value Value of the bits added when growing.
+  void resize(size_type count, bool value = false) {
+    indexed_ = false;
+    const size_type oldSize = size_;
+    words_.resize(wordsFor(count), 0);
+    size_ = count;
+
+    if (count > oldSize) {
+      if (value) {
+        setRange(oldSize, count);
+      }
+    } else if (count % WORD_BITS != 0) {
+      words_[count / WORD_BITS] &= lowMask(count % WORD_BITS);
+    }
+  }
+
+  // @brief Remove all bits; capacity is kept.
+  void clear() noexcept {
+    indexed_ = false;
+    words_.clear();
+    size_ = 0;
+  }
+
+  // @brief Exchange contents (and rank indexes) with another bit vector.
+  void swap(BitVector& other) noexcept {
+    using std::swap;
+    words_.swap(other.words_);
+    swap(size_, other.size_);
+    rankBlocks_.swap(other.rankBlocks_);
+    rankBases_.swap(other.rankBases_);
+    selectSamples_.swap(other.selectSamples_);
+    swap(ones_, other.ones_);
+    swap(indexed_, other.indexed_);
+  }
+
+
+  // Counting
+
+  // @brief Number of set bits (O(1) while the rank index is valid).
+  size_type count() const noexcept {
+    return indexed_ ? ones_ : simdPopcount(words_.data(), words_.size());
+  }
+
+  // @brief Number of set bits in [first, last).
+  // @throws std::out_of_range if first > last or last > size.
+  size_type count(size_type first, size_type last) const {
+    checkRange(first, last, "BitVector::count: range out of bounds");
+    if (first == last) {
+      return 0;
+    }
+
+    const size_type firstWord = first / WORD_BITS;
+    const size_type lastWord = (last - 1) / WORD_BITS;
+    const word_type firstMask = ~lowMask(first % WORD_BITS);
+    const word_type lastMask = last % WORD_BITS == 0 ? ~word_type{0} : lowMask(last % WORD_BITS);
+    if (firstWord == lastWord) {
+      return popcountWord(words_[firstWord] & firstMask & lastMask);
+    }
+
+    return popcountWord(words_[firstWord] & firstMask) +
+           simdPopcount(words_.data() + firstWord + 1, lastWord - firstWord - 1) +
+           popcountWord(words_[lastWord] & lastMask);
+  }
+
+
+  // Rank/select index
+
+  // @brief Build (or rebuild) the rank/select index over the current bits. O(n / 64).
+  void buildRankIndex() {
+    indexed_ = false;
+    rankBlocks_.clear();
+    rankBases_.clear();
+    selectSamples_.clear();
+
+    const size_type words = words_.size();
+    const size_type superblocks = (words + SUPERBLOCK_WORDS - 1) / SUPERBLOCK_WORDS;
+    rankBlocks_.reserve(superblocks);
+    rankBases_.reserve(superblocks / SUPERBLOCKS_PER_BASE + 1);
+
+    size_type total = 0;
+    size_type nextSample = 0;
+    for (size_type sb = 0; sb < superblocks; ++sb) {
+      if (sb % SUPERBLOCKS_PER_BASE == 0) {
+        rankBases_.push_back(total);
+      }
+
+      word_type entry = total - rankBases_.back();
+      for (size_type block = 0; block < BLOCKS_PER_SUPERBLOCK; ++block) {
+        const size_type begin = sb * SUPERBLOCK_WORDS + block * BLOCK_WORDS;
+        const size_type blockOnes =
+            begin < words ? simdPopcount(words_.data() + begin,
+                                         begin + BLOCK_WORDS <= words ? BLOCK_WORDS
+                                                                      : words - begin)
+                          : 0;
+        if (block + 1 < BLOCKS_PER_SUPERBLOCK) {
+          entry |= static_cast<word_type>(blockOnes) << (32 + 10 * block);
+        }
+        total += blockOnes;
+      }
+      rankBlocks_.push_back(entry);
+
+      for (; nextSample < total; nextSample += SELECT_SAMPLE) {
+        selectSamples_.push_back(sb);
+      }
+    }
+
+    ones_ = total;
+    indexed_ = true;
+  }
+
+  // @brief Check whether the rank/select index is built and up to date.
+  bool hasRankIndex() const noexcept {
+    return indexed_;
+  }
+
+  // @brief Memory used by the rank/select index, in bytes.
+  size_type rankIndexBytes() const noexcept {
+    return (rankBlocks_.capacity() + rankBases_.capacity() + selectSamples_.capacity()) *
+           sizeof(word_type);
+  }
+
+  // @brief Number of set bits in [0, pos). O(1).
+  // @throws std::logic_error if the rank index is not built or stale.
+  // @throws std::out_of_range if pos > size.
+  size_type rank1(size_type pos) const {
+    requireIndex("BitVector::rank1: rank index not built");
+    if (pos > size_) {
+      throw std::out_of_range("BitVector::rank1: position out of range");
+    }
+    if (pos == size_) {
+      return ones_;
+    }
+
+    const size_type sb = pos / SUPERBLOCK_BITS;
+    const word_type entry = rankBlocks_[sb];
+    size_type result = superblockRank(sb);
+    const size_type block = pos / BLOCK_BITS % BLOCKS_PER_SUPERBLOCK;
+    for (size_type b = 0; b < block; ++b) {
+      result += blockCount(entry, b);
+    }
+
+    const size_type word = pos / WORD_BITS;
+    for (size_type w = pos / BLOCK_BITS * BLOCK_WORDS; w < word; ++w) {
+      result += popcountWord(words_[w]);
+    }
+    return result + popcountWord(words_[word] & lowMask(pos % WORD_BITS));
+  }
+
+  // @brief Number of clear bits in [0, pos). O(1).
+  // @throws std::logic_error if the rank index is not built or stale.
+  // @throws std::out_of_range if pos > size.
+  size_type rank0(size_type pos) const {
+    return pos - rank1(pos);
+  }
+
+  // @brief Position of the set bit with rank k (k = 0 for the first set bit).
+  // @throws std::logic_error if the rank index is not built or stale.
+  // @throws std::out_of_range if k >= count().
+  size_type select1(size_type k) const {
+    requireIndex("BitVector::select1: rank index not built");
+    if (k >= ones_) {
+      throw std::out_of_range("BitVector::select1: rank out of range");
+    }
+
+    // The superblock holding one k lies between the samples around it: find the last
+    // superblock whose rank is at most k
+    const size_type sample = k / SELECT_SAMPLE;
+    size_type lo = selectSamples_[sample];
+    size_type hi = sample + 1 < selectSamples_.size() ? selectSamples_[sample + 1] + 1
+                                                      : rankBlocks_.size();
+    while (hi - lo > 1) {
+      const size_type mid = lo + (hi - lo) / 2;
+      if (superblockRank(mid) <= k) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+
+    size_type remaining = k - superblockRank(lo);
+    size_type word = lo * SUPERBLOCK_WORDS;
+    for (size_type b = 0; b + 1 < BLOCKS_PER_SUPERBLOCK; ++b) {
+      const size_type ones = blockCount(rankBlocks_[lo], b);
+      if (remaining < ones) {
+        break;
+      }
+      remaining -= ones;
+      word += BLOCK_WORDS;
+    }
+
+    for (;; ++word) {
+      const size_type ones = popcountWord(words_[word]);
+      if (remaining < ones) {
+        return word * WORD_BITS + selectInWord(words_[word], remaining);
+      }
+      remaining -= ones;
+    }
+  }
+
+  friend bool operator==(const BitVector& a, const BitVector& b) noexcept {
+    if (a.size_ != b.size_) {
+      return false;
+    }
+    for (size_type i = 0; i < a.words_.size(); ++i) {
+      if (a.words_[i] != b.words_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  friend bool operator!=(const BitVector& a, const BitVector& b) noexcept {
+    return !(a == b);
+  }
+
+private:
+  // Rank/select index geometry
+  static constexpr size_type BLOCK_WORDS = 8;                 // 512-bit blocks
+  static constexpr size_type BLOCKS_PER_SUPERBLOCK = 4;       // 2048-bit superblocks
+  static constexpr size_type SUPERBLOCK_WORDS = BLOCK_WORDS * BLOCKS_PER_SUPERBLOCK;
+  static constexpr size_type BLOCK_BITS = BLOCK_WORDS * WORD_BITS;
+  static constexpr size_type SUPERBLOCK_BITS = SUPERBLOCK_WORDS * WORD_BITS;
+  static constexpr size_type SUPERBLOCKS_PER_BASE = size_type{1} << 21; // 2^32 bits
+  static constexpr size_type SELECT_SAMPLE = 8192;
+
+  WordVector words_;
+  size_type size_; // Number of bits
+
+  WordVector rankBlocks_;    // Per superblock: rank within its base, three block counts
+  WordVector rankBases_;     // Rank at every 2^32nd bit
+  WordVector selectSamples_; // Superblock holding every SELECT_SAMPLE-th one
+  size_type ones_;           // Set bits when the index was built
+  bool indexed_;             // Index matches the bits
+
+  static size_type wordsFor(size_type bits) noexcept {
+    return (bits + WORD_BITS - 1) / WORD_BITS;
+  }
+
+  // Bits [0, bits) of a word; bits < 64
+  static word_type lowMask(size_type bits) noexcept {
+    return (word_type{1} << bits) - 1;
+  }
+
+  static size_type blockCount(word_type entry, size_type block) noexcept {
+    return static_cast<size_type>((entry >> (32 + 10 * block)) & 0x3ff);
+  }
+
+  // Position of the set bit with rank r within word (r < popcount(word))
+  static size_type selectInWord(word_type word, size_type r) noexcept {
+    for (; r > 0; --r) {
+      word &= word - 1;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_type>(__builtin_ctzll(word));
+#else
+    size_type pos = 0;
+    for (; (word & 1u) == 0; word >>= 1) {
+      ++pos;
+    }
+    return pos;
+#endif
+  }
+
+  size_type superblockRank(size_type sb) const noexcept {
+    return rankBases_[sb / SUPERBLOCKS_PER_BASE] +
+           static_cast<size_type>(rankBlocks_[sb] & 0xffffffffu);
+  }
+
+  void checkRange(size_type first, size_type last, const char* message) const {
+    if (first > last || last > size_) {
+      throw std::out_of_range(message);
+    }
+  }
+
+  void requireIndex(const char* message) const {
+    if (!indexed_) {
+      throw std::logic_error(message);
+    }
+  }
+
+  // Applies op(word, mask) to the words overlapping [first, last), whole words at once
+  template <typename Op>
+  void applyRange(size_type first, size_type last, Op op) noexcept {
+    indexed_ = false;
+    if (first == last) {
+      return;
+    }
+
+    const size_type firstWord = first / WORD_BITS;
+    const size_type lastWord = (last - 1) / WORD_BITS;
+    const word_type firstMask = ~lowMask(first % WORD_BITS);
+    const word_type lastMask = last % WORD_BITS == 0 ? ~word_type{0} : lowMask(last % WORD_BITS);
+    if (firstWord == lastWord) {
+      op(words_[firstWord], firstMask & lastMask);
+      return;
+    }
+
+    op(words_[firstWord], firstMask);
+    for (size_type w = firstWord + 1; w < lastWord; ++w) {
+      op(words_[w], ~word_type{0});
+    }
+    op(words_[lastWord], lastMask);
+  }
+};
+
+#endif // BITVECTOR_H
@@ -0,0 +1,573 @@
+#ifndef CIRCULARALIST_H
+#define CIRCULARALIST_H
+
+#include "ContainerStats.h"
+#include "GrowthPolicy.h"
+#include "List.h"
+#include "Relocate.h"
+#include "Uninitialized.h"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+// @brief Array-based list stored as a ring buffer, with O(1) edits at both ends.
+// @tparam E The type of elements stored in the list.
+// @tparam Allocator Allocator used for storage and element construction.
+// @tparam Growth Growth policy deciding the new capacity when the buffer is full; its
+//         answer is rounded up to a power of two (see GrowthPolicy.h).
+//
+// Implements the List interface like AList, but position i lives in slot
+// (head + i) & (capacity - 1), so the elements may wrap around the end of the array.
+// insert() and remove() shift whichever side of the cursor is shorter: at the start or
+// the end of the list nothing moves, which makes a sliding window (append, then
+// moveToStart and remove) O(1) per step where AList shifts every element.
+//
+// Shifting relocates elements one slot at a time, so E must be trivially relocatable or
+// nothrow move constructible.
+template <typename E, typename Allocator = std::allocator<E>, typename Growth = DoublingGrowth>
+class CircularAList : public List<E>, private ContainerStatsRecorder {
+private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  static_assert(std::is_same_v<typename AllocTraits::value_type, E>,
+                "CircularAList: Allocator::value_type must be E");
+  static_assert(std::is_same_v<typename AllocTraits::pointer, E*>,
+                "CircularAList: Allocator must use raw pointers");
+  static_assert(is_trivially_relocatable_v<E> || std::is_nothrow_move_constructible_v<E>,
+                "CircularAList: E must be trivially relocatable or nothrow move constructible");
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 16; // Default initial capacity
+
+  Allocator alloc_;       // Allocator for storage and element lifetimes
+  E* listArray_;         // Ring buffer of capacity_ slots
+  std::size_t capacity_; // Number of slots (zero or a power of two)
+  std::size_t head_;     // Slot of position 0
+  std::size_t size_;     // Number of elements
+  std::size_t curr_;     // Position of current element
+
+  // @brief Smallest power of two >= n (n > 0).
+  static constexpr std::size_t roundUpPow2(std::size_t n) noexcept {
+    std::size_t p = 1;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  // @brief Slot holding the element at list position pos.
+  E* slot(std::size_t pos) const noexcept {
+    return listArray_ + ((head_ + pos) & (capacity_ - 1));
+  }
+
+  // @brief Allocate uninitialized storage for n elements.
+  E* allocate(std::size_t n) {
+    if (n == 0) {
+      return nullptr;
+    }
+
+    E* p = AllocTraits::allocate(alloc_, n);
+    recordAllocation(n * sizeof(E));
+    recordCapacity(n);
+    return p;
+  }
+
+  // @brief Free storage obtained from allocate(). Elements must already be destroyed.
+  void deallocate(E* p, std::size_t n) noexcept {
+    if (p != nullptr) {
+      AllocTraits::deallocate(alloc_, p, n);
+    }
+  }
+
+  // @brief Exchange storage and cursor (but not allocators) with another list.
+  void swapStorage(CircularAList& other) noexcept {
+    std::swap(listArray_, other.listArray_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    std::swap(curr_, other.curr_);
+  }
+
+  // @brief Length of the run starting at head_ before the buffer wraps.
+  std::size_t firstRun() const noexcept {
+    return size_ < capacity_ - head_ ? size_ : capacity_ - head_;
+  }
+
+  // @brief Destroy all elements, leaving the storage allocated.
+  void destroyAll() noexcept {
+    if (size_ > 0) {
+      const std::size_t first = firstRun();
+      destroyN(alloc_, listArray_ + head_, first);
+      destroyN(alloc_, listArray_, size_ - first);
+    }
+    head_ = 0;
+    size_ = 0;
+    curr_ = 0;
+  }
+
+  // @brief Destroy all elements and free the storage.
+  void release() noexcept {
+    destroyAll();
+    deallocate(listArray_, capacity_);
+    listArray_ = nullptr;
+    capacity_ = 0;
+  }
+
+  // @brief Reallocate to newCapacity slots, unwrapping the elements to start at slot 0.
+  // @param newCapacity The new capacity (a power of two >= size_).
+  void resize(std::size_t newCapacity) {
+    E* newArray = allocate(newCapacity);
+    if (size_ > 0) {
+      const std::size_t first = firstRun();
+      uninitializedRelocate(alloc_, listArray_ + head_, first, newArray);
+      uninitializedRelocate(alloc_, listArray_, size_ - first, newArray + first);
+    }
+
+    if (capacity_ > 0) {
+      recordReallocation();
+    }
+    recordRelocation<E>(size_);
+    deallocate(listArray_, capacity_);
+    listArray_ = newArray;
+    capacity_ = newCapacity;
+    head_ = 0;
+  }
+
+  // @brief Ensure there is room for at least count more elements.
+  void ensureCapacity(std::size_t count = 1) {
+    if (size_ + count > capacity_) {
+      resize(roundUpPow2(Growth::next(capacity_, size_ + count, sizeof(E))));
+    }
+  }
+
+  // @brief True if p points into this list's storage.
+  bool pointsInto(const E* p) const noexcept {
+    return !std::less<const E*>()(p, listArray_) &&
+           std::less<const E*>()(p, listArray_ + capacity_);
+  }
+
+  // @brief Move the elements at positions [first, last) down (to the left) by `by`.
+  void shiftDown(std::size_t first, std::size_t last, std::size_t by) noexcept {
+    for (std::size_t pos = first; pos < last; ++pos) {
+      uninitializedRelocate(alloc_, slot(pos), 1, slot(pos - by));
+    }
+  }
+
+  // @brief Move the elements at positions [first, last) up (to the right) by `by`.
+  void shiftUp(std::size_t first, std::size_t last, std::size_t by) noexcept {
+    for (std::size_t pos = last; pos > first; --pos) {
+      uninitializedRelocate(alloc_, slot(pos - 1), 1, slot(pos - 1 + by));
+    }
+  }
+
+  // @brief Open count empty slots at position curr_, moving the shorter side out of the way.
+  // @return True if the prefix moved (and the head stepped back).
+  bool openSlots(std::size_t count) noexcept {
+    const bool front = curr_ < size_ - curr_;
+    if (front) {
+      // Shorter prefix: step the head back and slide [0, curr_) down into the new slots
+      head_ = (head_ - count) & (capacity_ - 1);
+      shiftDown(count, curr_ + count, count);
+    } else {
+      shiftUp(curr_, size_, count);
+    }
+    size_ += count;
+    return front;
+  }
+
+  // @brief Close count empty slots at position curr_ from the shorter side.
+  void closeSlots(std::size_t count) noexcept {
+    if (curr_ < size_ - count - curr_) {
+      shiftUp(0, curr_, count);
+      head_ = (head_ + count) & (capacity_ - 1);
+    } else {
+      shiftDown(curr_ + count, size_, count);
+    }
+    size_ -= count;
+  }
+
+public:
+  using allocator_type = Allocator;
+  using growth_policy = Growth;
+
+  // @brief Allocation statistics of this list (all zero unless DS_CONTAINER_STATS).
+  using ContainerStatsRecorder::stats;
+
+  // @brief Construct an empty list with given initial capacity.
+  // @param initialCapacity Initial capacity, rounded up to a power of two
+  //        (default: DEFAULT_CAPACITY).
+  // @param alloc Allocator instance to use.
+  explicit CircularAList(std::size_t initialCapacity = DEFAULT_CAPACITY,
+                         const Allocator& alloc = Allocator())
+      : alloc_{alloc}, listArray_{nullptr},
+        capacity_{initialCapacity > 0 ? roundUpPow2(initialCapacity) : 0}, head_{0}, size_{0},
+        curr_{0} {
+    listArray_ = allocate(capacity_);
+  }
+
+  // @brief Construct an empty list with default capacity using the given allocator.
+  // @param alloc Allocator instance to use.
+  explicit CircularAList(const Allocator& alloc) : CircularAList(DEFAULT_CAPACITY, alloc) {
+  }
+
+  // @brief Copy constructor - performs deep copy; the copy starts at slot 0.
+  // @param other The list to copy from.
+  //
+  // The allocator is obtained through select_on_container_copy_construction.
+  CircularAList(const CircularAList& other)
+      : CircularAList(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+  }
+
+  // @brief Copy constructor with an explicit allocator - performs deep copy.
+  // @param other The list to copy from.
+  // @param alloc Allocator instance to use.
+  CircularAList(const CircularAList& other, const Allocator& alloc)
+      : alloc_{alloc}, listArray_{allocate(other.capacity_)}, capacity_{other.capacity_},
+        head_{0}, size_{0}, curr_{other.curr_} {
+    try {
+      if (other.size_ > 0) {
+        const std::size_t first = other.firstRun();
+        uninitializedCopyN(alloc_, other.listArray_ + other.head_, first, listArray_);
+        try {
+          uninitializedCopyN(alloc_, other.listArray_, other.size_ - first, listArray_ + first);
+        } catch (...) {
+          destroyN(alloc_, listArray_, first);
+          throw;
+        }
+      }
+    } catch (...) {
+      deallocate(listArray_, capacity_);
+      throw;
+    }
+    size_ = other.size_;
+    recordCopies(size_);
+  }
+
+  // @brief Copy assignment operator - performs deep copy.
+  // @param other The list to copy from.
+  // @return Reference to this list.
+  //
+  // Adopts other's allocator if propagate_on_container_copy_assignment is true.
+  CircularAList& operator=(const CircularAList& other) {
+    if (this != &other) {
+      if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_) {
+          release(); // Storage must be returned to the allocator that provided it
+        }
+        alloc_ = other.alloc_;
+      }
+
+      CircularAList temp(other, alloc_);
+      swapStorage(temp);
+      absorbStats(temp);
+    }
+    return *this;
+  }
+
+  // @brief Move constructor.
+  // @param other The list to move from.
+  CircularAList(CircularAList&& other) noexcept
+      : alloc_{std::move(other.alloc_)}, listArray_{other.listArray_},
+        capacity_{other.capacity_}, head_{other.head_}, size_{other.size_},
+        curr_{other.curr_} {
+    other.listArray_ = nullptr;
+    other.capacity_ = 0;
+    other.head_ = 0;
+    other.size_ = 0;
+    other.curr_ = 0;
+  }
+
+  // @brief Move assignment operator.
+  // @param other The list to move from.
+  // @return Reference to this list.
+  //
+  // Steals other's storage when the allocator propagates or compares equal. Otherwise
+  // the elements are moved one by one into storage from this list's allocator.
+  CircularAList& operator=(CircularAList&& other) noexcept(
+      AllocTraits::propagate_on_container_move_assignment::value ||
+      AllocTraits::is_always_equal::value) {
+    if (this != &other) {
+      if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+        release();
+        alloc_ = std::move(other.alloc_);
+        swapStorage(other);
+      } else if (alloc_ == other.alloc_) {
+        release();
+        swapStorage(other);
+      } else {
+        CircularAList temp(other.capacity_, alloc_);
+        for (std::size_t pos = 0; pos < other.size_; ++pos) {
+          AllocTraits::construct(alloc_, temp.listArray_ + pos, std::move(*other.slot(pos)));
+        }
+        temp.size_ = other.size_;
+        temp.curr_ = other.curr_;
+        temp.recordMoves(temp.size_);
+        swapStorage(temp);
+        absorbStats(temp);
+        other.clear();
+      }
+    }
+    return *this;
+  }
+
+  // @brief Destructor - destroys live elements and frees the storage.
+  ~CircularAList() override {
+    release();
+  }
+
+  // @brief Clear the list, removing all elements.
+  //
+  // Capacity remains unchanged.
+  void clear() override {
+    destroyAll();
+  }
+
+  // @brief Insert an element at the current position.
+  // @param item The element to insert.
+  //
+  // Time complexity: O(min(k, n - k)) for cursor position k; O(1) amortized at either end.
+  void insert(const E& item) override {
+    if (curr_ == size_) {
+      append(item);
+    } else {
+      // Build the value first: a throwing copy leaves the list untouched, and item may
+      // be one of the elements about to be shifted
+      E value(item);
+      ensureCapacity();
+      openSlots(1);
+      AllocTraits::construct(alloc_, slot(curr_), std::move(value));
+    }
+  }
+
+  // @brief Append an element at the end of the list.
+  // @param item The element to append.
+  //
+  // Time complexity: O(1) amortized.
+  void append(const E& item) override {
+    if (size_ == capacity_ && pointsInto(&item)) {
+      // Growing would free item: copy it out first
+      E value(item);
+      ensureCapacity();
+      AllocTraits::construct(alloc_, slot(size_), std::move(value));
+    } else {
+      ensureCapacity();
+      AllocTraits::construct(alloc_, slot(size_), item);
+    }
+    ++size_;
+  }
+
+  // @brief Remove and return the current element.
+  // @return The removed element.
+  // @throws std::out_of_range if no element is at current position.
+  //
+  // Closes the hole from whichever side of the cursor is shorter.
+  // Time complexity: O(min(k, n - k)) for cursor position k; O(1) at either end.
+  E remove() override {
+    if (curr_ >= size_) {
+      throw std::out_of_range("No element at current position");
+    }
+
+    E* target = slot(curr_);
+    E item = std::move(*target);
+    AllocTraits::destroy(alloc_, target);
+    closeSlots(1);
+    return item;
+  }
+
+  // @brief Insert the elements of [first, last) at the current position, in order.
+  // @param first Start of the elements to insert.
+  // @param last One past the last element to insert.
+  //
+  // Shifts the shorter side once for the whole batch; the first inserted element becomes
+  // the current element.
+  // Time complexity: O(k + min(j, n - j)) for k new elements at cursor position j.
+  void insertRange(const E* first, const E* last) override {
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if (count == 0) {
+      return;
+    }
+    if (pointsInto(first)) {
+      // The source would move with the shift: insert from a copy instead
+      CircularAList copy(count, alloc_);
+      copy.appendRange(first, last);
+      E* run = copy.listArray_; // A fresh list holds its elements from slot 0
+      insertRange(run, run + count);
+      return;
+    }
+
+    ensureCapacity(count);
+    const bool front = openSlots(count);
+    std::size_t constructed = 0;
+    try {
+      for (; constructed < count; ++constructed) {
+        AllocTraits::construct(alloc_, slot(curr_ + constructed), first[constructed]);
+      }
+    } catch (...) {
+      for (std::size_t i = 0; i < constructed; ++i) {
+        AllocTraits::destroy(alloc_, slot(curr_ + i));
+      }
+      // Undo the shift exactly, even if the other side is now shorter
+      if (front) {
+        shiftUp(0, curr_, count);
+        head_ = (head_ + count) & (capacity_ - 1);
+      } else {
+        shiftDown(curr_ + count, size_, count);
+      }
+      size_ -= count;
+      throw;
+    }
+  }
+
+  // @brief Append the elements of [first, last) at the end of the list, in order.
+  // @param first Start of the elements to append.
+  // @param last One past the last element to append.
+  //
+  // Time complexity: O(k) for k new elements, with at most one reallocation.
+  void appendRange(const E* first, const E* last) override {
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if (count > capacity_ - size_ && pointsInto(first)) {
+      // Growing would free the source: append from a copy instead
+      CircularAList copy(count, alloc_);
+      copy.appendRange(first, last);
+      appendRange(copy.listArray_, copy.listArray_ + count);
+      return;
+    }
+
+    ensureCapacity(count);
+    std::size_t constructed = 0;
+    try {
+      for (; constructed < count; ++constructed) {
+        AllocTraits::construct(alloc_, slot(size_ + constructed), first[constructed]);
+      }
+    } catch (...) {
+      for (std::size_t i = 0; i < constructed; ++i) {
+        AllocTraits::destroy(alloc_, slot(size_ + i));
+      }
+      throw;
+    }
+    size_ += count;
+  }
+
+  // @brief Remove count elements starting at the current element.
+  // @param count The number of elements to remove.
+  // @throws std::out_of_range if fewer than count elements are at or after the current
+  //         position; the list is left unchanged.
+  //
+  // Time complexity: O(k + min(j, n - j - k)) for k elements removed at cursor position j.
+  void removeRange(std::size_t count) override {
+    if (count > size_ - curr_) {
+      throw std::out_of_range("Count out of range");
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+      AllocTraits::destroy(alloc_, slot(curr_ + i));
+    }
+    closeSlots(count);
+  }
+
+  // @brief Move cursor to the start of the list.
+  void moveToStart() noexcept override {
+    curr_ = 0;
+  }
+
+  // @brief Move cursor to the end of the list (one past the last element).
+  void moveToEnd() noexcept override {
+    curr_ = size_;
+  }
+
+  // @brief Move cursor one position to the left (no change if already at start).
+  void prev() noexcept override {
+    if (curr_ > 0) {
+      --curr_;
+    }
+  }
+
+  // @brief Move cursor one position to the right (no change if already at end).
+  void next() noexcept override {
+    if (curr_ < size_) {
+      ++curr_;
+    }
+  }
+
+  // @brief Get the number of elements in the list.
+  [[nodiscard]] std::size_t length() const noexcept override {
+    return size_;
+  }
+
+  // @brief Get the current cursor position.
+  [[nodiscard]] std::size_t currPos() const noexcept override {
+    return curr_;
+  }
+
+  // @brief Set the cursor position.
+  // @param pos The position to set (0 <= pos <= size).
+  // @throws std::out_of_range if pos is out of valid range.
+  void moveToPos(std::size_t pos) override {
+    if (pos > size_) {
+      throw std::out_of_range("Position out of range");
+    }
+    curr_ = pos;
+  }
+
+  // @brief Get the element at the current position.
+  // @return Const reference to the current element.
+  // @throws std::out_of_range if no element is at current position.
+  [[nodiscard]] const E& getValue() const override {
+    if (curr_ >= size_) {
+      throw std::out_of_range("No element at current position");
+    }
+    return *slot(curr_);
+  }
+
+  // @brief Visit every element in order without moving the cursor.
+  // @param fn Callable invoked with a const reference to each element.
+  //
+  // Time complexity: O(n), as at most two sequential scans.
+  template <typename Fn>
+  void forEach(Fn&& fn) const {
+    if (size_ == 0) {
+      return;
+    }
+    const std::size_t first = firstRun();
+    for (std::size_t i = 0; i < first; ++i) {
+      fn(listArray_[head_ + i]);
+    }
+    for (std::size_t i = 0; i < size_ - first; ++i) {
+      fn(listArray_[i]);
+    }
+  }
+
+  // @brief Get a copy of the allocator.
+  [[nodiscard]] allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }
+
+  // @brief Get the current capacity of the internal array.
+  // @return The capacity (zero or a power of two).
+  [[nodiscard]] std::size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  // @brief Reserve space for at least n elements.
+  // @param n The desired capacity, rounded up to a power of two.
+  //
+  // Does not change the size or contents of the list.
+  void reserve(std::size_t n) {
+    if (n > capacity_) {
+      resize(roundUpPow2(n));
+    }
+  }
+
+  // @brief Shrink the capacity to the smallest power of two that fits the current size.
+  void shrink_to_fit() {
+    const std::size_t fit = roundUpPow2(size_ > 0 ? size_ : 1);
+    if (fit < capacity_) {
+      resize(fit);
+    }
+  }
+};
+
+#endif // CIRCULARALIST_H
@@ -0,0 +1,286 @@
+#ifndef CONCURRENTVECTOR_H
+#define CONCURRENTVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// @brief Append-only vector that many threads can grow and read at the same time.
+// @tparam T The type of elements stored.
+// @tparam Allocator Allocator used for storage and element construction; must be safe
+//         to call from several threads at once (std::allocator is).
+//
+// Elements live in buckets of doubling size (8, 16, 32, ...). A bucket is allocated once
+// and never moved, so an element's address is fixed for the container's lifetime and
+// growth never copies anything. Index i lives in bucket log2(i + 8) - 3, which is found
+// with one bit scan: indexing is wait-free.
+//
+// push_back claims an index with a single fetch_add, installs the bucket with a CAS if it
+// is missing (the loser of a race frees its allocation), constructs the element, then
+// publishes it by setting the slot's ready flag with release semantics. The index it
+// returns can be handed to other threads; they see the fully constructed element.
+//
+// size() counts claimed slots, which may include elements still being constructed by
+// another thread. Use published() or at() to read an index of unknown provenance.
+// If an element constructor throws, its slot stays unpublished for good.
+//
+// Copying, moving, clearing and destruction are not thread-safe.
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentVector {
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+                "ConcurrentVector: Allocator::value_type must be T");
+
+  struct Slot {
+    std::atomic<bool> ready{false};
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* element() noexcept {
+      return std::launder(reinterpret_cast<T*>(storage));
+    }
+  };
+
+  using SlotAllocator = typename AllocTraits::template rebind_alloc<Slot>;
+  using SlotTraits = std::allocator_traits<SlotAllocator>;
+
+  static constexpr std::size_t FIRST_BUCKET_BITS = 3;
+  static constexpr std::size_t FIRST_BUCKET_SIZE = std::size_t{1} << FIRST_BUCKET_BITS;
+  static constexpr std::size_t BUCKET_COUNT = sizeof(std::size_t) * 8 - FIRST_BUCKET_BITS;
+
+public:
+  // Type definitions
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+
+  // @brief Construct an empty vector; no memory is allocated until the first append.
+  // @param alloc Allocator instance to use.
+  explicit ConcurrentVector(const Allocator& alloc = Allocator())
+      : alloc_{alloc}, slotAlloc_{alloc} {
+    for (std::atomic<Slot*>& bucket : buckets_) {
+      bucket.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  ConcurrentVector(const ConcurrentVector&) = delete;
+  ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+  // @brief Destructor - destroys published elements and frees every bucket.
+  ~ConcurrentVector() {
+    clear();
+  }
+
+
+  // @brief Get a copy of the allocator.
+  allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }
+
+
+  // Element access
+
+  // @brief Access a published element (no checking). Wait-free.
+  // @param index An index returned by push_back, or one known to be published.
+  // @return Reference to the element.
+  reference operator[](size_type index) noexcept {
+    return *slotAt(index).element();
+  }
+
+  // @brief Access a published element (no checking). Wait-free.
+  // @param index An index returned by push_back, or one known to be published.
+  // @return Const reference to the element.
+  const_reference operator[](size_type index) const noexcept {
+    return *slotAt(index).element();
+  }
+
+  // @brief Access element at index, checking that it has been published.
+  // @param index The index of the element.
+  // @return Reference to the element.
+  // @throws std::out_of_range if the element at index is not published (yet).
+  reference at(size_type index) {
+    if (!published(index)) {
+      throw std::out_of_range("ConcurrentVector::at: element not published");
+    }
+    return (*this)[index];
+  }
+
+  // @brief Access element at index, checking that it has been published.
+  // @param index The index of the element.
+  // @return Const reference to the element.
+  // @throws std::out_of_range if the element at index is not published (yet).
+  const_reference at(size_type index) const {
+    if (!published(index)) {
+      throw std::out_of_range("ConcurrentVector::at: element not published");
+    }
+    return (*this)[index];
+  }
+
+  // @brief Check whether the element at index is fully constructed and visible.
+  // @param index The index to check (any value).
+  bool published(size_type index) const noexcept {
+    if (index >= size()) {
+      return false;
+    }
+
+    const Slot* bucket = buckets_[bucketOf(index)].load(std::memory_order_acquire);
+    return bucket != nullptr &&
+           bucket[offsetOf(index)].ready.load(std::memory_order_acquire);
+  }
+
+
+  // Capacity
+
+  // @brief Number of claimed slots (published or still being constructed).
+  size_type size() const noexcept {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  // @brief Check if no slot has been claimed.
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  // @brief Allocate the buckets needed to hold count elements, so appends below count
+  //        never allocate. Thread-safe.
+  // @param count Number of elements to make room for.
+  void reserve(size_type count) {
+    if (count == 0) {
+      return;
+    }
+
+    const size_type last = bucketOf(count - 1);
+    for (size_type b = 0; b <= last; ++b) {
+      ensureBucket(b);
+    }
+  }
+
+
+  // Modifiers
+
+  // @brief Append a copy of value. Lock-free.
+  // @param value The value to append.
+  // @return The index of the new element; it never changes.
+  size_type push_back(const T& value) {
+    return emplace_back(value);
+  }
+
+  // @brief Append value by moving it. Lock-free.
+  // @param value The value to append.
+  // @return The index of the new element; it never changes.
+  size_type push_back(T&& value) {
+    return emplace_back(std::move(value));
+  }
+
+  // @brief Construct an element in place at the end. Lock-free.
+  // @param args Arguments forwarded to T's constructor.
+  // @return The index of the new element; it never changes.
+  template <typename... Args>
+  size_type emplace_back(Args&&... args) {
+    const size_type index = size_.fetch_add(1, std::memory_order_acq_rel);
+
+    Slot& slot = ensureBucket(bucketOf(index))[offsetOf(index)];
+    AllocTraits::construct(alloc_, slot.element(), std::forward<Args>(args)...);
+    slot.ready.store(true, std::memory_order_release);
+
+    return index;
+  }
+
+  // @brief Destroy all elements and free all buckets. Not thread-safe.
+  void clear() noexcept {
+    for (size_type b = 0; b < BUCKET_COUNT; ++b) {
+      Slot* bucket = buckets_[b].load(std::memory_order_relaxed);
+      if (bucket == nullptr) {
+        continue;
+      }
+
+      const size_type slots = bucketSize(b);
+      for (size_type i = 0; i < slots; ++i) {
+        if (bucket[i].ready.load(std::memory_order_relaxed)) {
+          AllocTraits::destroy(alloc_, bucket[i].element());
+        }
+      }
+      freeBucket(bucket, slots);
+      buckets_[b].store(nullptr, std::memory_order_relaxed);
+    }
+
+    size_.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  Allocator alloc_;
+  SlotAllocator slotAlloc_;
+  std::atomic<size_type> size_{0};
+  std::atomic<Slot*> buckets_[BUCKET_COUNT];
+
+  // Position of the highest set bit; value must be non-zero
+  static size_type highestBit(size_type value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return sizeof(unsigned long long) * 8 - 1 -
+           static_cast<size_type>(__builtin_clzll(static_cast<unsigned long long>(value)));
+#else
+    size_type bit = 0;
+    while (value >>= 1) {
+      ++bit;
+    }
+    return bit;
+#endif
+  }
+
+  static size_type bucketOf(size_type index) noexcept {
+    return highestBit(index + FIRST_BUCKET_SIZE) - FIRST_BUCKET_BITS;
+  }
+
+  static size_type offsetOf(size_type index) noexcept {
+    const size_type position = index + FIRST_BUCKET_SIZE;
+    return position - (size_type{1} << highestBit(position));
+  }
+
+  static size_type bucketSize(size_type bucket) noexcept {
+    return FIRST_BUCKET_SIZE << bucket;
+  }
+
+  Slot& slotAt(size_type index) const noexcept {
+    return buckets_[bucketOf(index)].load(std::memory_order_acquire)[offsetOf(index)];
+  }
+
+  // Returns the bucket, installing it if no other thread has yet
+  Slot* ensureBucket(size_type b) {
+    Slot* bucket = buckets_[b].load(std::memory_order_acquire);
+    if (bucket != nullptr) {
+      return bucket;
+    }
+
+    Slot* fresh = allocateBucket(bucketSize(b));
+    if (buckets_[b].compare_exchange_strong(
+            bucket, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      return fresh;
+    }
+
+    freeBucket(fresh, bucketSize(b)); // Lost the race; bucket holds the winner's
+    return bucket;
+  }
+
+  Slot* allocateBucket(size_type slots) {
+    Slot* bucket = SlotTraits::allocate(slotAlloc_, slots);
+    for (size_type i = 0; i < slots; ++i) {
+      ::new (static_cast<void*>(bucket + i)) Slot();
+    }
+    return bucket;
+  }
+
+  void freeBucket(Slot* bucket, size_type slots) noexcept {
+    for (size_type i = 0; i < slots; ++i) {
+      bucket[i].~Slot();
+    }
+    SlotTraits::deallocate(slotAlloc_, bucket, slots);
+  }
+};
+
+#endif // CONCURRENTVECTOR_H
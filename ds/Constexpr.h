@@ -0,0 +1,37 @@
+#ifndef CONSTEXPR_H
+#define CONSTEXPR_H
+
+#include <memory>
+#include <type_traits>
+
+// Compile-time evaluation support for the containers.
+//
+// C++20 allows allocation, std::allocator_traits::construct/destroy, try blocks and
+// non-trivial destructors in constant expressions. Where the standard library supports
+// that, DS_CONSTEXPR_CONTAINERS is defined and DS_CONSTEXPR20 expands to constexpr, so
+// Vector and its helpers can be used inside constexpr functions (for example to build
+// a lookup table that is then copied into a StaticVector or std::array). Memory
+// allocated during constant evaluation must be freed before it ends, so a Vector
+// cannot itself be a constexpr variable. Under C++17 DS_CONSTEXPR20 expands to nothing.
+
+#if __cplusplus >= 202002L && defined(__cpp_constexpr_dynamic_alloc) && \
+    defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define DS_CONSTEXPR_CONTAINERS 1
+#define DS_CONSTEXPR20 constexpr
+#else
+#define DS_CONSTEXPR20
+#endif
+
+// @brief True while the calling code runs during constant evaluation.
+//
+// Guards the fast paths that cannot run at compile time (memcpy/memmove relocation,
+// byte buffers, atomics); always false before C++20.
+constexpr bool isConstantEvaluated() noexcept {
+#ifdef __cpp_lib_is_constant_evaluated
+  return std::is_constant_evaluated();
+#else
+  return false;
+#endif
+}
+
+#endif // CONSTEXPR_H
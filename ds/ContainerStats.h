@@ -0,0 +1,221 @@
+#ifndef CONTAINERSTATS_H
+#define CONTAINERSTATS_H
+
+#include "Constexpr.h"
+#include "Relocate.h"
+
+#include <cstddef>
+#include <type_traits>
+
+#ifdef DS_CONTAINER_STATS
+#include <atomic>
+#endif
+
+// Opt-in allocation and relocation statistics for Vector, SmallVector, HugeVector,
+// SegmentedVector, AList, GapAList, CircularAList and LList.
+//
+// Build with DS_CONTAINER_STATS defined (CMake: -DDS_CONTAINER_STATS=ON) to have every
+// container instance count its allocations, the bytes they requested, reallocations,
+// elements moved or copied between buffers, and its peak capacity. The same counters are
+// summed process-wide in relaxed atomics; globalContainerStats() reads them.
+//
+// Without the macro the recorder is an empty base class whose hooks are empty inline
+// functions: containers keep their size and the hooks compile to nothing. stats() and
+// globalContainerStats() still exist and report zeros, so calling code needs no #ifdefs.
+//
+// The macro changes container layouts, so it must be the same in every translation unit
+// of a program.
+
+#ifdef DS_CONTAINER_STATS
+inline constexpr bool containerStatsEnabled = true;
+#else
+inline constexpr bool containerStatsEnabled = false;
+#endif
+
+// @brief A snapshot of container statistics.
+struct ContainerStats {
+  std::size_t allocations = 0;    // Buffers or nodes obtained from the allocator
+  std::size_t bytesAllocated = 0; // Total bytes requested by those allocations
+  std::size_t reallocations = 0;  // Times live elements were transferred to a new buffer
+  std::size_t elementsMoved = 0;  // Elements moved (or relocated bytewise) between buffers
+  std::size_t elementsCopied = 0; // Elements copy-constructed from another container or
+                                  // because their move constructor may throw
+  std::size_t peakCapacity = 0;   // Largest capacity (LList: element count) reached
+};
+
+#ifdef DS_CONTAINER_STATS
+
+namespace container_stats_detail {
+  struct GlobalCounters {
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> bytesAllocated{0};
+    std::atomic<std::size_t> reallocations{0};
+    std::atomic<std::size_t> elementsMoved{0};
+    std::atomic<std::size_t> elementsCopied{0};
+    std::atomic<std::size_t> peakCapacity{0};
+  };
+
+  inline GlobalCounters& globalCounters() noexcept {
+    static GlobalCounters counters;
+    return counters;
+  }
+
+  inline void add(std::atomic<std::size_t>& counter, std::size_t n) noexcept {
+    counter.fetch_add(n, std::memory_order_relaxed);
+  }
+} // namespace container_stats_detail
+
+// @brief Aggregate statistics of every container in the process since the last reset.
+inline ContainerStats globalContainerStats() noexcept {
+  const auto& counters = container_stats_detail::globalCounters();
+
+  ContainerStats stats;
+  stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+  stats.bytesAllocated = counters.bytesAllocated.load(std::memory_order_relaxed);
+  stats.reallocations = counters.reallocations.load(std::memory_order_relaxed);
+  stats.elementsMoved = counters.elementsMoved.load(std::memory_order_relaxed);
+  stats.elementsCopied = counters.elementsCopied.load(std::memory_order_relaxed);
+  stats.peakCapacity = counters.peakCapacity.load(std::memory_order_relaxed);
+  return stats;
+}
+
+// @brief Zero the process-wide statistics (per-instance statistics are untouched).
+inline void resetGlobalContainerStats() noexcept {
+  auto& counters = container_stats_detail::globalCounters();
+  counters.allocations.store(0, std::memory_order_relaxed);
+  counters.bytesAllocated.store(0, std::memory_order_relaxed);
+  counters.reallocations.store(0, std::memory_order_relaxed);
+  counters.elementsMoved.store(0, std::memory_order_relaxed);
+  counters.elementsCopied.store(0, std::memory_order_relaxed);
+  counters.peakCapacity.store(0, std::memory_order_relaxed);
+}
+
+// @brief Per-instance statistics, inherited privately by the instrumented containers.
+//
+// Statistics describe one container object: copies and moves of a container start
+// from zero, and assignment leaves the target's own counts in place.
+class ContainerStatsRecorder {
+public:
+  ContainerStatsRecorder() noexcept = default;
+  constexpr ContainerStatsRecorder(const ContainerStatsRecorder&) noexcept {}
+  constexpr ContainerStatsRecorder& operator=(const ContainerStatsRecorder&) noexcept {
+    return *this;
+  }
+
+  // @brief Statistics of this container since it was constructed.
+  constexpr const ContainerStats& stats() const noexcept {
+    return stats_;
+  }
+
+protected:
+  DS_CONSTEXPR20 void recordAllocation(std::size_t bytes) noexcept {
+    ++stats_.allocations;
+    stats_.bytesAllocated += bytes;
+    if (isConstantEvaluated()) {
+      return;
+    }
+    container_stats_detail::add(container_stats_detail::globalCounters().allocations, 1);
+    container_stats_detail::add(container_stats_detail::globalCounters().bytesAllocated,
+                                bytes);
+  }
+
+  DS_CONSTEXPR20 void recordCapacity(std::size_t capacity) noexcept {
+    if (capacity <= stats_.peakCapacity) {
+      return;
+    }
+    stats_.peakCapacity = capacity;
+    if (isConstantEvaluated()) {
+      return;
+    }
+
+    auto& peak = container_stats_detail::globalCounters().peakCapacity;
+    std::size_t seen = peak.load(std::memory_order_relaxed);
+    while (seen < capacity && !peak.compare_exchange_weak(seen, capacity,
+                                                          std::memory_order_relaxed)) {
+    }
+  }
+
+  DS_CONSTEXPR20 void recordReallocation() noexcept {
+    ++stats_.reallocations;
+    if (isConstantEvaluated()) {
+      return;
+    }
+    container_stats_detail::add(container_stats_detail::globalCounters().reallocations, 1);
+  }
+
+  DS_CONSTEXPR20 void recordMoves(std::size_t count) noexcept {
+    stats_.elementsMoved += count;
+    if (isConstantEvaluated()) {
+      return;
+    }
+    container_stats_detail::add(container_stats_detail::globalCounters().elementsMoved, count);
+  }
+
+  DS_CONSTEXPR20 void recordCopies(std::size_t count) noexcept {
+    stats_.elementsCopied += count;
+    if (isConstantEvaluated()) {
+      return;
+    }
+    container_stats_detail::add(container_stats_detail::globalCounters().elementsCopied,
+                                count);
+  }
+
+  // Adds the per-instance counts of a temporary whose storage this container took over
+  // (the process-wide counters already include them)
+  constexpr void absorbStats(const ContainerStatsRecorder& other) noexcept {
+    stats_.allocations += other.stats_.allocations;
+    stats_.bytesAllocated += other.stats_.bytesAllocated;
+    stats_.reallocations += other.stats_.reallocations;
+    stats_.elementsMoved += other.stats_.elementsMoved;
+    stats_.elementsCopied += other.stats_.elementsCopied;
+    if (other.stats_.peakCapacity > stats_.peakCapacity) {
+      stats_.peakCapacity = other.stats_.peakCapacity;
+    }
+  }
+
+  // Counts count elements transferred the way uninitializedRelocate and
+  // std::move_if_noexcept transfer them: moved unless the move may throw and a copy exists
+  template <typename T>
+  DS_CONSTEXPR20 void recordRelocation(std::size_t count) noexcept {
+    if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T> ||
+                  !std::is_copy_constructible_v<T>) {
+      recordMoves(count);
+    } else {
+      recordCopies(count);
+    }
+  }
+
+private:
+  ContainerStats stats_;
+};
+
+#else
+
+inline ContainerStats globalContainerStats() noexcept {
+  return ContainerStats{};
+}
+
+inline void resetGlobalContainerStats() noexcept {}
+
+// Disabled recorder: empty, so the containers' empty base optimisation removes it.
+class ContainerStatsRecorder {
+public:
+  constexpr ContainerStats stats() const noexcept {
+    return ContainerStats{};
+  }
+
+protected:
+  constexpr void recordAllocation(std::size_t) noexcept {}
+  constexpr void recordCapacity(std::size_t) noexcept {}
+  constexpr void recordReallocation() noexcept {}
+  constexpr void recordMoves(std::size_t) noexcept {}
+  constexpr void recordCopies(std::size_t) noexcept {}
+  constexpr void absorbStats(const ContainerStatsRecorder&) noexcept {}
+
+  template <typename T>
+  constexpr void recordRelocation(std::size_t) noexcept {}
+};
+
+#endif // DS_CONTAINER_STATS
+
+#endif // CONTAINERSTATS_H
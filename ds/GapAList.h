@@ -0,0 +1,545 @@
+#ifndef GAPALIST_H
+#define GAPALIST_H
+
+#include "ContainerStats.h"
+#include "GrowthPolicy.h"
+#include "List.h"
+#include "Relocate.h"
+#include "Uninitialized.h"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+// @brief Array-based list that keeps its free space as a gap at the last edit position.
+// @tparam E The type of elements stored in the list.
+// @tparam Allocator Allocator used for storage and element construction.
+// @tparam Growth Growth policy deciding the new capacity when the gap is used up
+//         (see GrowthPolicy.h).
+//
+// Implements the List interface like AList, but the unused slots sit between the
+// elements before and after the gap instead of at the end of the array:
+//
+//   [ 0 .. gapStart ) [ gap ) [ gapEnd .. capacity )
+//
+// insert() and remove() first move the gap to the cursor, which relocates only the
+// elements between the old and the new position, then fill or widen the gap in O(1).
+// Cursor movement is free: the gap follows at the next edit. A run of edits around a
+// moving cursor (insert then next, remove, prev, ...) therefore costs O(1) amortized per
+// edit, where AList shifts the whole tail each time; append() moves the gap to the end.
+//
+// Reads stay on one array: getValue() adds the gap width past the gap, forEach() scans
+// the two runs in turn and data() closes the gap to return the elements contiguously.
+// Moving the gap relocates elements, so E must be trivially relocatable or nothrow
+// move constructible.
+template <typename E, typename Allocator = std::allocator<E>, typename Growth = DoublingGrowth>
+class GapAList : public List<E>, private ContainerStatsRecorder {
+private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  static_assert(std::is_same_v<typename AllocTraits::value_type, E>,
+                "GapAList: Allocator::value_type must be E");
+  static_assert(std::is_same_v<typename AllocTraits::pointer, E*>,
+                "GapAList: Allocator must use raw pointers");
+  static_assert(is_trivially_relocatable_v<E> || std::is_nothrow_move_constructible_v<E>,
+                "GapAList: E must be trivially relocatable or nothrow move constructible");
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 10; // Default initial capacity
+
+  Allocator alloc_;       // Allocator for storage and element lifetimes
+  E* listArray_;         // Elements in [0, gapStart_) and [gapEnd_, capacity_)
+  std::size_t capacity_; // Number of slots
+  std::size_t gapStart_; // First slot of the gap (= number of elements before it)
+  std::size_t gapEnd_;   // One past the last slot of the gap
+  std::size_t curr_;     // Position of current element
+
+  std::size_t gapSize() const noexcept {
+    return gapEnd_ - gapStart_;
+  }
+
+  std::size_t tailSize() const noexcept {
+    return capacity_ - gapEnd_;
+  }
+
+  // @brief Slot holding the element at list position pos.
+  E* slot(std::size_t pos) const noexcept {
+    return listArray_ + (pos < gapStart_ ? pos : pos + gapSize());
+  }
+
+  // @brief Allocate uninitialized storage for n elements.
+  E* allocate(std::size_t n) {
+    if (n == 0) {
+      return nullptr;
+    }
+
+    E* p = AllocTraits::allocate(alloc_, n);
+    recordAllocation(n * sizeof(E));
+    recordCapacity(n);
+    return p;
+  }
+
+  // @brief Free storage obtained from allocate(). Elements must already be destroyed.
+  void deallocate(E* p, std::size_t n) noexcept {
+    if (p != nullptr) {
+      AllocTraits::deallocate(alloc_, p, n);
+    }
+  }
+
+  // @brief Exchange storage, gap and cursor (but not allocators) with another list.
+  void swapStorage(GapAList& other) noexcept {
+    std::swap(listArray_, other.listArray_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(gapStart_, other.gapStart_);
+    std::swap(gapEnd_, other.gapEnd_);
+    std::swap(curr_, other.curr_);
+  }
+
+  // @brief Destroy all elements, leaving the whole array as gap.
+  void destroyAll() noexcept {
+    destroyN(alloc_, listArray_, gapStart_);
+    destroyN(alloc_, listArray_ + gapEnd_, tailSize());
+    gapStart_ = 0;
+    gapEnd_ = capacity_;
+    curr_ = 0;
+  }
+
+  // @brief Destroy all elements and free the storage.
+  void release() noexcept {
+    destroyAll();
+    deallocate(listArray_, capacity_);
+    listArray_ = nullptr;
+    capacity_ = 0;
+    gapEnd_ = 0;
+  }
+
+  // @brief Move the gap so that it starts at list position pos.
+  //
+  // Relocates the |pos - gapStart_| elements in between, across the gap, in one step
+  // (a memmove for trivially relocatable types).
+  void moveGap(std::size_t pos) noexcept {
+    if (pos < gapStart_) {
+      const std::size_t count = gapStart_ - pos;
+      relocateWithin(alloc_, listArray_ + pos, count, listArray_ + gapEnd_ - count);
+      gapStart_ -= count;
+      gapEnd_ -= count;
+    } else if (pos > gapStart_) {
+      const std::size_t count = pos - gapStart_;
+      relocateWithin(alloc_, listArray_ + gapEnd_, count, listArray_ + gapStart_);
+      gapStart_ += count;
+      gapEnd_ += count;
+    }
+  }
+
+  // @brief Reallocate to newCapacity slots, keeping the gap where it is.
+  // @param newCapacity The new capacity (must be >= length()).
+  void resize(std::size_t newCapacity) {
+    const std::size_t size = length();
+    if (newCapacity < size) {
+      newCapacity = size;
+    }
+
+    E* newArray = allocate(newCapacity);
+    const std::size_t tail = tailSize();
+    uninitializedRelocate(alloc_, listArray_, gapStart_, newArray);
+    uninitializedRelocate(alloc_, listArray_ + gapEnd_, tail, newArray + newCapacity - tail);
+
+    if (capacity_ > 0) {
+      recordReallocation();
+    }
+    recordRelocation<E>(size);
+    deallocate(listArray_, capacity_);
+    listArray_ = newArray;
+    capacity_ = newCapacity;
+    gapEnd_ = newCapacity - tail;
+  }
+
+  // @brief Ensure the gap has room for at least count more elements.
+  void ensureCapacity(std::size_t count = 1) {
+    if (gapSize() < count) {
+      resize(Growth::next(capacity_, length() + count, sizeof(E)));
+    }
+  }
+
+  // @brief True if p points into this list's storage.
+  bool pointsInto(const E* p) const noexcept {
+    return !std::less<const E*>()(p, listArray_) &&
+           std::less<const E*>()(p, listArray_ + capacity_);
+  }
+
+  // @brief Move the gap to the cursor and construct a new element in its first slot.
+  template <typename... Args>
+  void emplaceAtCursor(Args&&... args) {
+    ensureCapacity();
+    moveGap(curr_);
+    AllocTraits::construct(alloc_, listArray_ + gapStart_, std::forward<Args>(args)...);
+    ++gapStart_;
+  }
+
+  // @brief Copy other's elements into this list's (empty, large enough) storage.
+  void copyFrom(const GapAList& other) {
+    std::size_t copied = 0;
+    try {
+      other.forEach([&](const E& item) {
+        AllocTraits::construct(alloc_, listArray_ + copied, item);
+        ++copied;
+      });
+    } catch (...) {
+      destroyN(alloc_, listArray_, copied);
+      throw;
+    }
+
+    gapStart_ = copied;
+    recordCopies(copied);
+  }
+
+public:
+  using allocator_type = Allocator;
+  using growth_policy = Growth;
+
+  // @brief Allocation statistics of this list (all zero unless DS_CONTAINER_STATS).
+  using ContainerStatsRecorder::stats;
+
+  // @brief Construct an empty list with given initial capacity.
+  // @param initialCapacity Initial capacity (default: DEFAULT_CAPACITY).
+  // @param alloc Allocator instance to use.
+  explicit GapAList(std::size_t initialCapacity = DEFAULT_CAPACITY,
+                    const Allocator& alloc = Allocator())
+      : alloc_{alloc}, listArray_{allocate(initialCapacity)}, capacity_{initialCapacity},
+        gapStart_{0}, gapEnd_{initialCapacity}, curr_{0} {
+  }
+
+  // @brief Construct an empty list with default capacity using the given allocator.
+  // @param alloc Allocator instance to use.
+  explicit GapAList(const Allocator& alloc) : GapAList(DEFAULT_CAPACITY, alloc) {
+  }
+
+  // @brief Copy constructor - performs deep copy; the copy has its gap at the end.
+  // @param other The list to copy from.
+  //
+  // The allocator is obtained through select_on_container_copy_construction.
+  GapAList(const GapAList& other)
+      : GapAList(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+  }
+
+  // @brief Copy constructor with an explicit allocator - performs deep copy.
+  // @param other The list to copy from.
+  // @param alloc Allocator instance to use.
+  GapAList(const GapAList& other, const Allocator& alloc)
+      : alloc_{alloc}, listArray_{allocate(other.capacity_)}, capacity_{other.capacity_},
+        gapStart_{0}, gapEnd_{other.capacity_}, curr_{other.curr_} {
+    try {
+      copyFrom(other);
+    } catch (...) {
+      deallocate(listArray_, capacity_);
+      throw;
+    }
+  }
+
+  // @brief Copy assignment operator - performs deep copy.
+  // @param other The list to copy from.
+  // @return Reference to this list.
+  //
+  // Adopts other's allocator if propagate_on_container_copy_assignment is true.
+  GapAList& operator=(const GapAList& other) {
+    if (this != &other) {
+      if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_) {
+          release(); // Storage must be returned to the allocator that provided it
+        }
+        alloc_ = other.alloc_;
+      }
+
+      GapAList temp(other, alloc_);
+      swapStorage(temp);
+      absorbStats(temp);
+    }
+    return *this;
+  }
+
+  // @brief Move constructor.
+  // @param other The list to move from.
+  GapAList(GapAList&& other) noexcept
+      : alloc_{std::move(other.alloc_)}, listArray_{other.listArray_},
+        capacity_{other.capacity_}, gapStart_{other.gapStart_}, gapEnd_{other.gapEnd_},
+        curr_{other.curr_} {
+    other.listArray_ = nullptr;
+    other.capacity_ = 0;
+    other.gapStart_ = 0;
+    other.gapEnd_ = 0;
+    other.curr_ = 0;
+  }
+
+  // @brief Move assignment operator.
+  // @param other The list to move from.
+  // @return Reference to this list.
+  //
+  // Steals other's storage when the allocator propagates or compares equal. Otherwise
+  // the elements are moved one by one into storage from this list's allocator.
+  GapAList& operator=(GapAList&& other) noexcept(
+      AllocTraits::propagate_on_container_move_assignment::value ||
+      AllocTraits::is_always_equal::value) {
+    if (this != &other) {
+      if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+        release();
+        alloc_ = std::move(other.alloc_);
+        swapStorage(other);
+      } else if (alloc_ == other.alloc_) {
+        release();
+        swapStorage(other);
+      } else {
+        GapAList temp(other.capacity_, alloc_);
+        other.moveGap(other.length());
+        uninitializedMoveN(alloc_, other.listArray_, other.gapStart_, temp.listArray_);
+        temp.gapStart_ = other.gapStart_;
+        temp.curr_ = other.curr_;
+        temp.recordMoves(temp.gapStart_);
+        swapStorage(temp);
+        absorbStats(temp);
+        other.clear();
+      }
+    }
+    return *this;
+  }
+
+  // @brief Destructor - destroys live elements and frees the storage.
+  ~GapAList() override {
+    release();
+  }
+
+  // @brief Clear the list, removing all elements.
+  //
+  // Capacity remains unchanged.
+  void clear() override {
+    destroyAll();
+  }
+
+  // @brief Insert an element at the current position.
+  // @param item The element to insert.
+  //
+  // The gap moves to the cursor and the element fills its first slot.
+  // Time complexity: O(1) amortized plus O(d), d = distance from the last edit.
+  void insert(const E& item) override {
+    if (pointsInto(&item)) {
+      E copy(item); // item would be relocated by the gap move below
+      emplaceAtCursor(std::move(copy));
+    } else {
+      emplaceAtCursor(item);
+    }
+  }
+
+  // @brief Append an element at the end of the list.
+  // @param item The element to append.
+  //
+  // Time complexity: O(1) amortized once the gap is at the end (e.g. after a previous
+  // append); moving it there first costs O(elements after the gap).
+  void append(const E& item) override {
+    const std::size_t cursor = curr_;
+    curr_ = length();
+    try {
+      insert(item);
+    } catch (...) {
+      curr_ = cursor;
+      throw;
+    }
+    curr_ = cursor;
+  }
+
+  // @brief Remove and return the current element.
+  // @return The removed element.
+  // @throws std::out_of_range if no element is at current position.
+  //
+  // The gap moves to the cursor and absorbs the element's slot; the element right before
+  // the gap is absorbed in place, so prev() then remove() after an insert moves nothing.
+  // Time complexity: O(1) plus O(d), d = distance from the last edit.
+  E remove() override {
+    if (curr_ >= length()) {
+      throw std::out_of_range("No element at current position");
+    }
+
+    E* target;
+    if (curr_ + 1 == gapStart_) {
+      // Element just before the gap (e.g. prev() after an insert): widen the gap leftwards
+      target = listArray_ + --gapStart_;
+    } else {
+      moveGap(curr_);
+      target = listArray_ + gapEnd_++;
+    }
+    E item = std::move(*target);
+    AllocTraits::destroy(alloc_, target);
+    return item;
+  }
+
+  // @brief Insert the elements of [first, last) at the current position, in order.
+  // @param first Start of the elements to insert.
+  // @param last One past the last element to insert.
+  //
+  // Moves the gap once and copies the batch into it; the first inserted element becomes
+  // the current element.
+  // Time complexity: O(k) amortized plus O(d), d = distance from the last edit.
+  void insertRange(const E* first, const E* last) override {
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if (count == 0) {
+      return;
+    }
+    if (pointsInto(first)) {
+      // The source would move with the gap: insert from a copy instead
+      GapAList copy(count, alloc_);
+      copy.appendRange(first, last);
+      insertRange(copy.listArray_, copy.listArray_ + count);
+      return;
+    }
+
+    ensureCapacity(count);
+    moveGap(curr_);
+    uninitializedCopyN(alloc_, first, count, listArray_ + gapStart_);
+    gapStart_ += count;
+  }
+
+  // @brief Append the elements of [first, last) at the end of the list, in order.
+  // @param first Start of the elements to append.
+  // @param last One past the last element to append.
+  void appendRange(const E* first, const E* last) override {
+    const std::size_t cursor = curr_;
+    curr_ = length();
+    try {
+      insertRange(first, last);
+    } catch (...) {
+      curr_ = cursor;
+      throw;
+    }
+    curr_ = cursor;
+  }
+
+  // @brief Remove count elements starting at the current element.
+  // @param count The number of elements to remove.
+  // @throws std::out_of_range if fewer than count elements are at or after the current
+  //         position; the list is left unchanged.
+  //
+  // Moves the gap once and widens it over the removed elements.
+  // Time complexity: O(k) plus O(d), d = distance from the last edit.
+  void removeRange(std::size_t count) override {
+    if (count > length() - curr_) {
+      throw std::out_of_range("Count out of range");
+    }
+
+    moveGap(curr_);
+    destroyN(alloc_, listArray_ + gapEnd_, count);
+    gapEnd_ += count;
+  }
+
+  // @brief Move cursor to the start of the list.
+  void moveToStart() noexcept override {
+    curr_ = 0;
+  }
+
+  // @brief Move cursor to the end of the list (one past the last element).
+  void moveToEnd() noexcept override {
+    curr_ = length();
+  }
+
+  // @brief Move cursor one position to the left (no change if already at start).
+  void prev() noexcept override {
+    if (curr_ > 0) {
+      --curr_;
+    }
+  }
+
+  // @brief Move cursor one position to the right (no change if already at end).
+  void next() noexcept override {
+    if (curr_ < length()) {
+      ++curr_;
+    }
+  }
+
+  // @brief Get the number of elements in the list.
+  [[nodiscard]] std::size_t length() const noexcept override {
+    return capacity_ - gapSize();
+  }
+
+  // @brief Get the current cursor position.
+  [[nodiscard]] std::size_t currPos() const noexcept override {
+    return curr_;
+  }
+
+  // @brief Set the cursor position; the gap stays put until the next edit.
+  // @param pos The position to set (0 <= pos <= size).
+  // @throws std::out_of_range if pos is out of valid range.
+  void moveToPos(std::size_t pos) override {
+    if (pos > length()) {
+      throw std::out_of_range("Position out of range");
+    }
+    curr_ = pos;
+  }
+
+  // @brief Get the element at the current position.
+  // @return Const reference to the current element.
+  // @throws std::out_of_range if no element is at current position.
+  [[nodiscard]] const E& getValue() const override {
+    if (curr_ >= length()) {
+      throw std::out_of_range("No element at current position");
+    }
+    return *slot(curr_);
+  }
+
+  // @brief Visit every element in order without moving the cursor or the gap.
+  // @param fn Callable invoked with a const reference to each element.
+  //
+  // Time complexity: O(n), as two sequential scans.
+  template <typename Fn>
+  void forEach(Fn&& fn) const {
+    for (std::size_t i = 0; i < gapStart_; ++i) {
+      fn(listArray_[i]);
+    }
+    for (std::size_t i = gapEnd_; i < capacity_; ++i) {
+      fn(listArray_[i]);
+    }
+  }
+
+  // @brief Close the gap and get the elements as one array.
+  // @return Pointer to the first element; [0, length()) are live.
+  //
+  // Moves the gap to the end (O(elements after the gap)); the pointer stays valid until
+  // the next insert or remove before the end of the list.
+  [[nodiscard]] const E* data() noexcept {
+    moveGap(length());
+    return listArray_;
+  }
+
+  // @brief Get a copy of the allocator.
+  [[nodiscard]] allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }
+
+  // @brief Get the current capacity of the internal array.
+  // @return The capacity.
+  [[nodiscard]] std::size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  // @brief Reserve space for at least n elements.
+  // @param n The desired capacity.
+  //
+  // If n > current capacity, reallocates to capacity of at least n.
+  // Does not change the size or contents of the list.
+  void reserve(std::size_t n) {
+    if (n > capacity_) {
+      resize(n);
+    }
+  }
+
+  // @brief Shrink the capacity to fit the current size.
+  //
+  // Reduces memory usage by reallocating to the minimum needed capacity.
+  void shrink_to_fit() {
+    if (gapSize() > 0) {
+      const std::size_t size = length();
+      resize(size > 0 ? size : 1);
+    }
+  }
+
+};
+
+#endif // GAPALIST_H
@@ -0,0 +1,145 @@
+#ifndef GROWTHPOLICY_H
+#define GROWTHPOLICY_H
+
+#include <cstddef>
+#include <limits>
+
+// Capacity growth strategies for the dynamic-array containers (Vector, AList).
+//
+// A growth policy is a type with a single static member
+//
+//   static constexpr std::size_t next(std::size_t capacity, std::size_t required,
+//                                     std::size_t elementSize) noexcept;
+//
+// returning the capacity (in elements) to reallocate to when a container holding
+// `capacity` slots needs room for `required` elements. The result must be at least
+// `required`. Containers only consult the policy when they grow on their own;
+// explicit reserve() requests are honoured exactly. constexpr is only required of
+// policies used by containers in constant expressions (see Constexpr.h).
+//
+// Geometric policies (FactorGrowth) give amortized O(1) appends at the cost of up to
+// (factor - 1) x size of slack. AdditiveGrowth bounds slack to a fixed step but makes
+// appends O(n) amortized. PageGrowth and SizeClassGrowth wrap another policy and round
+// the byte size up so the allocation has no internal waste.
+
+
+// @brief Multiply the capacity by Numerator / Denominator on every growth.
+// @tparam Numerator Growth factor numerator.
+// @tparam Denominator Growth factor denominator.
+template <std::size_t Numerator, std::size_t Denominator = 1>
+struct FactorGrowth {
+  static_assert(Numerator > Denominator, "FactorGrowth: factor must be greater than 1");
+
+  static constexpr std::size_t next(std::size_t capacity,
+                                    std::size_t required,
+                                    std::size_t elementSize) noexcept {
+    const std::size_t maxElements = std::numeric_limits<std::size_t>::max() / elementSize;
+
+    // Overflow check: fall back to the largest representable capacity
+    std::size_t grown = capacity <= maxElements / Numerator
+                            ? capacity * Numerator / Denominator
+                            : maxElements;
+
+    return grown > required ? grown : required;
+  }
+};
+
+// @brief Double the capacity on every growth (classic amortized O(1) strategy).
+using DoublingGrowth = FactorGrowth<2>;
+
+// @brief Grow by 50% on every growth: less slack, and freed blocks can be reused.
+using HalfAgainGrowth = FactorGrowth<3, 2>;
+
+
+// @brief Grow by a fixed number of elements.
+// @tparam Step Number of elements added on every growth.
+//
+// Bounds the unused capacity to Step elements, at the price of O(n) amortized
+// appends. Suited to very large arrays whose final size is roughly known.
+template <std::size_t Step>
+struct AdditiveGrowth {
+  static_assert(Step > 0, "AdditiveGrowth: step must be positive");
+
+  static constexpr std::size_t next(std::size_t capacity,
+                                    std::size_t required,
+                                    std::size_t elementSize) noexcept {
+    const std::size_t maxElements = std::numeric_limits<std::size_t>::max() / elementSize;
+    std::size_t grown =
+        maxElements >= Step && capacity <= maxElements - Step ? capacity + Step : maxElements;
+
+    return grown > required ? grown : required;
+  }
+};
+
+
+// @brief Round another policy's result up to a whole number of pages.
+// @tparam PageSize Page size in bytes (a power of two).
+// @tparam Base The policy deciding how far to grow.
+//
+// Large allocations are served directly by the OS in page units, so the rounded-up
+// tail would be mapped anyway; this hands it to the container as usable capacity.
+template <std::size_t PageSize = 4096, typename Base = DoublingGrowth>
+struct PageGrowth {
+  static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0,
+                "PageGrowth: page size must be a power of two");
+
+  static constexpr std::size_t next(std::size_t capacity,
+                                    std::size_t required,
+                                    std::size_t elementSize) noexcept {
+    const std::size_t elements = Base::next(capacity, required, elementSize);
+
+    if (elements > std::numeric_limits<std::size_t>::max() / elementSize) {
+      return elements;
+    }
+
+    const std::size_t bytes = elements * elementSize;
+    if (bytes < PageSize || bytes > std::numeric_limits<std::size_t>::max() - (PageSize - 1)) {
+      return elements; // Below a page, or rounding would overflow
+    }
+
+    return ((bytes + PageSize - 1) & ~(PageSize - 1)) / elementSize;
+  }
+};
+
+
+// @brief Round another policy's result up to the allocator's size class.
+// @tparam Base The policy deciding how far to grow.
+//
+// Models the size classes of jemalloc/tcmalloc-style allocators: 16-byte spacing up
+// to 128 bytes, then four classes per power of two (160, 192, 224, 256, 320, ...).
+// Requesting exactly a size class turns slack the allocator would waste internally
+// into usable capacity.
+template <typename Base = DoublingGrowth>
+struct SizeClassGrowth {
+  // @brief Round a byte count up to its size class.
+  static constexpr std::size_t roundToSizeClass(std::size_t bytes) noexcept {
+    if (bytes <= 128) {
+      return (bytes + 15) & ~std::size_t{15};
+    }
+
+    // Largest power of two strictly below bytes; classes are spaced a quarter of it
+    std::size_t power = 128;
+    while (power < bytes / 2 + (bytes & 1)) {
+      power <<= 1;
+    }
+    const std::size_t spacing = power / 4;
+
+    if (bytes > std::numeric_limits<std::size_t>::max() - spacing) {
+      return bytes;
+    }
+    return (bytes + spacing - 1) / spacing * spacing;
+  }
+
+  static constexpr std::size_t next(std::size_t capacity,
+                                    std::size_t required,
+                                    std::size_t elementSize) noexcept {
+    const std::size_t elements = Base::next(capacity, required, elementSize);
+
+    if (elements > std::numeric_limits<std::size_t>::max() / elementSize) {
+      return elements;
+    }
+    return roundToSizeClass(elements * elementSize) / elementSize;
+  }
+};
+
+#endif // GROWTHPOLICY_H
@@ -0,0 +1,499 @@
+#ifndef HUGEVECTOR_H
+#define HUGEVECTOR_H
+
+#if defined(__linux__)
+
+#include "ContainerStats.h"
+#include "Relocate.h"
+#include "Uninitialized.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+// @brief Vector for multi-gigabyte arrays, backed directly by mmap (Linux only).
+// @tparam T The type of elements stored; must be trivially relocatable.
+//
+// Offers the same interface as Vector, but storage comes straight from the kernel:
+// growing the buffer calls mremap, which moves page-table entries instead of copying
+// the elements, so reallocating a 2 GB array costs page-table work rather than 2 GB
+// of memory traffic, and never needs old and new copies resident at the same time.
+// Because mremap may move the mapping, T must be trivially relocatable.
+//
+// With transparent huge pages enabled, mappings are sized in 2 MiB multiples, start on a
+// 2 MiB boundary (also after growth) and are advised with MADV_HUGEPAGE, cutting TLB
+// misses on large scans.
+//
+// With DS_CONTAINER_STATS defined, stats() counts every mmap and mremap as an allocation
+// of the new mapping length, and each mremap also as a reallocation. No elements are
+// counted as moved: mremap moves page-table entries, not elements.
+template <typename T>
+class HugeVector : private ContainerStatsRecorder {
+  static_assert(is_trivially_relocatable_v<T>,
+                "HugeVector: mremap relocates elements, so T must be trivially relocatable");
+
+public:
+  // Type definitions
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  using ContainerStatsRecorder::stats;
+
+  // @brief Construct an empty vector with optional initial capacity.
+  // @param initialCapacity Initial capacity (default: 0, maps on first insertion).
+  // @param transparentHugePages Advise the kernel to back the mapping with huge pages.
+  explicit HugeVector(size_type initialCapacity = 0, bool transparentHugePages = false)
+      : elements_{nullptr}, capacity_{0}, size_{0}, mappedBytes_{0},
+        hugePages_{transparentHugePages} {
+    reserve(initialCapacity);
+  }
+
+  // @brief Construct a vector with count copies of value.
+  // @param count Number of elements to construct.
+  // @param value Value to initialize elements with.
+  // @param transparentHugePages Advise the kernel to back the mapping with huge pages.
+  HugeVector(size_type count, const T& value, bool transparentHugePages = false)
+      : HugeVector(count, transparentHugePages) {
+    uninitializedFillN(alloc_, elements_, count, value);
+    size_ = count;
+  }
+
+  // @brief Copy constructor - performs deep copy into a new mapping.
+  // @param other The vector to copy from.
+  HugeVector(const HugeVector& other) : HugeVector(other.size_, other.hugePages_) {
+    uninitializedCopyN(alloc_, other.elements_, other.size_, elements_);
+    size_ = other.size_;
+    recordCopies(size_);
+  }
+
+  // @brief Copy assignment operator - performs deep copy.
+  // @param other The vector to copy from.
+  // @return Reference to this vector.
+  HugeVector& operator=(const HugeVector& other) {
+    if (this != &other) {
+      HugeVector temp(other);
+      swap(temp);
+      absorbStats(temp);
+    }
+
+    return *this;
+  }
+
+  // @brief Move constructor - takes over the mapping.
+  // @param other The vector to move from.
+  HugeVector(HugeVector&& other) noexcept
+      : elements_{other.elements_}, capacity_{other.capacity_}, size_{other.size_},
+        mappedBytes_{other.mappedBytes_}, hugePages_{other.hugePages_} {
+    other.elements_ = nullptr;
+    other.capacity_ = 0;
+    other.size_ = 0;
+    other.mappedBytes_ = 0;
+  }
+
+  // @brief Move assignment operator - takes over the mapping.
+  // @param other The vector to move from.
+  // @return Reference to this vector.
+  HugeVector& operator=(HugeVector&& other) noexcept {
+    if (this != &other) {
+      HugeVector temp(std::move(other));
+      swap(temp);
+    }
+
+    return *this;
+  }
+
+  // @brief Destructor - destroys live elements and unmaps the storage.
+  ~HugeVector() {
+    release();
+  }
+
+
+  // Element access
+
+  // @brief Access element at index (no bounds checking).
+  reference operator[](size_type index) noexcept {
+    return elements_[index];
+  }
+
+  // @brief Access element at index (no bounds checking).
+  const_reference operator[](size_type index) const noexcept {
+    return elements_[index];
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @throws std::out_of_range if index >= size.
+  reference at(size_type index) {
+    if (index >= size_) {
+      throw std::out_of_range("HugeVector::at: index out of range");
+    }
+
+    return elements_[index];
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @throws std::out_of_range if index >= size.
+  const_reference at(size_type index) const {
+    if (index >= size_) {
+      throw std::out_of_range("HugeVector::at: index out of range");
+    }
+
+    return elements_[index];
+  }
+
+  // @brief Access the first element.
+  // @throws std::out_of_range if vector is empty.
+  reference front() {
+    if (empty()) {
+      throw std::out_of_range("HugeVector::front: vector is empty");
+    }
+
+    return elements_[0];
+  }
+
+  // @brief Access the first element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference front() const {
+    if (empty()) {
+      throw std::out_of_range("HugeVector::front: vector is empty");
+    }
+
+    return elements_[0];
+  }
+
+  // @brief Access the last element.
+  // @throws std::out_of_range if vector is empty.
+  reference back() {
+    if (empty()) {
+      throw std::out_of_range("HugeVector::back: vector is empty");
+    }
+
+    return elements_[size_ - 1];
+  }
+
+  // @brief Access the last element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference back() const {
+    if (empty()) {
+      throw std::out_of_range("HugeVector::back: vector is empty");
+    }
+
+    return elements_[size_ - 1];
+  }
+
+  // @brief Get pointer to underlying array (page aligned).
+  pointer data() noexcept {
+    return elements_;
+  }
+
+  // @brief Get pointer to underlying array (page aligned).
+  const_pointer data() const noexcept {
+    return elements_;
+  }
+
+  // @brief Get iterator to the beginning.
+  iterator begin() noexcept {
+    return elements_;
+  }
+
+  // @brief Get iterator to the end.
+  iterator end() noexcept {
+    return elements_ + size_;
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator begin() const noexcept {
+    return elements_;
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator end() const noexcept {
+    return elements_ + size_;
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator cbegin() const noexcept {
+    return elements_;
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator cend() const noexcept {
+    return elements_ + size_;
+  }
+
+  // @brief Check if the vector is empty.
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // @brief Get the number of elements in the vector.
+  [[nodiscard]] size_type size() const noexcept {
+    return size_;
+  }
+
+  // @brief Get the number of elements the current mapping can hold.
+  [[nodiscard]] size_type capacity() const noexcept {
+    return capacity_;
+  }
+
+  // @brief Get the size of the current mapping in bytes.
+  [[nodiscard]] size_type mappedBytes() const noexcept {
+    return mappedBytes_;
+  }
+
+  // @brief Check whether the mapping is advised to use transparent huge pages.
+  [[nodiscard]] bool usesHugePages() const noexcept {
+    return hugePages_;
+  }
+
+  // @brief Reserve space for at least newCapacity elements.
+  // @param newCapacity The desired capacity.
+  // @throws std::bad_alloc if the kernel refuses the mapping.
+  //
+  // Capacity is rounded up to whole pages (2 MiB units with huge pages).
+  void reserve(size_type newCapacity) {
+    if (newCapacity > capacity_) {
+      remap(newCapacity);
+    }
+  }
+
+  // @brief Shrink the mapping to the pages needed by the current size.
+  void shrink_to_fit() {
+    if (size_ == 0) {
+      release();
+    } else if (roundToMapping(size_ * sizeof(T)) < mappedBytes_) {
+      remap(size_);
+    }
+  }
+
+  // @brief Clear the vector, removing all elements. The mapping is kept.
+  void clear() noexcept {
+    destroyN(alloc_, elements_, size_);
+    size_ = 0;
+  }
+
+  // @brief Add an element to the end of the vector (copy).
+  void push_back(const T& item) {
+    emplace_back(item);
+  }
+
+  // @brief Add an element to the end of the vector (move).
+  void push_back(T&& item) {
+    emplace_back(std::move(item));
+  }
+
+  // @brief Construct an element in place at the end of the vector.
+  // @param args Arguments forwarded to T's constructor.
+  // @return Reference to the new element.
+  //
+  // Time complexity: O(1) amortized; growth is an mremap, not a copy.
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      return *growAndEmplace(size_, std::forward<Args>(args)...);
+    }
+
+    std::allocator_traits<std::allocator<T>>::construct(
+        alloc_, elements_ + size_, std::forward<Args>(args)...);
+    return elements_[size_++];
+  }
+
+  // @brief Construct an element in place before pos.
+  // @param pos Position to insert before (begin() <= pos <= end()).
+  // @param args Arguments forwarded to T's constructor.
+  // @return Iterator to the new element.
+  //
+  // The tail is shifted with a single memmove.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    return growAndEmplace(static_cast<size_type>(pos - cbegin()), std::forward<Args>(args)...);
+  }
+
+  // @brief Remove the last element.
+  // @throws std::out_of_range if vector is empty.
+  void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("HugeVector::pop_back: vector is empty");
+    }
+
+    --size_;
+    std::destroy_at(elements_ + size_);
+  }
+
+  // @brief Resize the vector to contain count elements.
+  // @param count New size.
+  //
+  // If count > size, new elements are value-initialized in place.
+  // If count < size, the vector is truncated.
+  void resize(size_type count) {
+    if (count <= size_) {
+      destroyN(alloc_, elements_ + count, size_ - count);
+      size_ = count;
+      return;
+    }
+
+    reserve(count);
+    uninitializedValueConstructN(alloc_, elements_ + size_, count - size_);
+    size_ = count;
+  }
+
+  // @brief Swap contents with another vector.
+  void swap(HugeVector& other) noexcept {
+    std::swap(elements_, other.elements_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(mappedBytes_, other.mappedBytes_);
+    std::swap(hugePages_, other.hugePages_);
+  }
+
+private:
+  static constexpr size_type HUGE_PAGE_SIZE = size_type{2} << 20; // x86-64/arm64 THP size
+  static constexpr size_type GROWTH_FACTOR = 2; // Capacity growth multiplier
+
+  std::allocator<T> alloc_; // Stateless; used only for element construction
+  T* elements_;             // Start of the mapping; [0, size_) holds live elements
+  size_type capacity_;      // Elements that fit in the mapping
+  size_type size_;          // Number of elements in the vector
+  size_type mappedBytes_;   // Length of the mapping in bytes
+  bool hugePages_;          // Advise MADV_HUGEPAGE on every mapping
+
+  // @brief Round a byte count up to the mapping granularity.
+  size_type roundToMapping(size_type bytes) const noexcept {
+    static const size_type pageSize = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    const size_type unit = hugePages_ ? HUGE_PAGE_SIZE : pageSize;
+    return (bytes + unit - 1) / unit * unit;
+  }
+
+  // @brief Map bytes of anonymous memory, on a huge page boundary if hugePages_.
+  // @return The mapping, or MAP_FAILED.
+  //
+  // mmap only guarantees page alignment, so for huge pages an extra HUGE_PAGE_SIZE is
+  // mapped and the misaligned head and tail are unmapped again.
+  void* mapAnonymous(size_type bytes) const noexcept {
+    const size_type slack = hugePages_ ? HUGE_PAGE_SIZE : 0;
+    void* raw = ::mmap(nullptr, bytes + slack, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED || slack == 0) {
+      return raw;
+    }
+
+    const auto start = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    const size_type head = aligned - start;
+    if (head > 0) {
+      ::munmap(raw, head);
+    }
+    if (head < slack) {
+      ::munmap(reinterpret_cast<void*>(aligned + bytes), slack - head);
+    }
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  // @brief Map, grow or shrink the storage to hold at least newCapacity elements.
+  // @throws std::bad_alloc if the kernel refuses the request.
+  //
+  // Existing elements keep their contents; mremap may move them to a new address.
+  void remap(size_type newCapacity) {
+    if (newCapacity > static_cast<size_type>(std::numeric_limits<difference_type>::max()) /
+                          sizeof(T)) {
+      throw std::bad_alloc();
+    }
+
+    const size_type newBytes = roundToMapping(newCapacity * sizeof(T));
+    void* mapping = MAP_FAILED;
+
+    if (elements_ == nullptr) {
+      mapping = mapAnonymous(newBytes);
+    } else if (!hugePages_) {
+      mapping = ::mremap(elements_, mappedBytes_, newBytes, MREMAP_MAYMOVE);
+    } else {
+      // In place the start stays aligned; otherwise move the pages onto an aligned range
+      mapping = ::mremap(elements_, mappedBytes_, newBytes, 0);
+      if (mapping == MAP_FAILED) {
+        void* target = mapAnonymous(newBytes);
+        if (target != MAP_FAILED) {
+          mapping = ::mremap(elements_, mappedBytes_, newBytes, MREMAP_MAYMOVE | MREMAP_FIXED,
+                             target);
+          if (mapping == MAP_FAILED) {
+            ::munmap(target, newBytes);
+          }
+        }
+      }
+    }
+
+    if (mapping == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    recordAllocation(newBytes);
+    recordCapacity(newBytes / sizeof(T));
+    if (elements_ != nullptr) {
+      recordReallocation();
+    }
+
+#if defined(MADV_HUGEPAGE)
+    if (hugePages_) {
+      ::madvise(mapping, newBytes, MADV_HUGEPAGE); // Advisory; failure is harmless
+    }
+#endif
+
+    elements_ = static_cast<T*>(mapping);
+    mappedBytes_ = newBytes;
+    capacity_ = newBytes / sizeof(T);
+  }
+
+  // @brief Destroy all elements and unmap the storage.
+  void release() noexcept {
+    destroyN(alloc_, elements_, size_);
+    if (elements_ != nullptr) {
+      ::munmap(elements_, mappedBytes_);
+    }
+    elements_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+    mappedBytes_ = 0;
+  }
+
+  // @brief Construct a new element at index, growing the mapping if needed.
+  // @return Pointer to the new element.
+  //
+  // The value is built in side storage first because args may refer to elements that
+  // the remap or the shift is about to move; it is then relocated into place.
+  template <typename... Args>
+  T* growAndEmplace(size_type index, Args&&... args) {
+    alignas(T) unsigned char raw[sizeof(T)];
+    T* item = reinterpret_cast<T*>(raw);
+    std::allocator_traits<std::allocator<T>>::construct(alloc_, item, std::forward<Args>(args)...);
+
+    if (size_ == capacity_) {
+      try {
+        remap(capacity_ == 0 ? 1 : capacity_ * GROWTH_FACTOR);
+      } catch (...) {
+        std::destroy_at(item);
+        throw;
+      }
+    }
+
+    relocateWithin(alloc_, elements_ + index, size_ - index, elements_ + index + 1);
+    uninitializedRelocate(alloc_, item, 1, elements_ + index);
+    ++size_;
+
+    return elements_ + index;
+  }
+};
+
+#endif // defined(__linux__)
+
+#endif // HUGEVECTOR_H
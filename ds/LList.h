@@ -1,14 +1,18 @@
 #ifndef LLIST_H
 #define LLIST_H
 
+#include "ContainerStats.h"
 #include "Link.h"
 #include "List.h"
 
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 // @brief Linked list implementation with header node.
 // @tparam E The type of elements stored in the list.
+// @tparam Allocator Allocator for E; rebound internally to allocate Link<E> nodes.
 //
 // Implements the List interface using a singly-linked list with a header node.
 // The header node simplifies boundary conditions. The cursor points to the node
@@ -19,17 +23,49 @@
 // - remove: O(1)
 // - moveToPos/currPos: O(n)
 // - prev: O(n) (requires traversal from head)
-template <typename E>
-class LList : public List<E> {
+//
+// With DS_CONTAINER_STATS defined, stats() reports node allocations (the header
+// included) and elements copied or moved in from other lists.
+template <typename E, typename Allocator = std::allocator<E>>
+class LList : public List<E>, private ContainerStatsRecorder {
 private:
-  Link<E>* head_;    // Header node (dummy node before first element)
-  Link<E>* tail_;    // Pointer to last node
-  Link<E>* curr_;    // Points to node before current element
-  std::size_t size_; // Number of elements in the list
+  using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Link<E>>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+  static_assert(std::is_same_v<typename NodeTraits::pointer, Link<E>*>,
+                "LList: Allocator must use raw pointers");
+
+  NodeAllocator alloc_; // Allocator for list nodes
+  Link<E>* head_;       // Header node (dummy node before first element)
+  Link<E>* tail_;       // Pointer to last node
+  Link<E>* curr_;       // Points to node before current element
+  std::size_t size_;    // Number of elements in the list
+
+  // @brief Allocate and construct a node.
+  // @param args Arguments forwarded to the Link<E> constructor.
+  // @return Pointer to the new node.
+  template <typename... Args>
+  Link<E>* createNode(Args&&... args) {
+    Link<E>* node = NodeTraits::allocate(alloc_, 1);
+    try {
+      NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      NodeTraits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    recordAllocation(sizeof(Link<E>));
+    return node;
+  }
+
+  // @brief Destroy a node and return its memory to the allocator.
+  void destroyNode(Link<E>* node) noexcept {
+    NodeTraits::destroy(alloc_, node);
+    NodeTraits::deallocate(alloc_, node, 1);
+  }
 
   // @brief Initialize an empty list with header node.
   void init() {
-    head_ = new Link<E>();
+    head_ = createNode();
     tail_ = curr_ = head_;
     size_ = 0;
   }
@@ -39,7 +75,7 @@ private:
     Link<E>* current = head_;
     while (current != nullptr) {
       Link<E>* next = current->next;
-      delete current;
+      destroyNode(current);
       current = next;
     }
     head_ = tail_ = curr_ = nullptr;
@@ -51,37 +87,132 @@ private:
   void copyFrom(const LList& other) {
     init();
 
-    // Copy all elements
+    try {
+      // Copy all elements
+      Link<E>* otherNode = other.head_->next;
+      while (otherNode != nullptr) {
+        append(otherNode->element);
+        otherNode = otherNode->next;
+      }
+    } catch (...) {
+      removeAll();
+      throw;
+    }
+    recordCopies(size_);
+
+    // Set cursor to same relative position
+    std::size_t otherPos = other.currPos();
+    moveToPos(otherPos);
+  }
+
+  // @brief Move the elements of another list into this (empty) list node by node.
+  // @param other The list to move from; left empty.
+  //
+  // Used when the allocators differ and the nodes cannot be adopted.
+  void moveElementsFrom(LList& other) {
+    std::size_t otherPos = other.currPos();
+
     Link<E>* otherNode = other.head_->next;
     while (otherNode != nullptr) {
-      append(otherNode->element);
+      tail_->next = createNode(std::move(otherNode->element), nullptr);
+      tail_ = tail_->next;
+      ++size_;
       otherNode = otherNode->next;
     }
+    recordMoves(size_);
+    recordCapacity(size_);
 
-    // Set cursor to same relative position
-    std::size_t otherPos = other.currPos();
     moveToPos(otherPos);
+    other.clear();
+  }
+
+  // @brief Allocate a chain of nodes holding copies of [first, last).
+  // @param first Start of the elements to copy (first != last).
+  // @param last One past the last element to copy.
+  // @param chainTail Set to the last node of the chain, whose next is nullptr.
+  // @return The first node of the chain; nothing is allocated if a copy throws.
+  Link<E>* createChain(const E* first, const E* last, Link<E>*& chainTail) {
+    Link<E>* chainHead = createNode(*first, nullptr);
+    chainTail = chainHead;
+    try {
+      for (++first; first != last; ++first) {
+        chainTail->next = createNode(*first, nullptr);
+        chainTail = chainTail->next;
+      }
+    } catch (...) {
+      while (chainHead != nullptr) {
+        Link<E>* next = chainHead->next;
+        destroyNode(chainHead);
+        chainHead = next;
+      }
+      throw;
+    }
+    return chainHead;
+  }
+
+  // @brief Take ownership of other's nodes, leaving other without a header.
+  void adoptNodes(LList& other) noexcept {
+    head_ = other.head_;
+    tail_ = other.tail_;
+    curr_ = other.curr_;
+    size_ = other.size_;
+
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.curr_ = nullptr;
+    other.size_ = 0;
   }
 
 public:
+  using allocator_type = Allocator;
+
+  // @brief Allocation statistics of this list (all zero unless DS_CONTAINER_STATS).
+  using ContainerStatsRecorder::stats;
+
   // @brief Construct an empty linked list.
-  LList() {
+  LList() : LList(Allocator()) {
+  }
+
+  // @brief Construct an empty linked list using the given allocator.
+  // @param alloc Allocator instance to use (rebound to the node type).
+  explicit LList(const Allocator& alloc) : alloc_{alloc} {
     init();
   }
 
   // @brief Copy constructor - performs deep copy.
   // @param other The list to copy from.
-  LList(const LList& other) {
+  //
+  // The allocator is obtained through select_on_container_copy_construction.
+  LList(const LList& other)
+      : ContainerStatsRecorder(),
+        alloc_{NodeTraits::select_on_container_copy_construction(other.alloc_)} {
+    copyFrom(other);
+  }
+
+  // @brief Copy constructor with an explicit allocator - performs deep copy.
+  // @param other The list to copy from.
+  // @param alloc Allocator instance to use.
+  LList(const LList& other, const Allocator& alloc) : alloc_{alloc} {
     copyFrom(other);
   }
 
   // @brief Copy assignment operator - performs deep copy.
   // @param other The list to copy from.
   // @return Reference to this list.
+  //
+  // Adopts other's allocator if propagate_on_container_copy_assignment is true. The copy
+  // is built aside first, so a throwing element copy leaves this list unchanged.
   LList& operator=(const LList& other) {
     if (this != &other) {
+      constexpr bool propagate = NodeTraits::propagate_on_container_copy_assignment::value;
+      LList temp(other, Allocator(propagate ? other.alloc_ : alloc_));
+
       removeAll();
-      copyFrom(other);
+      if constexpr (propagate) {
+        alloc_ = other.alloc_;
+      }
+      adoptNodes(temp);
+      absorbStats(temp);
     }
     return *this;
   }
@@ -89,7 +220,8 @@ public:
   // @brief Move constructor.
   // @param other The list to move from.
   LList(LList&& other) noexcept
-      : head_{other.head_}, tail_{other.tail_}, curr_{other.curr_}, size_{other.size_} {
+      : alloc_{std::move(other.alloc_)}, head_{other.head_}, tail_{other.tail_},
+        curr_{other.curr_}, size_{other.size_} {
     other.head_ = nullptr;
     other.tail_ = nullptr;
     other.curr_ = nullptr;
@@ -99,19 +231,24 @@ public:
   // @brief Move assignment operator.
   // @param other The list to move from.
   // @return Reference to this list.
-  LList& operator=(LList&& other) noexcept {
+  //
+  // Adopts other's nodes when the allocator propagates or compares equal. Otherwise
+  // the elements are moved into nodes from this list's allocator.
+  LList& operator=(LList&& other) noexcept(
+      NodeTraits::propagate_on_container_move_assignment::value ||
+      NodeTraits::is_always_equal::value) {
     if (this != &other) {
-      removeAll();
-
-      head_ = other.head_;
-      tail_ = other.tail_;
-      curr_ = other.curr_;
-      size_ = other.size_;
-
-      other.head_ = nullptr;
-      other.tail_ = nullptr;
-      other.curr_ = nullptr;
-      other.size_ = 0;
+      if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+        removeAll();
+        alloc_ = std::move(other.alloc_);
+        adoptNodes(other);
+      } else if (alloc_ == other.alloc_) {
+        removeAll();
+        adoptNodes(other);
+      } else {
+        clear();
+        moveElementsFrom(other);
+      }
     }
     return *this;
   }
@@ -133,11 +270,12 @@ public:
   // The new element becomes the current element.
   // Time complexity: O(1).
   void insert(const E& item) override {
-    curr_->next = new Link<E>(item, curr_->next);
+    curr_->next = createNode(item, curr_->next);
     if (tail_ == curr_) {
       tail_ = curr_->next;
     }
     ++size_;
+    recordCapacity(size_);
   }
 
   // @brief Append an element at the end of the list.
@@ -145,9 +283,10 @@ public:
   //
   // Time complexity: O(1).
   void append(const E& item) override {
-    tail_->next = new Link<E>(item, nullptr);
+    tail_->next = createNode(item, nullptr);
     tail_ = tail_->next;
     ++size_;
+    recordCapacity(size_);
   }
 
   // @brief Remove and return the current element.
@@ -170,11 +309,83 @@ public:
     }
 
     curr_->next = curr_->next->next;
-    delete temp;
+    destroyNode(temp);
     --size_;
     return item;
   }
 
+  // @brief Insert the elements of [first, last) at the current position, in order.
+  // @param first Start of the elements to insert.
+  // @param last One past the last element to insert.
+  //
+  // The chain of new nodes is built first and linked in with one splice; the first
+  // inserted element becomes the current element.
+  // Time complexity: O(k) for k new elements.
+  void insertRange(const E* first, const E* last) override {
+    if (first == last) {
+      return;
+    }
+
+    Link<E>* chainTail = nullptr;
+    Link<E>* chainHead = createChain(first, last, chainTail);
+    chainTail->next = curr_->next;
+    curr_->next = chainHead;
+    if (tail_ == curr_) {
+      tail_ = chainTail;
+    }
+    size_ += static_cast<std::size_t>(last - first);
+    recordCapacity(size_);
+  }
+
+  // @brief Append the elements of [first, last) at the end of the list, in order.
+  // @param first Start of the elements to append.
+  // @param last One past the last element to append.
+  //
+  // Time complexity: O(k) for k new elements.
+  void appendRange(const E* first, const E* last) override {
+    if (first == last) {
+      return;
+    }
+
+    Link<E>* chainTail = nullptr;
+    tail_->next = createChain(first, last, chainTail);
+    tail_ = chainTail;
+    size_ += static_cast<std::size_t>(last - first);
+    recordCapacity(size_);
+  }
+
+  // @brief Remove count elements starting at the current element.
+  // @param count The number of elements to remove.
+  // @throws std::out_of_range if fewer than count elements are at or after the current
+  //         position; the list is left unchanged.
+  //
+  // Time complexity: O(k) for k removed elements.
+  void removeRange(std::size_t count) override {
+    Link<E>* last = curr_; // Last node to remove
+    for (std::size_t i = 0; i < count; ++i) {
+      if (last->next == nullptr) {
+        throw std::out_of_range("Count out of range");
+      }
+      last = last->next;
+    }
+    if (count == 0) {
+      return;
+    }
+
+    Link<E>* node = curr_->next;
+    curr_->next = last->next;
+    if (tail_ == last) {
+      tail_ = curr_;
+    }
+    last->next = nullptr;
+    while (node != nullptr) {
+      Link<E>* next = node->next;
+      destroyNode(node);
+      node = next;
+    }
+    size_ -= count;
+  }
+
   // @brief Move cursor to the start of the list.
   //
   // Time complexity: O(1).
@@ -216,6 +427,11 @@ public:
     }
   }
 
+  // @brief Get a copy of the allocator.
+  [[nodiscard]] allocator_type get_allocator() const noexcept {
+    return allocator_type(alloc_);
+  }
+
   // @brief Get the number of elements in the list.
   // @return The number of elements.
   [[nodiscard]] std::size_t length() const noexcept override {
@@ -263,6 +479,17 @@ public:
     }
     return curr_->next->element;
   }
+
+  // @brief Visit every element in order without moving the cursor.
+  // @param fn Callable invoked with a const reference to each element.
+  //
+  // Time complexity: O(n).
+  template <typename Fn>
+  void forEach(Fn&& fn) const {
+    for (const Link<E>* node = head_->next; node != nullptr; node = node->next) {
+      fn(node->element);
+    }
+  }
 };
 
 #endif // LLIST_H
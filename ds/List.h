@@ -2,6 +2,7 @@
 #define LIST_H
 
 #include <cstddef>
+#include <stdexcept>
 
 // @brief Abstract base class for list ADT.
 // @tparam E The type of elements stored in the list.
@@ -40,6 +41,40 @@ public:
   // @throws std::out_of_range if no element is at current position.
   virtual E remove() = 0;
 
+  // @brief Insert the elements of [first, last) at the current location, in order.
+  // @param first Start of the elements to be inserted.
+  // @param last One past the last element to be inserted.
+  //
+  // The first inserted element becomes the current element. The default inserts one
+  // element at a time; implementations override it to make room once per batch.
+  virtual void insertRange(const E* first, const E* last) {
+    while (last != first) {
+      insert(*--last);
+    }
+  }
+
+  // @brief Append the elements of [first, last) at the end of the list, in order.
+  // @param first Start of the elements to be appended.
+  // @param last One past the last element to be appended.
+  virtual void appendRange(const E* first, const E* last) {
+    for (; first != last; ++first) {
+      append(*first);
+    }
+  }
+
+  // @brief Remove count elements starting at the current element.
+  // @param count The number of elements to remove.
+  // @throws std::out_of_range if fewer than count elements are at or after the current
+  //         position; the list is left unchanged.
+  virtual void removeRange(std::size_t count) {
+    if (count > length() - currPos()) {
+      throw std::out_of_range("Count out of range");
+    }
+    for (; count > 0; --count) {
+      remove();
+    }
+  }
+
   // @brief Set the current position to the start of the list.
   virtual void moveToStart() noexcept = 0;
 
@@ -0,0 +1,480 @@
+#ifndef MAPPEDVECTOR_H
+#define MAPPEDVECTOR_H
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+// @brief How MappedVector maps its file.
+enum class MapMode {
+  ReadOnly, // PROT_READ; every modifier throws std::logic_error
+  ReadWrite // Created if missing; appends grow the file
+};
+
+// @brief Persistent vector stored in a file and accessed through mmap (POSIX only).
+// @tparam T The type of elements stored; must be trivially copyable.
+//
+// The file is a 64-byte header followed by the raw elements:
+//
+//   offset  0  char[8]   magic "DSAMVEC"
+//   offset  8  uint32_t  format version
+//   offset 12  uint32_t  endianness tag (0x01020304 as written by the creating host)
+//   offset 16  uint64_t  sizeof(T)
+//   offset 24  uint64_t  alignof(T)
+//   offset 32  uint64_t  number of elements
+//   offset 40  reserved (zero)
+//
+// Opening validates the header and maps the file MAP_SHARED; nothing is parsed or
+// copied, so opening a multi-gigabyte table costs a few system calls and the pages
+// are faulted in lazily as they are touched. Writes go straight to the page cache; the
+// kernel flushes them to disk in the background, or sync() forces it.
+//
+// Appends grow the file geometrically (whole pages); the element count lives in the
+// mapped header, so the file is always self-describing. As with Vector, growth may
+// move the mapping and invalidates pointers. Concurrent writers of one file are not
+// supported. A moved-from vector is closed: it reads as empty, and every modifier throws
+// std::logic_error.
+template <typename T>
+class MappedVector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MappedVector: elements are stored as raw bytes, T must be trivially copyable");
+  static_assert(alignof(T) <= 64, "MappedVector: alignment above the header size");
+
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianTag;
+    std::uint64_t elementSize;
+    std::uint64_t elementAlign;
+    std::uint64_t size;
+    std::uint64_t reserved[3];
+  };
+
+  static_assert(sizeof(Header) == 64, "MappedVector: header layout changed");
+
+public:
+  // Type definitions
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+  // @brief Open (or, in ReadWrite mode, create) a mapped vector file.
+  // @param path File to map.
+  // @param mode ReadOnly or ReadWrite.
+  // @throws std::system_error if the file cannot be opened, resized or mapped.
+  // @throws std::runtime_error if the file is not a MappedVector<T> of this format.
+  explicit MappedVector(const std::string& path, MapMode mode = MapMode::ReadWrite)
+      : fd_{-1}, mode_{mode}, header_{nullptr}, mappedBytes_{0}, capacity_{0} {
+    const int flags = mode == MapMode::ReadOnly ? O_RDONLY : O_RDWR | O_CREAT;
+    fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "MappedVector: open " + path);
+    }
+
+    try {
+      struct stat info;
+      if (::fstat(fd_, &info) != 0) {
+        throw std::system_error(errno, std::generic_category(), "MappedVector: fstat");
+      }
+
+      const auto fileBytes = static_cast<size_type>(info.st_size);
+      if (fileBytes == 0 && mode == MapMode::ReadWrite) {
+        initialize();
+      } else {
+        map(fileBytes);
+        validate(path);
+      }
+    } catch (...) {
+      close();
+      throw;
+    }
+  }
+
+  MappedVector(const MappedVector&) = delete;
+  MappedVector& operator=(const MappedVector&) = delete;
+
+  // @brief Move constructor - takes over the file and mapping.
+  // @param other The vector to move from; left closed.
+  MappedVector(MappedVector&& other) noexcept
+      : fd_{std::exchange(other.fd_, -1)}, mode_{other.mode_},
+        header_{std::exchange(other.header_, nullptr)},
+        mappedBytes_{std::exchange(other.mappedBytes_, 0)},
+        capacity_{std::exchange(other.capacity_, 0)} {
+  }
+
+  // @brief Move assignment operator - closes this file and takes over other's.
+  // @param other The vector to move from; left closed.
+  // @return Reference to this vector.
+  MappedVector& operator=(MappedVector&& other) noexcept {
+    if (this != &other) {
+      close();
+      fd_ = std::exchange(other.fd_, -1);
+      mode_ = other.mode_;
+      header_ = std::exchange(other.header_, nullptr);
+      mappedBytes_ = std::exchange(other.mappedBytes_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+
+    return *this;
+  }
+
+  // @brief Destructor - unmaps and closes the file. Contents persist.
+  ~MappedVector() {
+    close();
+  }
+
+
+  // Element access
+
+  // @brief Access element at index (no bounds checking).
+  reference operator[](size_type index) noexcept {
+    return data()[index];
+  }
+
+  // @brief Access element at index (no bounds checking).
+  const_reference operator[](size_type index) const noexcept {
+    return data()[index];
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @throws std::out_of_range if index >= size.
+  reference at(size_type index) {
+    if (index >= size()) {
+      throw std::out_of_range("MappedVector::at: index out of range");
+    }
+
+    return data()[index];
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @throws std::out_of_range if index >= size.
+  const_reference at(size_type index) const {
+    if (index >= size()) {
+      throw std::out_of_range("MappedVector::at: index out of range");
+    }
+
+    return data()[index];
+  }
+
+  // @brief Access the first element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference front() const {
+    if (empty()) {
+      throw std::out_of_range("MappedVector::front: vector is empty");
+    }
+
+    return data()[0];
+  }
+
+  // @brief Access the last element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference back() const {
+    if (empty()) {
+      throw std::out_of_range("MappedVector::back: vector is empty");
+    }
+
+    return data()[size() - 1];
+  }
+
+  // @brief Get pointer to the mapped elements. Writing through it in ReadOnly mode
+  //        raises SIGSEGV.
+  pointer data() noexcept {
+    return header_ != nullptr ? reinterpret_cast<T*>(header_ + 1) : nullptr;
+  }
+
+  // @brief Get pointer to the mapped elements.
+  const_pointer data() const noexcept {
+    return header_ != nullptr ? reinterpret_cast<const T*>(header_ + 1) : nullptr;
+  }
+
+  // @brief Get iterator to the beginning.
+  iterator begin() noexcept {
+    return data();
+  }
+
+  // @brief Get iterator to the end.
+  iterator end() noexcept {
+    return data() + size();
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator begin() const noexcept {
+    return data();
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator end() const noexcept {
+    return data() + size();
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator cbegin() const noexcept {
+    return data();
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator cend() const noexcept {
+    return data() + size();
+  }
+
+
+  // Capacity
+
+  // @brief Check if the vector is empty.
+  [[nodiscard]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  // @brief Number of elements (read from the mapped header).
+  [[nodiscard]] size_type size() const noexcept {
+    return header_ != nullptr ? static_cast<size_type>(header_->size) : 0;
+  }
+
+  // @brief Elements that fit in the file without growing it.
+  [[nodiscard]] size_type capacity() const noexcept {
+    return capacity_;
+  }
+
+  // @brief Size of the mapping (and the file) in bytes.
+  [[nodiscard]] size_type mappedBytes() const noexcept {
+    return mappedBytes_;
+  }
+
+  // @brief Check whether the file is mapped read-only.
+  [[nodiscard]] bool readOnly() const noexcept {
+    return mode_ == MapMode::ReadOnly;
+  }
+
+  // @brief Grow the file so that at least newCapacity elements fit.
+  // @throws std::logic_error if mapped read-only.
+  void reserve(size_type newCapacity) {
+    requireWritable();
+    if (newCapacity > capacity_) {
+      resizeFile(newCapacity);
+    }
+  }
+
+  // @brief Truncate the file to the whole pages needed by the current elements.
+  // @throws std::logic_error if mapped read-only.
+  void shrink_to_fit() {
+    requireWritable();
+    if (capacity_ > size()) {
+      resizeFile(size());
+    }
+  }
+
+
+  // Modifiers
+
+  // @brief Remove all elements. The file keeps its length.
+  // @throws std::logic_error if mapped read-only.
+  void clear() {
+    requireWritable();
+    header_->size = 0;
+  }
+
+  // @brief Append an element, growing the file if needed.
+  // @param item The element to add (may refer to an element of this vector).
+  // @throws std::logic_error if mapped read-only.
+  //
+  // Time complexity: O(1) amortized.
+  void push_back(const T& item) {
+    emplace_back(item);
+  }
+
+  // @brief Construct an element at the end, growing the file if needed.
+  // @param args Arguments forwarded to T's constructor.
+  // @return Reference to the new element.
+  // @throws std::logic_error if mapped read-only.
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    requireWritable();
+
+    // Build first: args may refer to an element, and growing may move the mapping
+    T item(std::forward<Args>(args)...);
+    const size_type count = size();
+    if (count == capacity_) {
+      resizeFile(count + 1 > capacity_ * GROWTH_FACTOR ? count + 1 : capacity_ * GROWTH_FACTOR);
+    }
+
+    T* slot = ::new (static_cast<void*>(data() + count)) T(item);
+    header_->size = count + 1;
+    return *slot;
+  }
+
+  // @brief Remove the last element.
+  // @throws std::out_of_range if vector is empty.
+  // @throws std::logic_error if mapped read-only.
+  void pop_back() {
+    requireWritable();
+    if (empty()) {
+      throw std::out_of_range("MappedVector::pop_back: vector is empty");
+    }
+
+    --header_->size;
+  }
+
+  // @brief Resize to count elements; new elements are value-initialized.
+  // @param count New size.
+  // @throws std::logic_error if mapped read-only.
+  void resize(size_type count) {
+    requireWritable();
+    if (count > capacity_) {
+      resizeFile(count);
+    }
+
+    const size_type oldSize = size();
+    for (size_type i = oldSize; i < count; ++i) {
+      ::new (static_cast<void*>(data() + i)) T();
+    }
+    header_->size = count;
+  }
+
+  // @brief Flush modified pages to the file and wait for the write to complete.
+  // @throws std::system_error if msync fails.
+  void sync() {
+    if (header_ != nullptr && mode_ == MapMode::ReadWrite &&
+        ::msync(header_, mappedBytes_, MS_SYNC) != 0) {
+      throw std::system_error(errno, std::generic_category(), "MappedVector: msync");
+    }
+  }
+
+private:
+  static constexpr char MAGIC[8] = "DSAMVEC";
+  static constexpr std::uint32_t ENDIAN_TAG = 0x01020304;
+  static constexpr size_type GROWTH_FACTOR = 2; // Capacity growth multiplier
+
+  int fd_;                // Open file descriptor, or -1 once closed
+  MapMode mode_;          // Protection of the mapping
+  Header* header_;        // Start of the mapping; elements follow the header
+  size_type mappedBytes_; // Length of the mapping, equal to the file length
+  size_type capacity_;    // Elements that fit after the header
+
+  static size_type pageSize() noexcept {
+    static const size_type size = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  void requireWritable() const {
+    if (header_ == nullptr) {
+      throw std::logic_error("MappedVector: vector is closed (moved from)");
+    }
+    if (mode_ == MapMode::ReadOnly) {
+      throw std::logic_error("MappedVector: file is mapped read-only");
+    }
+  }
+
+  // @brief Write a fresh header into an empty file.
+  void initialize() {
+    resizeFile(0);
+
+    std::memcpy(header_->magic, MAGIC, sizeof(MAGIC));
+    header_->version = FORMAT_VERSION;
+    header_->endianTag = ENDIAN_TAG;
+    header_->elementSize = sizeof(T);
+    header_->elementAlign = alignof(T);
+    header_->size = 0;
+  }
+
+  // @brief Reject files written by another format, element type or byte order.
+  void validate(const std::string& path) const {
+    const auto fail = [&path](const char* reason) {
+      throw std::runtime_error("MappedVector: " + path + ": " + reason);
+    };
+
+    if (mappedBytes_ < sizeof(Header) ||
+        std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0) {
+      fail("not a MappedVector file");
+    }
+    if (header_->version != FORMAT_VERSION) {
+      fail("unsupported format version");
+    }
+    if (header_->endianTag != ENDIAN_TAG) {
+      fail("written with a different byte order");
+    }
+    if (header_->elementSize != sizeof(T) || header_->elementAlign != alignof(T)) {
+      fail("element type does not match");
+    }
+    if (header_->size > capacity_) {
+      fail("file is truncated");
+    }
+  }
+
+  // @brief Map fileBytes of the file, replacing any current mapping.
+  void map(size_type fileBytes) {
+    void* mapping = nullptr;
+    if (fileBytes > 0) {
+      const int protection = mode_ == MapMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+      mapping = ::mmap(nullptr, fileBytes, protection, MAP_SHARED, fd_, 0);
+      if (mapping == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "MappedVector: mmap");
+      }
+    }
+
+    // The old mapping goes only once the new one exists, so failure changes nothing
+    if (header_ != nullptr) {
+      ::munmap(header_, mappedBytes_);
+    }
+
+    header_ = static_cast<Header*>(mapping);
+    mappedBytes_ = fileBytes;
+    capacity_ = fileBytes >= sizeof(Header) ? (fileBytes - sizeof(Header)) / sizeof(T) : 0;
+  }
+
+  // @brief Set the file length to hold newCapacity elements (whole pages) and remap.
+  // @throws std::system_error if the file cannot be resized or mapped.
+  void resizeFile(size_type newCapacity) {
+    if (newCapacity > (std::numeric_limits<size_type>::max() / 2 - sizeof(Header)) / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+
+    const size_type bytes = sizeof(Header) + newCapacity * sizeof(T);
+    const size_type fileBytes = (bytes + pageSize() - 1) / pageSize() * pageSize();
+
+    if (::ftruncate(fd_, static_cast<off_t>(fileBytes)) != 0) {
+      throw std::system_error(errno, std::generic_category(), "MappedVector: ftruncate");
+    }
+
+    map(fileBytes);
+  }
+
+  // @brief Unmap and close, leaving the object empty.
+  void close() noexcept {
+    if (header_ != nullptr) {
+      ::munmap(header_, mappedBytes_);
+      header_ = nullptr;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+    mappedBytes_ = 0;
+    capacity_ = 0;
+  }
+};
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // MAPPEDVECTOR_H
@@ -0,0 +1,476 @@
+#ifndef PACKEDINTVECTOR_H
+#define PACKEDINTVECTOR_H
+
+#include "../al/SimdKernels.h"
+#include "Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// @brief How PackedIntVector encodes each block of values.
+enum class IntPacking {
+  FixedWidth,       // Every value in the same number of bits, chosen at construction
+  FrameOfReference, // Per block: the minimum, then each value's offset from it in as few
+                    // bits as the block's largest offset needs
+  DeltaVarint,      // Per block: the first value, then the differences to the previous
+                    // value as LEB128 varints; values must be non-decreasing
+};
+
+// @brief Append-only vector of unsigned integers stored compressed, in blocks of 128.
+// @tparam T The value type: std::uint32_t or std::uint64_t.
+//
+// Values are appended to an uncompressed tail; every 128th append encodes the tail as a
+// block. FixedWidth and FrameOfReference blocks are bit-packed into 64-bit words, so any
+// value is read in O(1) with a shift and a mask. DeltaVarint blocks suit sorted ID lists
+// (a gap under 128 takes one byte) but are read sequentially: operator[] decodes from the
+// start of the block, and iteration decodes one varint per step.
+//
+// decodeBlock() and decode() unpack whole blocks with simdUnpack32 (for uint32_t values).
+// Bit-packed data is followed by a zero word so the vector loads may read past a block.
+template <typename T>
+class PackedIntVector {
+  static_assert(std::is_same_v<T, std::uint32_t> || std::is_same_v<T, std::uint64_t>,
+                "PackedIntVector: T must be std::uint32_t or std::uint64_t");
+
+public:
+  // Type definitions
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static constexpr size_type BLOCK_SIZE = 128;
+  static constexpr unsigned VALUE_BITS = std::numeric_limits<T>::digits;
+
+  // @brief Forward iterator that decodes values one at a time.
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = T;
+    using pointer = void;
+
+    const_iterator() noexcept : owner_{nullptr}, index_{0}, cursor_{nullptr}, value_{0} {
+    }
+
+    const_iterator(const PackedIntVector* owner, size_type index) noexcept
+        : owner_{owner}, index_{index}, cursor_{nullptr}, value_{0} {
+      seek();
+    }
+
+    T operator*() const noexcept {
+      return value_;
+    }
+
+    const_iterator& operator++() noexcept {
+      ++index_;
+      if (cursor_ != nullptr && index_ % BLOCK_SIZE != 0) {
+        value_ += readVarint(cursor_);
+      } else {
+        seek();
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept {
+      return a.index_ == b.index_;
+    }
+
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) noexcept {
+      return a.index_ != b.index_;
+    }
+
+  private:
+    const PackedIntVector* owner_;
+    size_type index_;
+    const std::uint8_t* cursor_; // Next varint, inside an encoded DeltaVarint block
+    T value_;
+
+    void seek() noexcept {
+      cursor_ = nullptr;
+      if (index_ >= owner_->size_) {
+        return;
+      }
+
+      const size_type block = index_ / BLOCK_SIZE;
+      if (owner_->packing_ != IntPacking::DeltaVarint || block == owner_->encodedBlocks()) {
+        value_ = (*owner_)[index_];
+        return;
+      }
+
+      value_ = owner_->blocks_[block].base;
+      cursor_ = owner_->bytes_.data() + owner_->blocks_[block].offset;
+      for (size_type slot = 0; slot < index_ % BLOCK_SIZE; ++slot) {
+        value_ += readVarint(cursor_);
+      }
+    }
+  };
+
+  // @brief Construct an empty vector.
+  // @param packing Encoding of the blocks.
+  // @param bitWidth Bits per value for IntPacking::FixedWidth (1 to the bits of T);
+  //        ignored by the other encodings.
+  // @throws std::invalid_argument if packing is FixedWidth and bitWidth is out of range.
+  explicit PackedIntVector(IntPacking packing = IntPacking::FrameOfReference,
+                           unsigned bitWidth = 0)
+      : packing_{packing}, width_{packing == IntPacking::FixedWidth ? bitWidth : 0},
+        size_{0}, last_{0} {
+    if (packing == IntPacking::FixedWidth && (bitWidth == 0 || bitWidth > VALUE_BITS)) {
+      throw std::invalid_argument("PackedIntVector: bit width out of range");
+    }
+  }
+
+
+  // @brief The encoding chosen at construction.
+  IntPacking packing() const noexcept {
+    return packing_;
+  }
+
+  // @brief Bits per value of a FixedWidth vector (0 for the other encodings).
+  unsigned bitWidth() const noexcept {
+    return width_;
+  }
+
+
+  // Element access
+
+  // @brief Read the value at index (no bounds checking).
+  //
+  // O(1), except within an encoded DeltaVarint block: O(index % BLOCK_SIZE).
+  T operator[](size_type index) const noexcept {
+    const size_type block = index / BLOCK_SIZE;
+    const size_type slot = index % BLOCK_SIZE;
+    if (block == encodedBlocks()) {
+      return tail_[slot];
+    }
+
+    switch (packing_) {
+    case IntPacking::FixedWidth:
+      return static_cast<T>(extractBits(words_.data() + block * blockWords(width_),
+                                        slot * width_, width_));
+    case IntPacking::FrameOfReference: {
+      const Block& header = blocks_[block];
+      return static_cast<T>(header.base + extractBits(words_.data() + header.offset,
+                                                      slot * header.width, header.width));
+    }
+    default: {
+      const Block& header = blocks_[block];
+      const std::uint8_t* cursor = bytes_.data() + header.offset;
+      T value = header.base;
+      for (size_type i = 0; i < slot; ++i) {
+        value += readVarint(cursor);
+      }
+      return value;
+    }
+    }
+  }
+
+  // @brief Read the value at index with bounds checking.
+  // @throws std::out_of_range if index >= size.
+  T at(size_type index) const {
+    if (index >= size_) {
+      throw std::out_of_range("PackedIntVector::at: index out of range");
+    }
+
+    return (*this)[index];
+  }
+
+  const_iterator begin() const noexcept {
+    return const_iterator(this, 0);
+  }
+
+  const_iterator end() const noexcept {
+    return const_iterator(this, size_);
+  }
+
+
+  // Capacity
+
+  // @brief Check if there are no values.
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // @brief Get the number of values.
+  [[nodiscard]] size_type size() const noexcept {
+    return size_;
+  }
+
+  // @brief Number of blocks, counting a partial last block.
+  size_type blockCount() const noexcept {
+    return (size_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  }
+
+  // @brief Heap memory held, in bytes (capacity, not just what is in use).
+  size_type memoryBytes() const noexcept {
+    return words_.capacity() * sizeof(std::uint64_t) + bytes_.capacity() +
+           blocks_.capacity() * sizeof(Block) + tail_.capacity() * sizeof(T);
+  }
+
+  // @brief Release unused capacity.
+  void shrink_to_fit() {
+    words_.shrink_to_fit();
+    bytes_.shrink_to_fit();
+    blocks_.shrink_to_fit();
+    tail_.shrink_to_fit();
+  }
+
+
+  // Modifiers
+
+  // @brief Append a value.
+  // @throws std::out_of_range if a FixedWidth value does not fit in bitWidth() bits.
+  // @throws std::invalid_argument if a DeltaVarint value is less than the previous one.
+  //
+  // Time complexity: O(1) amortized.
+  void push_back(T value) {
+    if (packing_ == IntPacking::FixedWidth && width_ < VALUE_BITS && (value >> width_) != 0) {
+      throw std::out_of_range("PackedIntVector::push_back: value does not fit in bit width");
+    }
+    if (packing_ == IntPacking::DeltaVarint && size_ > 0 && value < last_) {
+      throw std::invalid_argument("PackedIntVector::push_back: values must not decrease");
+    }
+
+    if (tail_.capacity() < BLOCK_SIZE) {
+      tail_.reserve(BLOCK_SIZE);
+    }
+    tail_.push_back(value);
+    if (tail_.size() == BLOCK_SIZE) {
+      try {
+        encodeTail();
+      } catch (...) {
+        tail_.pop_back();
+        throw;
+      }
+    }
+    last_ = value;
+    ++size_;
+  }
+
+  // @brief Append count values.
+  // @throws As push_back; values before the offending one stay appended.
+  void append(const T* values, size_type count) {
+    for (size_type i = 0; i < count; ++i) {
+      push_back(values[i]);
+    }
+  }
+
+  // @brief Remove all values; capacity is kept.
+  void clear() noexcept {
+    words_.clear();
+    bytes_.clear();
+    blocks_.clear();
+    tail_.clear();
+    size_ = 0;
+    last_ = 0;
+  }
+
+  // @brief Exchange contents with another vector.
+  void swap(PackedIntVector& other) noexcept {
+    using std::swap;
+    swap(packing_, other.packing_);
+    swap(width_, other.width_);
+    words_.swap(other.words_);
+    bytes_.swap(other.bytes_);
+    blocks_.swap(other.blocks_);
+    tail_.swap(other.tail_);
+    swap(size_, other.size_);
+    swap(last_, other.last_);
+  }
+
+
+  // Bulk decoding
+
+  // @brief Decode one block.
+  // @param block Block index, below blockCount().
+  // @param out Destination with room for BLOCK_SIZE values.
+  // @return Number of values written: BLOCK_SIZE, or fewer for the last block.
+  // @throws std::out_of_range if block >= blockCount().
+  size_type decodeBlock(size_type block, T* out) const {
+    if (block >= blockCount()) {
+      throw std::out_of_range("PackedIntVector::decodeBlock: block out of range");
+    }
+
+    if (block == encodedBlocks()) {
+      for (size_type i = 0; i < tail_.size(); ++i) {
+        out[i] = tail_[i];
+      }
+      return tail_.size();
+    }
+
+    switch (packing_) {
+    case IntPacking::FixedWidth:
+      unpack(words_.data() + block * blockWords(width_), width_, out);
+      break;
+    case IntPacking::FrameOfReference: {
+      const Block& header = blocks_[block];
+      unpack(words_.data() + header.offset, header.width, out);
+      for (size_type i = 0; i < BLOCK_SIZE; ++i) {
+        out[i] += header.base;
+      }
+      break;
+    }
+    default: {
+      const Block& header = blocks_[block];
+      const std::uint8_t* cursor = bytes_.data() + header.offset;
+      out[0] = header.base;
+      for (size_type i = 1; i < BLOCK_SIZE; ++i) {
+        out[i] = out[i - 1] + readVarint(cursor);
+      }
+      break;
+    }
+    }
+    return BLOCK_SIZE;
+  }
+
+  // @brief Decode every value, appending them to out a block at a time.
+  // @param out The vector to append to.
+  template <typename Allocator, typename Growth>
+  void decode(Vector<T, Allocator, Growth>& out) const {
+    const size_type offset = out.size();
+    out.resize_default_init(offset + size_);
+    for (size_type block = 0; block < blockCount(); ++block) {
+      decodeBlock(block, out.data() + offset + block * BLOCK_SIZE);
+    }
+  }
+
+private:
+  // Encoded block: FrameOfReference keeps base/offset/width, DeltaVarint base/offset
+  struct Block {
+    T base;             // Minimum (FrameOfReference) or first value (DeltaVarint)
+    std::size_t offset; // Start in words_ (FrameOfReference) or bytes_ (DeltaVarint)
+    unsigned width;     // Bits per packed offset (FrameOfReference)
+  };
+
+  IntPacking packing_;
+  unsigned width_;                 // FixedWidth bits per value
+  Vector<std::uint64_t> words_;    // Bit-packed blocks, then one zero word
+  Vector<std::uint8_t> bytes_;     // Varint-encoded blocks
+  Vector<Block> blocks_;           // Headers (not used by FixedWidth)
+  Vector<T> tail_;                 // Values after the last encoded block, uncompressed
+  size_type size_;
+  T last_;                         // Last value appended
+
+  size_type encodedBlocks() const noexcept {
+    return size_ / BLOCK_SIZE;
+  }
+
+  static size_type blockWords(unsigned width) noexcept {
+    return BLOCK_SIZE * width / 64;
+  }
+
+  static unsigned bitsNeeded(T value) noexcept {
+    unsigned bits = 0;
+    for (; value != 0; value >>= 1) {
+      ++bits;
+    }
+    return bits;
+  }
+
+  static T readVarint(const std::uint8_t*& cursor) noexcept {
+    T value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+      const std::uint8_t byte = *cursor++;
+      value |= static_cast<T>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+  }
+
+  void writeVarint(T value) {
+    for (; value >= 0x80; value >>= 7) {
+      bytes_.push_back(static_cast<std::uint8_t>(value | 0x80));
+    }
+    bytes_.push_back(static_cast<std::uint8_t>(value));
+  }
+
+  static void unpack(const std::uint64_t* words, unsigned width, T* out) noexcept {
+    if constexpr (std::is_same_v<T, std::uint32_t>) {
+      simdUnpack32(words, width, out, BLOCK_SIZE);
+    } else {
+      for (size_type i = 0; i < BLOCK_SIZE; ++i) {
+        out[i] = extractBits(words, i * width, width);
+      }
+    }
+  }
+
+  // Packs the tail (BLOCK_SIZE values) as a new block; on failure the encoded storage is
+  // restored and the tail kept
+  void encodeTail() {
+    const size_type wordsBefore = words_.size();
+    const size_type bytesBefore = bytes_.size();
+    try {
+      encodeTailBlock();
+    } catch (...) {
+      words_.resize(wordsBefore);
+      if (wordsBefore > 0) {
+        words_[wordsBefore - 1] = 0; // The trailing word was zero before packBlock
+      }
+      bytes_.resize(bytesBefore);
+      throw;
+    }
+    tail_.clear();
+  }
+
+  void encodeTailBlock() {
+    switch (packing_) {
+    case IntPacking::FixedWidth:
+      packBlock(0, width_);
+      break;
+    case IntPacking::FrameOfReference: {
+      T lo = tail_[0];
+      T hi = tail_[0];
+      for (size_type i = 1; i < BLOCK_SIZE; ++i) {
+        lo = tail_[i] < lo ? tail_[i] : lo;
+        hi = hi < tail_[i] ? tail_[i] : hi;
+      }
+      const unsigned width = bitsNeeded(static_cast<T>(hi - lo));
+      const size_type offset = packBlock(lo, width);
+      blocks_.push_back(Block{lo, offset, width});
+      break;
+    }
+    default: {
+      const size_type offset = bytes_.size();
+      for (size_type i = 1; i < BLOCK_SIZE; ++i) {
+        writeVarint(static_cast<T>(tail_[i] - tail_[i - 1]));
+      }
+      blocks_.push_back(Block{tail_[0], offset, 0});
+      break;
+    }
+    }
+  }
+
+  // Writes tail_[i] - base in width bits each over the trailing zero word and the words
+  // after it, then appends a new zero word; returns the block's first word
+  size_type packBlock(T base, unsigned width) {
+    if (words_.empty()) {
+      words_.push_back(0);
+    }
+    const size_type offset = words_.size() - 1;
+    words_.resize(offset + blockWords(width) + 1, 0);
+
+    std::uint64_t* block = words_.data() + offset;
+    for (size_type i = 0; i < BLOCK_SIZE && width != 0; ++i) {
+      const std::uint64_t value = static_cast<std::uint64_t>(tail_[i] - base);
+      const size_type bit = i * width;
+      const size_type shift = bit % 64;
+      block[bit / 64] |= value << shift;
+      if (shift + width > 64) {
+        block[bit / 64 + 1] |= value >> (64 - shift);
+      }
+    }
+    return offset;
+  }
+};
+
+#endif // PACKEDINTVECTOR_H
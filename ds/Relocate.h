@@ -0,0 +1,130 @@
+#ifndef RELOCATE_H
+#define RELOCATE_H
+
+#include "Constexpr.h"
+#include "Uninitialized.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// @brief Trait marking types whose objects may be moved by copying their bytes.
+// @tparam T The type to query.
+//
+// Relocating a T means move-constructing it at a new address and destroying the
+// source. For trivially relocatable types both steps collapse into a memcpy, after
+// which the source slot is treated as raw storage and is NOT destroyed.
+//
+// Trivially copyable types qualify automatically. Other types may opt in by
+// specializing this trait, provided their move constructor followed by the
+// destructor of the moved-from object is equivalent to copying the bytes (true for
+// most types that do not hold pointers into themselves).
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// unique_ptr is a single owning pointer; it is relocatable whenever its deleter is.
+template <typename T, typename D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::default_delete<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+
+// @brief Relocate count elements into uninitialized, non-overlapping storage.
+// @param alloc The allocator owning both ranges.
+// @param first Start of the live source elements.
+// @param count Number of elements to relocate.
+// @param dest Start of the uninitialized destination storage.
+//
+// On success the destination holds the elements and the source slots are raw
+// storage. Trivially relocatable types are copied with a single memcpy and bypass
+// the allocator's construct()/destroy(); other types are moved (or copied, if their
+// move constructor may throw) element by element through the allocator. If that
+// fallback throws, the destination is left raw and the source untouched.
+//
+// During constant evaluation (C++20) every type takes the element-wise path.
+template <typename Alloc, typename T>
+DS_CONSTEXPR20 void
+uninitializedRelocate(Alloc& alloc, T* first, std::size_t count, T* dest) noexcept(
+    is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+  using AllocTraits = std::allocator_traits<Alloc>;
+
+  if constexpr (is_trivially_relocatable_v<T>) {
+    if (!isConstantEvaluated()) {
+      if (count > 0) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+      }
+      return;
+    }
+  }
+
+  if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+    for (std::size_t i = 0; i < count; ++i) {
+      AllocTraits::construct(alloc, dest + i, std::move(first[i]));
+    }
+
+    destroyN(alloc, first, count);
+  } else {
+    std::size_t constructed = 0;
+
+    try {
+      for (; constructed < count; ++constructed) {
+        AllocTraits::construct(
+            alloc, dest + constructed, std::move_if_noexcept(first[constructed]));
+      }
+    } catch (...) {
+      destroyN(alloc, dest, constructed);
+      throw;
+    }
+
+    destroyN(alloc, first, count);
+  }
+}
+
+// @brief Relocate count elements to a possibly overlapping range in the same buffer.
+// @param alloc The allocator owning the buffer.
+// @param first Start of the live source elements.
+// @param count Number of elements to relocate.
+// @param dest Start of the destination; slots outside the source range must be raw.
+//
+// Used to open or close gaps when shifting a tail. Trivially relocatable types go
+// through a single memmove; otherwise elements are moved one at a time in the
+// direction that never overwrites a pending source (also during constant evaluation).
+// The fallback requires a non-throwing move constructor.
+template <typename Alloc, typename T>
+DS_CONSTEXPR20 void relocateWithin(Alloc& alloc, T* first, std::size_t count,
+                                   T* dest) noexcept {
+  using AllocTraits = std::allocator_traits<Alloc>;
+
+  if constexpr (is_trivially_relocatable_v<T>) {
+    if (!isConstantEvaluated()) {
+      if (count > 0) {
+        std::memmove(
+            static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+      }
+      return;
+    }
+  } else {
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "relocateWithin requires a trivially relocatable or nothrow-movable type");
+  }
+
+  if (dest < first) {
+    for (std::size_t i = 0; i < count; ++i) {
+      AllocTraits::construct(alloc, dest + i, std::move(first[i]));
+      AllocTraits::destroy(alloc, first + i);
+    }
+  } else if (dest > first) {
+    for (std::size_t i = count; i > 0; --i) {
+      AllocTraits::construct(alloc, dest + i - 1, std::move(first[i - 1]));
+      AllocTraits::destroy(alloc, first + i - 1);
+    }
+  }
+}
+
+#endif // RELOCATE_H
@@ -0,0 +1,686 @@
+#ifndef SEGMENTEDVECTOR_H
+#define SEGMENTEDVECTOR_H
+
+#include "ContainerStats.h"
+#include "Uninitialized.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// @brief Dynamically-resizable array whose elements never move.
+// @tparam T The type of elements stored.
+// @tparam ChunkSize Elements per chunk (a power of two).
+// @tparam Allocator Allocator used for chunks, the directory and element construction.
+//
+// Elements are stored in fixed-size chunks reached through a directory of chunk
+// pointers; element i lives at chunks[i / ChunkSize][i % ChunkSize]. Growing appends a
+// chunk and a directory entry, so it is O(1) and never copies or moves an element:
+// pointers and references stay valid until the element is erased. Iterators hold an
+// index rather than a pointer, so they also survive growth.
+//
+// The price is one extra indirection per access and no contiguous data(). Inserting in
+// the middle still shifts the elements after the insertion point, as in Vector.
+//
+// With DS_CONTAINER_STATS defined, stats() counts each chunk as an allocation; growth
+// never reallocates. The directory is a Vector and keeps its own statistics.
+template <typename T, std::size_t ChunkSize = 256, typename Allocator = std::allocator<T>>
+class SegmentedVector : private ContainerStatsRecorder {
+  using AllocTraits = std::allocator_traits<Allocator>;
+  using ChunkAllocator = typename AllocTraits::template rebind_alloc<T*>;
+  using Directory = Vector<T*, ChunkAllocator>;
+
+  static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                "SegmentedVector: ChunkSize must be a power of two");
+  static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+                "SegmentedVector: Allocator::value_type must be T");
+
+  template <bool Const>
+  class Iterator;
+
+public:
+  // Type definitions
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  static constexpr size_type chunk_size = ChunkSize;
+
+  using ContainerStatsRecorder::stats;
+
+  // @brief Construct an empty vector using the given allocator.
+  // @param alloc Allocator instance to use.
+  explicit SegmentedVector(const Allocator& alloc = Allocator())
+      : alloc_{alloc}, chunks_{ChunkAllocator(alloc)}, size_{0} {
+  }
+
+  // @brief Construct a vector with count copies of value.
+  // @param count Number of elements to construct.
+  // @param value Value to initialize elements with.
+  // @param alloc Allocator instance to use.
+  SegmentedVector(size_type count, const T& value, const Allocator& alloc = Allocator())
+      : SegmentedVector(alloc) {
+    resize(count, value);
+  }
+
+  // @brief Copy constructor - performs deep copy.
+  // @param other The vector to copy from.
+  //
+  // The allocator is obtained through select_on_container_copy_construction.
+  SegmentedVector(const SegmentedVector& other)
+      : SegmentedVector(other,
+                        AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+  }
+
+  // @brief Copy constructor with an explicit allocator - performs deep copy.
+  // @param other The vector to copy from.
+  // @param alloc Allocator instance to use.
+  SegmentedVector(const SegmentedVector& other, const Allocator& alloc)
+      : SegmentedVector(alloc) {
+    try {
+      reserve(other.size_);
+      for (size_type done = 0; done < other.size_; done += ChunkSize) {
+        const size_type n = std::min(ChunkSize, other.size_ - done);
+        uninitializedCopyN(alloc_, other.slot(done), n, slot(done));
+        size_ += n;
+      }
+    } catch (...) {
+      release();
+      throw;
+    }
+    recordCopies(size_);
+  }
+
+  // @brief Copy assignment operator - performs deep copy.
+  // @param other The vector to copy from.
+  // @return Reference to this vector.
+  //
+  // Adopts other's allocator if propagate_on_container_copy_assignment is true.
+  SegmentedVector& operator=(const SegmentedVector& other) {
+    if (this != &other) {
+      if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_) {
+          release(); // Chunks must be returned to the allocator that provided them
+          alloc_ = other.alloc_;
+
+          const Directory empty{ChunkAllocator(alloc_)};
+          chunks_ = empty; // Copy assignment propagates the allocator to the directory
+        }
+      }
+
+      SegmentedVector temp(other, alloc_);
+      swapStorage(temp);
+      absorbStats(temp);
+    }
+
+    return *this;
+  }
+
+  // @brief Move constructor; steals the chunks.
+  // @param other The vector to move from.
+  SegmentedVector(SegmentedVector&& other) noexcept
+      : alloc_{std::move(other.alloc_)}, chunks_{std::move(other.chunks_)}, size_{other.size_} {
+    other.size_ = 0;
+  }
+
+  // @brief Move constructor with an explicit allocator.
+  // @param other The vector to move from.
+  // @param alloc Allocator instance to use.
+  //
+  // Steals other's chunks if the allocators compare equal; otherwise the elements are
+  // moved one by one into chunks obtained from alloc.
+  SegmentedVector(SegmentedVector&& other, const Allocator& alloc) : SegmentedVector(alloc) {
+    if (alloc_ == other.alloc_) {
+      swapStorage(other);
+    } else {
+      moveElementsFrom(other);
+    }
+  }
+
+  // @brief Move assignment operator.
+  // @param other The vector to move from.
+  // @return Reference to this vector.
+  //
+  // Steals other's chunks when the allocator propagates or compares equal. Otherwise
+  // the elements are moved one by one into chunks from this vector's allocator.
+  SegmentedVector& operator=(SegmentedVector&& other) noexcept(
+      AllocTraits::propagate_on_container_move_assignment::value ||
+      AllocTraits::is_always_equal::value) {
+    if (this != &other) {
+      if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+        release();
+        alloc_ = std::move(other.alloc_);
+        chunks_ = std::move(other.chunks_);
+        size_ = std::exchange(other.size_, 0);
+      } else if (alloc_ == other.alloc_) {
+        release();
+        swapStorage(other);
+      } else {
+        clear();
+        moveElementsFrom(other);
+      }
+    }
+
+    return *this;
+  }
+
+  // @brief Destructor - destroys live elements and frees every chunk.
+  ~SegmentedVector() {
+    release();
+  }
+
+
+  // @brief Get a copy of the allocator.
+  allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }
+
+
+  // Element access
+
+  // @brief Access element at index (no bounds checking).
+  // @param index The index of the element.
+  // @return Reference to the element.
+  reference operator[](size_type index) noexcept {
+    return *slot(index);
+  }
+
+  // @brief Access element at index (no bounds checking).
+  // @param index The index of the element.
+  // @return Const reference to the element.
+  const_reference operator[](size_type index) const noexcept {
+    return *slot(index);
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @param index The index of the element.
+  // @return Reference to the element.
+  // @throws std::out_of_range if index >= size.
+  reference at(size_type index) {
+    if (index >= size_) {
+      throw std::out_of_range("SegmentedVector::at: index out of range");
+    }
+
+    return *slot(index);
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @param index The index of the element.
+  // @return Const reference to the element.
+  // @throws std::out_of_range if index >= size.
+  const_reference at(size_type index) const {
+    if (index >= size_) {
+      throw std::out_of_range("SegmentedVector::at: index out of range");
+    }
+
+    return *slot(index);
+  }
+
+  // @brief Access the first element.
+  // @return Reference to the first element.
+  // @throws std::out_of_range if vector is empty.
+  reference front() {
+    if (empty()) {
+      throw std::out_of_range("SegmentedVector::front: vector is empty");
+    }
+
+    return *slot(0);
+  }
+
+  // @brief Access the first element.
+  // @return Const reference to the first element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference front() const {
+    if (empty()) {
+      throw std::out_of_range("SegmentedVector::front: vector is empty");
+    }
+
+    return *slot(0);
+  }
+
+  // @brief Access the last element.
+  // @return Reference to the last element.
+  // @throws std::out_of_range if vector is empty.
+  reference back() {
+    if (empty()) {
+      throw std::out_of_range("SegmentedVector::back: vector is empty");
+    }
+
+    return *slot(size_ - 1);
+  }
+
+  // @brief Access the last element.
+  // @return Const reference to the last element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference back() const {
+    if (empty()) {
+      throw std::out_of_range("SegmentedVector::back: vector is empty");
+    }
+
+    return *slot(size_ - 1);
+  }
+
+  // @brief Get iterator to the beginning.
+  iterator begin() noexcept {
+    return iterator(this, 0);
+  }
+
+  // @brief Get iterator to the end.
+  iterator end() noexcept {
+    return iterator(this, size_);
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator begin() const noexcept {
+    return const_iterator(this, 0);
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator end() const noexcept {
+    return const_iterator(this, size_);
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator cbegin() const noexcept {
+    return begin();
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator cend() const noexcept {
+    return end();
+  }
+
+  // @brief Check if the vector is empty.
+  // @return True if size is 0, false otherwise.
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // @brief Get the number of elements in the vector.
+  // @return The size.
+  [[nodiscard]] size_type size() const noexcept {
+    return size_;
+  }
+
+  // @brief Get the number of elements the allocated chunks can hold.
+  // @return The capacity (a multiple of ChunkSize).
+  [[nodiscard]] size_type capacity() const noexcept {
+    return chunks_.size() * ChunkSize;
+  }
+
+  // @brief Allocate chunks until at least newCapacity elements fit.
+  // @param newCapacity The desired capacity.
+  //
+  // Existing elements are untouched.
+  void reserve(size_type newCapacity) {
+    const size_type needed = (newCapacity + ChunkSize - 1) / ChunkSize;
+    if (needed <= chunks_.size()) {
+      return;
+    }
+
+    chunks_.reserve(needed);
+    while (chunks_.size() < needed) {
+      addChunk();
+    }
+  }
+
+  // @brief Free the chunks that hold no elements.
+  void shrink_to_fit() {
+    const size_type needed = (size_ + ChunkSize - 1) / ChunkSize;
+    while (chunks_.size() > needed) {
+      AllocTraits::deallocate(alloc_, chunks_.back(), ChunkSize);
+      chunks_.pop_back();
+    }
+    chunks_.shrink_to_fit();
+  }
+
+  // @brief Clear the vector, removing all elements.
+  //
+  // Size becomes 0, but the chunks are kept for reuse.
+  void clear() noexcept {
+    destroyRange(0, size_);
+    size_ = 0;
+  }
+
+  // @brief Add an element to the end of the vector (copy).
+  // @param item The element to add.
+  //
+  // Time complexity: O(1); never moves existing elements.
+  void push_back(const T& item) {
+    emplace_back(item);
+  }
+
+  // @brief Add an element to the end of the vector (move).
+  // @param item The element to add.
+  //
+  // Time complexity: O(1); never moves existing elements.
+  void push_back(T&& item) {
+    emplace_back(std::move(item));
+  }
+
+  // @brief Construct an element in place at the end of the vector.
+  // @param args Arguments forwarded to T's constructor.
+  // @return Reference to the new element.
+  //
+  // Time complexity: O(1); never moves existing elements.
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (size_ == capacity()) {
+      addChunk();
+    }
+
+    T* item = slot(size_);
+    AllocTraits::construct(alloc_, item, std::forward<Args>(args)...);
+    ++size_;
+    return *item;
+  }
+
+  // @brief Construct an element in place before pos.
+  // @param pos Position to insert before (begin() <= pos <= end()).
+  // @param args Arguments forwarded to T's constructor.
+  // @return Iterator to the new element.
+  //
+  // The element is built at the end, then rotated into place: elements after pos move
+  // one slot to the right. Time complexity: O(n) where n is the number of elements
+  // after pos.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    const size_type index = pos.index_;
+
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(begin() + index, end() - 1, end());
+
+    return begin() + index;
+  }
+
+  // @brief Remove the last element.
+  // @throws std::out_of_range if vector is empty.
+  //
+  // Time complexity: O(1).
+  void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("SegmentedVector::pop_back: vector is empty");
+    }
+
+    --size_;
+    AllocTraits::destroy(alloc_, slot(size_));
+  }
+
+  // @brief Resize the vector to contain count elements.
+  // @param count New size.
+  //
+  // If count > size, new elements are value-initialized in place.
+  // If count < size, the vector is truncated and the removed elements destroyed.
+  void resize(size_type count) {
+    growTo(count, [this](T* dest, size_type n) {
+      uninitializedValueConstructN(alloc_, dest, n);
+    });
+  }
+
+  // @brief Resize the vector to contain count elements.
+  // @param count New size.
+  // @param value Value to copy into the new elements.
+  //
+  // If count > size, copies of value are appended.
+  // If count < size, the vector is truncated and the removed elements destroyed.
+  void resize(size_type count, const T& value) {
+    if (count <= size_) {
+      resize(count);
+      return;
+    }
+
+    // value may be an element of this vector; chunks never move, so it stays valid
+    growTo(count, [this, &value](T* dest, size_type n) {
+      uninitializedFillN(alloc_, dest, n, value);
+    });
+  }
+
+  // @brief Resize the vector, leaving new elements default-initialized.
+  // @param count New size.
+  //
+  // For trivially default-constructible T the new elements are left indeterminate,
+  // skipping the zero fill of resize(). Other types are value-initialized as usual.
+  void resize_default_init(size_type count) {
+    if constexpr (std::is_trivially_default_constructible_v<T>) {
+      if (count > size_) {
+        reserve(count);
+        size_ = count;
+        return;
+      }
+    }
+
+    resize(count);
+  }
+
+  // @brief Swap elements with another vector.
+  // @param other The vector to swap with.
+  //
+  // Allocators are swapped if propagate_on_container_swap is true; otherwise they must
+  // compare equal.
+  void swap(SegmentedVector& other) noexcept {
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+
+    swapStorage(other);
+  }
+
+private:
+  static constexpr size_type CHUNK_SHIFT = [] {
+    size_type shift = 0;
+    while ((size_type{1} << shift) < ChunkSize) {
+      ++shift;
+    }
+    return shift;
+  }();
+
+  Allocator alloc_;  // Allocator for chunks and element lifetimes
+  Directory chunks_; // Chunk pointers; every chunk holds ChunkSize slots
+  size_type size_;   // Number of elements; [0, size_) are live
+
+  T* slot(size_type index) const noexcept {
+    return chunks_[index >> CHUNK_SHIFT] + (index & (ChunkSize - 1));
+  }
+
+  // @brief Allocate one more chunk and append it to the directory.
+  void addChunk() {
+    T* chunk = AllocTraits::allocate(alloc_, ChunkSize);
+    try {
+      chunks_.push_back(chunk);
+    } catch (...) {
+      AllocTraits::deallocate(alloc_, chunk, ChunkSize);
+      throw;
+    }
+    recordAllocation(ChunkSize * sizeof(T));
+    recordCapacity(chunks_.size() * ChunkSize);
+  }
+
+  // @brief Destroy the elements in [from, to), chunk by chunk.
+  void destroyRange(size_type from, size_type to) noexcept {
+    while (from < to) {
+      const size_type n = std::min(to - from, ChunkSize - (from & (ChunkSize - 1)));
+      destroyN(alloc_, slot(from), n);
+      from += n;
+    }
+  }
+
+  // @brief Shrink to count, or grow to count by calling construct(dest, n) per chunk.
+  //
+  // Strong guarantee: if construct throws, the elements added so far are destroyed.
+  template <typename Construct>
+  void growTo(size_type count, Construct construct) {
+    if (count <= size_) {
+      destroyRange(count, size_);
+      size_ = count;
+      return;
+    }
+
+    reserve(count);
+
+    const size_type oldSize = size_;
+    try {
+      while (size_ < count) {
+        const size_type n = std::min(count - size_, ChunkSize - (size_ & (ChunkSize - 1)));
+        construct(slot(size_), n);
+        size_ += n;
+      }
+    } catch (...) {
+      destroyRange(oldSize, size_);
+      size_ = oldSize;
+      throw;
+    }
+  }
+
+  // @brief Exchange chunks (but not allocators) with another vector.
+  void swapStorage(SegmentedVector& other) noexcept {
+    chunks_.swap(other.chunks_);
+    std::swap(size_, other.size_);
+  }
+
+  // @brief Move other's elements into chunks from this vector's allocator.
+  // @param other The vector to move from; left empty but keeps its chunks.
+  //
+  // Used when the allocators differ and chunks cannot be stolen. This vector must be
+  // empty.
+  void moveElementsFrom(SegmentedVector& other) {
+    reserve(other.size_);
+    try {
+      while (size_ < other.size_) {
+        const size_type n = std::min(ChunkSize, other.size_ - size_);
+        uninitializedMoveN(alloc_, other.slot(size_), n, slot(size_));
+        size_ += n;
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+    recordMoves(size_);
+    other.clear();
+  }
+
+  // @brief Destroy all elements and free every chunk, leaving the vector empty.
+  void release() noexcept {
+    destroyRange(0, size_);
+    for (T* chunk : chunks_) {
+      AllocTraits::deallocate(alloc_, chunk, ChunkSize);
+    }
+    chunks_.clear();
+    size_ = 0;
+  }
+
+
+  // @brief Random-access iterator: a container pointer plus an index.
+  template <bool Const>
+  class Iterator {
+    using Owner = std::conditional_t<Const, const SegmentedVector, SegmentedVector>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    Iterator() noexcept = default;
+
+    // Allows iterator -> const_iterator
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    Iterator(const Iterator<OtherConst>& other) noexcept
+        : owner_{other.owner_}, index_{other.index_} {
+    }
+
+    reference operator*() const noexcept {
+      return *owner_->slot(index_);
+    }
+    pointer operator->() const noexcept {
+      return owner_->slot(index_);
+    }
+    reference operator[](difference_type n) const noexcept {
+      return *owner_->slot(index_ + n);
+    }
+
+    Iterator& operator++() noexcept {
+      ++index_;
+      return *this;
+    }
+    Iterator operator++(int) noexcept {
+      Iterator old = *this;
+      ++index_;
+      return old;
+    }
+    Iterator& operator--() noexcept {
+      --index_;
+      return *this;
+    }
+    Iterator operator--(int) noexcept {
+      Iterator old = *this;
+      --index_;
+      return old;
+    }
+    Iterator& operator+=(difference_type n) noexcept {
+      index_ += n;
+      return *this;
+    }
+    Iterator& operator-=(difference_type n) noexcept {
+      index_ -= n;
+      return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) noexcept {
+      return it += n;
+    }
+    friend Iterator operator+(difference_type n, Iterator it) noexcept {
+      return it += n;
+    }
+    friend Iterator operator-(Iterator it, difference_type n) noexcept {
+      return it -= n;
+    }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) noexcept {
+      return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+    }
+
+    friend bool operator==(const Iterator& a, const Iterator& b) noexcept {
+      return a.index_ == b.index_;
+    }
+    friend bool operator!=(const Iterator& a, const Iterator& b) noexcept {
+      return a.index_ != b.index_;
+    }
+    friend bool operator<(const Iterator& a, const Iterator& b) noexcept {
+      return a.index_ < b.index_;
+    }
+    friend bool operator>(const Iterator& a, const Iterator& b) noexcept {
+      return a.index_ > b.index_;
+    }
+    friend bool operator<=(const Iterator& a, const Iterator& b) noexcept {
+      return a.index_ <= b.index_;
+    }
+    friend bool operator>=(const Iterator& a, const Iterator& b) noexcept {
+      return a.index_ >= b.index_;
+    }
+
+  private:
+    friend class SegmentedVector;
+    friend class Iterator<!Const>;
+
+    Owner* owner_ = nullptr;
+    size_type index_ = 0;
+
+    Iterator(Owner* owner, size_type index) noexcept : owner_{owner}, index_{index} {
+    }
+  };
+};
+
+#endif // SEGMENTEDVECTOR_H
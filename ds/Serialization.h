@@ -0,0 +1,459 @@
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include "AList.h"
+#include "LList.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Binary serialization for Vector, AList and LList.
+//
+// Every container is written as a 20-byte header followed by its elements:
+//
+//   char[4]   magic "DSAS"
+//   uint8_t   format version
+//   uint8_t   byte order of the writer (1 = little, 2 = big endian)
+//   uint8_t   element encoding (0 = raw bytes, 1 = per-element Codec)
+//   uint8_t   reserved (zero)
+//   uint32_t  sizeof(element) for raw encoding, 0 otherwise
+//   uint64_t  element count
+//
+// Multi-byte fields are stored in the writer's byte order and swapped by the reader when
+// the tag differs, so same-endian round trips never touch the bytes.
+//
+// Trivially copyable elements use raw encoding: a Vector or AList is written and read
+// with a single bulk stream call over its storage. Other element types go through
+// Codec<T>, a specialization point with encode()/decode(); Codecs are provided for
+// arithmetic types and std::string. LList is encoded node by node straight from its
+// links, without building an intermediate array.
+
+// @brief Thrown on malformed, truncated or incompatible input, and on stream failure.
+class SerializationError : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+namespace serialization_detail {
+  constexpr char MAGIC[4] = {'D', 'S', 'A', 'S'};
+  constexpr std::uint8_t VERSION = 1;
+  constexpr std::uint8_t LITTLE_ENDIAN_TAG = 1;
+  constexpr std::uint8_t BIG_ENDIAN_TAG = 2;
+  constexpr std::uint8_t RAW_ENCODING = 0;
+  constexpr std::uint8_t CODEC_ENCODING = 1;
+
+  // Elements decoded per bulk read; bounds memory when a corrupt header claims a huge count
+  constexpr std::size_t CHUNK_BYTES = std::size_t{1} << 20;
+
+  // Largest up-front reservation taken on the word of an (untrusted) header; beyond it the
+  // target grows through its growth policy as the data actually arrives
+  constexpr std::size_t MAX_RESERVE_BYTES = std::size_t{64} << 20;
+
+  inline std::uint8_t hostEndianTag() noexcept {
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1 ? LITTLE_ENDIAN_TAG : BIG_ENDIAN_TAG;
+  }
+
+  template <typename T>
+  void byteSwap(T& value) noexcept {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    std::reverse(bytes, bytes + sizeof(T));
+    std::memcpy(&value, bytes, sizeof(T));
+  }
+} // namespace serialization_detail
+
+
+// @brief Writes raw bytes and scalars to an output stream.
+class BinaryWriter {
+public:
+  explicit BinaryWriter(std::ostream& out) : out_{out} {
+  }
+
+  // @brief Write bytes verbatim.
+  // @throws SerializationError if the stream fails.
+  void write(const void* data, std::size_t bytes) {
+    out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    if (!out_) {
+      throw SerializationError("serialization: write failed");
+    }
+  }
+
+  // @brief Write an arithmetic value in host byte order.
+  template <typename T>
+  void writeScalar(T value) {
+    static_assert(std::is_arithmetic_v<T>, "BinaryWriter: writeScalar takes arithmetic types");
+    write(&value, sizeof(T));
+  }
+
+private:
+  std::ostream& out_;
+};
+
+// @brief Reads raw bytes and scalars from an input stream.
+//
+// Scalars are byte-swapped when the data was written on a host of the other byte order
+// (set from each container header).
+class BinaryReader {
+public:
+  explicit BinaryReader(std::istream& in) : in_{in} {
+  }
+
+  // @brief Read exactly bytes bytes.
+  // @throws SerializationError on end of stream or stream failure.
+  void read(void* data, std::size_t bytes) {
+    in_.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+    if (static_cast<std::size_t>(in_.gcount()) != bytes) {
+      throw SerializationError("serialization: unexpected end of stream");
+    }
+  }
+
+  // @brief Read an arithmetic value, converting it to host byte order.
+  template <typename T>
+  T readScalar() {
+    static_assert(std::is_arithmetic_v<T>, "BinaryReader: readScalar takes arithmetic types");
+    T value;
+    read(&value, sizeof(T));
+    if (swapBytes_) {
+      serialization_detail::byteSwap(value);
+    }
+    return value;
+  }
+
+  // @brief Check whether the current data comes from a host of the other byte order.
+  [[nodiscard]] bool swapsBytes() const noexcept {
+    return swapBytes_;
+  }
+
+  // @brief Set by the container header reader.
+  void setSwapBytes(bool swap) noexcept {
+    swapBytes_ = swap;
+  }
+
+private:
+  std::istream& in_;
+  bool swapBytes_ = false;
+};
+
+
+// @brief Per-element encoding for types that are not trivially copyable.
+// @tparam T The element type.
+//
+// Specialize with
+//
+//   static void encode(BinaryWriter& out, const T& value);
+//   static T decode(BinaryReader& in);
+//
+// Encoders should write scalars with writeScalar() so that decoders can rely on
+// readScalar() for byte-order conversion.
+template <typename T, typename Enable = void>
+struct Codec;
+
+template <typename T>
+struct Codec<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+  static void encode(BinaryWriter& out, T value) {
+    out.writeScalar(value);
+  }
+
+  static T decode(BinaryReader& in) {
+    return in.readScalar<T>();
+  }
+};
+
+template <>
+struct Codec<std::string> {
+  static void encode(BinaryWriter& out, const std::string& value) {
+    out.writeScalar(static_cast<std::uint64_t>(value.size()));
+    out.write(value.data(), value.size());
+  }
+
+  static std::string decode(BinaryReader& in) {
+    const auto length = in.readScalar<std::uint64_t>();
+
+    // Grow with the data actually read, not with the (untrusted) length
+    std::string value;
+    char buffer[4096];
+    for (std::uint64_t left = length; left > 0;) {
+      const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(left, sizeof(buffer)));
+      in.read(buffer, n);
+      value.append(buffer, n);
+      left -= n;
+    }
+    return value;
+  }
+};
+
+// @brief Whether T is written as raw bytes rather than through Codec<T>.
+template <typename T>
+inline constexpr bool usesRawEncoding_v = std::is_trivially_copyable_v<T>;
+
+
+namespace serialization_detail {
+  template <typename T>
+  void writeHeader(BinaryWriter& out, std::uint64_t count) {
+    out.write(MAGIC, sizeof(MAGIC));
+
+    const std::uint8_t tags[4] = {VERSION, hostEndianTag(),
+                                  usesRawEncoding_v<T> ? RAW_ENCODING : CODEC_ENCODING, 0};
+    out.write(tags, sizeof(tags));
+    out.writeScalar(static_cast<std::uint32_t>(usesRawEncoding_v<T> ? sizeof(T) : 0));
+    out.writeScalar(count);
+  }
+
+  // Validates the header against T and returns the element count
+  template <typename T>
+  std::uint64_t readHeader(BinaryReader& in) {
+    char magic[sizeof(MAGIC)];
+    in.read(magic, sizeof(magic));
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+      throw SerializationError("serialization: bad magic");
+    }
+
+    std::uint8_t tags[4];
+    in.read(tags, sizeof(tags));
+    if (tags[0] != VERSION) {
+      throw SerializationError("serialization: unsupported format version");
+    }
+    if (tags[1] != LITTLE_ENDIAN_TAG && tags[1] != BIG_ENDIAN_TAG) {
+      throw SerializationError("serialization: bad byte order tag");
+    }
+    in.setSwapBytes(tags[1] != hostEndianTag());
+
+    const std::uint8_t expected = usesRawEncoding_v<T> ? RAW_ENCODING : CODEC_ENCODING;
+    const auto elementSize = in.readScalar<std::uint32_t>();
+    if (tags[2] != expected || elementSize != (usesRawEncoding_v<T> ? sizeof(T) : 0)) {
+      throw SerializationError("serialization: element type does not match");
+    }
+    if constexpr (usesRawEncoding_v<T> && !std::is_arithmetic_v<T> && sizeof(T) > 1) {
+      if (in.swapsBytes()) {
+        throw SerializationError("serialization: cannot convert byte order of raw records");
+      }
+    }
+
+    return in.readScalar<std::uint64_t>();
+  }
+
+  // Reads count raw elements into dest, fixing the byte order of arithmetic types
+  template <typename T>
+  void readRaw(BinaryReader& in, T* dest, std::size_t count) {
+    in.read(dest, count * sizeof(T));
+    if constexpr (std::is_arithmetic_v<T> && sizeof(T) > 1) {
+      if (in.swapsBytes()) {
+        for (std::size_t i = 0; i < count; ++i) {
+          byteSwap(dest[i]);
+        }
+      }
+    }
+  }
+
+  template <typename T>
+  constexpr std::size_t chunkElements() noexcept {
+    return CHUNK_BYTES / sizeof(T) > 0 ? CHUNK_BYTES / sizeof(T) : 1;
+  }
+
+  // Capacity to reserve for a header announcing count elements
+  template <typename T>
+  std::size_t initialReserve(std::uint64_t count) noexcept {
+    return static_cast<std::size_t>(std::min<std::uint64_t>(count, MAX_RESERVE_BYTES / sizeof(T)));
+  }
+
+  // Make room for required elements, growing geometrically rather than to the exact size
+  template <typename Container>
+  void growFor(Container& target, std::size_t required) {
+    if (required > target.capacity()) {
+      using Element = typename Container::allocator_type::value_type;
+      target.reserve(
+          Container::growth_policy::next(target.capacity(), required, sizeof(Element)));
+    }
+  }
+} // namespace serialization_detail
+
+
+// @brief Read a container's elements in bounded-size chunks.
+// @tparam T The element type.
+//
+// Reads the header on construction; each readChunk() then decodes at most maxElements
+// into a caller-provided Vector, so arbitrarily large inputs can be processed with a
+// fixed amount of memory.
+template <typename T>
+class StreamReader {
+public:
+  // @brief Read and validate the container header.
+  // @throws SerializationError if the header is malformed or for another element type.
+  explicit StreamReader(BinaryReader& in)
+      : in_{in}, total_{serialization_detail::readHeader<T>(in)}, remaining_{total_} {
+  }
+
+  // @brief Number of elements announced by the header.
+  [[nodiscard]] std::uint64_t total() const noexcept {
+    return total_;
+  }
+
+  // @brief Number of elements not yet read.
+  [[nodiscard]] std::uint64_t remaining() const noexcept {
+    return remaining_;
+  }
+
+  // @brief Replace out's contents with the next elements.
+  // @param out Receives up to maxElements elements; its capacity is reused.
+  // @param maxElements Upper bound on the chunk size (must be positive).
+  // @return Number of elements read; 0 once the input is exhausted.
+  template <typename Allocator, typename Growth>
+  std::size_t readChunk(Vector<T, Allocator, Growth>& out, std::size_t maxElements) {
+    out.clear();
+    return appendChunk(out, maxElements);
+  }
+
+  // @brief Append the next elements to out.
+  // @param out Receives up to maxElements more elements.
+  // @param maxElements Upper bound on the chunk size (must be positive).
+  // @return Number of elements read; 0 once the input is exhausted.
+  template <typename Allocator, typename Growth>
+  std::size_t appendChunk(Vector<T, Allocator, Growth>& out, std::size_t maxElements) {
+    const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(remaining_, maxElements));
+    const std::size_t offset = out.size();
+
+    serialization_detail::growFor(out, offset + n);
+    if constexpr (usesRawEncoding_v<T>) {
+      out.resize_default_init(offset + n);
+      serialization_detail::readRaw(in_, out.data() + offset, n);
+    } else {
+      for (std::size_t i = 0; i < n; ++i) {
+        out.push_back(Codec<T>::decode(in_));
+      }
+    }
+
+    remaining_ -= n;
+    return n;
+  }
+
+  // @brief Decode the next element.
+  // @throws SerializationError if no elements remain.
+  T readOne() {
+    if (remaining_ == 0) {
+      throw SerializationError("serialization: no elements left");
+    }
+    --remaining_;
+
+    if constexpr (usesRawEncoding_v<T>) {
+      T value;
+      serialization_detail::readRaw(in_, &value, 1);
+      return value;
+    } else {
+      return Codec<T>::decode(in_);
+    }
+  }
+
+private:
+  BinaryReader& in_;
+  std::uint64_t total_;
+  std::uint64_t remaining_;
+};
+
+
+// Vector
+
+// @brief Write a Vector; raw elements go out in one bulk write.
+template <typename T, typename Allocator, typename Growth>
+void serialize(BinaryWriter& out, const Vector<T, Allocator, Growth>& vec) {
+  serialization_detail::writeHeader<T>(out, vec.size());
+
+  if constexpr (usesRawEncoding_v<T>) {
+    out.write(vec.data(), vec.size() * sizeof(T));
+  } else {
+    for (const T& item : vec) {
+      Codec<T>::encode(out, item);
+    }
+  }
+}
+
+// @brief Replace vec's contents with a serialized Vector, AList or LList.
+// @throws SerializationError on malformed or mismatched input; vec is then unspecified.
+//
+// The announced count is reserved once, up to MAX_RESERVE_BYTES; past that, storage grows
+// geometrically with the data actually read, so a corrupt count cannot force a huge
+// allocation up front.
+template <typename T, typename Allocator, typename Growth>
+void deserialize(BinaryReader& in, Vector<T, Allocator, Growth>& vec) {
+  StreamReader<T> reader(in);
+  vec.clear();
+  vec.reserve(serialization_detail::initialReserve<T>(reader.total()));
+
+  while (reader.appendChunk(vec, serialization_detail::chunkElements<T>()) > 0) {
+  }
+}
+
+
+// AList
+
+// @brief Write an AList; raw elements go out in one bulk write.
+template <typename E, typename Allocator, typename Growth>
+void serialize(BinaryWriter& out, const AList<E, Allocator, Growth>& list) {
+  serialization_detail::writeHeader<E>(out, list.length());
+
+  if constexpr (usesRawEncoding_v<E>) {
+    out.write(list.data(), list.length() * sizeof(E));
+  } else {
+    for (std::size_t i = 0; i < list.length(); ++i) {
+      Codec<E>::encode(out, list.data()[i]);
+    }
+  }
+}
+
+// @brief Replace list's contents with a serialized Vector, AList or LList.
+// @throws SerializationError on malformed or mismatched input; list is then unspecified.
+//
+// Reserves like deserialize(Vector) and appends each chunk as one batch.
+template <typename E, typename Allocator, typename Growth>
+void deserialize(BinaryReader& in, AList<E, Allocator, Growth>& list) {
+  StreamReader<E> reader(in);
+  list.clear();
+  list.reserve(serialization_detail::initialReserve<E>(reader.total()));
+
+  Vector<E> chunk;
+  while (reader.readChunk(chunk, serialization_detail::chunkElements<E>()) > 0) {
+    serialization_detail::growFor(list, list.length() + chunk.size());
+    list.appendRange(chunk.data(), chunk.data() + chunk.size());
+  }
+}
+
+
+// LList
+
+// @brief Write an LList node by node, without an intermediate array.
+template <typename E, typename Allocator>
+void serialize(BinaryWriter& out, const LList<E, Allocator>& list) {
+  serialization_detail::writeHeader<E>(out, list.length());
+
+  list.forEach([&out](const E& item) {
+    if constexpr (usesRawEncoding_v<E>) {
+      out.write(&item, sizeof(E));
+    } else {
+      Codec<E>::encode(out, item);
+    }
+  });
+}
+
+// @brief Replace list's contents with a serialized Vector, AList or LList.
+// @throws SerializationError on malformed or mismatched input; list is then unspecified.
+template <typename E, typename Allocator>
+void deserialize(BinaryReader& in, LList<E, Allocator>& list) {
+  StreamReader<E> reader(in);
+  list.clear();
+
+  while (reader.remaining() > 0) {
+    list.append(reader.readOne());
+  }
+}
+
+#endif // SERIALIZATION_H
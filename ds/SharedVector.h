@@ -0,0 +1,366 @@
+#ifndef SHAREDVECTOR_H
+#define SHAREDVECTOR_H
+
+#include "Vector.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// @brief Copy-on-write Vector whose copies share one buffer until one of them is modified.
+// @tparam T The type of elements stored.
+// @tparam Allocator Allocator for the elements; rebound to allocate the shared block.
+// @tparam Growth Growth policy of the underlying Vector.
+//
+// The elements live in a Vector inside a reference-counted block. Copying a SharedVector,
+// or taking a snapshot(), only bumps the count: it is O(1) whatever the size, and never
+// allocates. The first modification through a handle whose block is shared copies the
+// elements (to exactly size() slots, plus room for the element being added) into a
+// private block; a handle that already owns its block alone is modified in place.
+//
+// Snapshots are safe to hand to other threads: distinct SharedVector objects may be read,
+// copied, modified and destroyed concurrently even when they share a block, because the
+// count is atomic and shared blocks are never written. A single SharedVector object is
+// not thread-safe, like any other container.
+//
+// Read access is const-only. To modify, use push_back/emplace_back/pop_back/resize/clear
+// or mutate(), which returns the privately owned Vector.
+template <typename T, typename Allocator = std::allocator<T>, typename Growth = DoublingGrowth>
+class SharedVector {
+public:
+  // Type definitions
+  using vector_type = Vector<T, Allocator, Growth>;
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_reference = const T&;
+  using const_pointer = const T*;
+  using const_iterator = const T*;
+
+  // @brief Construct an empty vector; nothing is allocated until the first append.
+  // @param alloc Allocator instance to use.
+  explicit SharedVector(const Allocator& alloc = Allocator()) : alloc_{alloc}, block_{nullptr} {
+  }
+
+  // @brief Take over the elements of a Vector without copying them.
+  // @param vec The vector to adopt (moved from).
+  explicit SharedVector(vector_type&& vec)
+      : alloc_{vec.get_allocator()}, block_{createBlock(std::move(vec))} {
+  }
+
+  // @brief Copy constructor - shares other's elements (O(1)).
+  // @param other The vector to share with.
+  SharedVector(const SharedVector& other) noexcept : alloc_{other.alloc_}, block_{other.block_} {
+    retain();
+  }
+
+  // @brief Move constructor - takes over other's reference, leaving other empty.
+  // @param other The vector to move from.
+  SharedVector(SharedVector&& other) noexcept
+      : alloc_{other.alloc_}, block_{std::exchange(other.block_, nullptr)} {
+  }
+
+  // @brief Copy assignment - shares other's elements (O(1)).
+  // @param other The vector to share with.
+  // @return Reference to this vector.
+  //
+  // Adopts other's allocator only if propagate_on_container_copy_assignment is true. The
+  // shared block is taken either way: it frees itself through its own elements' allocator.
+  SharedVector& operator=(const SharedVector& other) noexcept {
+    if (this != &other) {
+      other.retain();
+      release();
+      block_ = other.block_;
+      if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+        alloc_ = other.alloc_;
+      }
+    }
+    return *this;
+  }
+
+  // @brief Move assignment - takes over other's reference, leaving other empty.
+  // @param other The vector to move from.
+  // @return Reference to this vector.
+  //
+  // Adopts other's allocator only if propagate_on_container_move_assignment is true.
+  SharedVector& operator=(SharedVector&& other) noexcept {
+    if (this != &other) {
+      release();
+      block_ = std::exchange(other.block_, nullptr);
+      if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+        alloc_ = std::move(other.alloc_);
+      }
+    }
+    return *this;
+  }
+
+  // @brief Destructor - drops this handle's reference; the last one frees the block.
+  ~SharedVector() {
+    release();
+  }
+
+
+  // @brief Get a copy of the allocator.
+  allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }
+
+  // @brief Take a read-only view of the current contents to publish elsewhere (O(1)).
+  // @return A vector sharing this one's elements; later changes to either are not seen
+  //         by the other.
+  SharedVector snapshot() const noexcept {
+    return *this;
+  }
+
+  // @brief Number of handles sharing this vector's elements (0 if nothing is allocated).
+  size_type useCount() const noexcept {
+    return block_ != nullptr ? block_->refs.load(std::memory_order_acquire) : 0;
+  }
+
+
+  // Element access (never copies)
+
+  // @brief Access element at index (no bounds checking).
+  const_reference operator[](size_type index) const noexcept {
+    return block_->elements[index];
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @throws std::out_of_range if index >= size.
+  const_reference at(size_type index) const {
+    if (index >= size()) {
+      throw std::out_of_range("SharedVector::at: index out of range");
+    }
+
+    return block_->elements[index];
+  }
+
+  // @brief Access the first element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference front() const {
+    if (empty()) {
+      throw std::out_of_range("SharedVector::front: vector is empty");
+    }
+
+    return block_->elements[0];
+  }
+
+  // @brief Access the last element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference back() const {
+    if (empty()) {
+      throw std::out_of_range("SharedVector::back: vector is empty");
+    }
+
+    return block_->elements[size() - 1];
+  }
+
+  // @brief Get pointer to the (possibly shared) elements.
+  const_pointer data() const noexcept {
+    return block_ != nullptr ? block_->elements.data() : nullptr;
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator begin() const noexcept {
+    return data();
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator end() const noexcept {
+    return data() + size();
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator cbegin() const noexcept {
+    return begin();
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator cend() const noexcept {
+    return end();
+  }
+
+  // @brief Check if the vector is empty.
+  [[nodiscard]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  // @brief Get the number of elements in the vector.
+  [[nodiscard]] size_type size() const noexcept {
+    return block_ != nullptr ? block_->elements.size() : 0;
+  }
+
+
+  // Modifiers (copy the elements first if they are shared)
+
+  // @brief Get the elements for modification, copying them first if they are shared.
+  // @return The Vector owned by this handle alone.
+  //
+  // The reference is invalidated by the next copy or snapshot() of this vector: writing
+  // through it afterwards would change the shared elements.
+  vector_type& mutate() {
+    return detach(0);
+  }
+
+  // @brief Add an element to the end of the vector (copy).
+  void push_back(const T& item) {
+    emplace_back(item);
+  }
+
+  // @brief Add an element to the end of the vector (move).
+  void push_back(T&& item) {
+    emplace_back(std::move(item));
+  }
+
+  // @brief Construct an element in place at the end of the vector.
+  // @param args Arguments forwarded to T's constructor; may refer to elements of this
+  //        vector.
+  // @return Reference to the new element.
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (block_ != nullptr && isShared()) {
+      // Build first: args may refer to the shared elements, which detaching may free
+      T item(std::forward<Args>(args)...);
+      return detach(1).emplace_back(std::move(item));
+    }
+
+    return detach(1).emplace_back(std::forward<Args>(args)...);
+  }
+
+  // @brief Remove the last element.
+  // @throws std::out_of_range if vector is empty.
+  void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("SharedVector::pop_back: vector is empty");
+    }
+
+    detach(0).pop_back();
+  }
+
+  // @brief Resize the vector to contain count elements.
+  // @param count New size; new elements are value-initialized.
+  void resize(size_type count) {
+    if (count != size()) {
+      detach(count > size() ? count - size() : 0).resize(count);
+    }
+  }
+
+  // @brief Resize the vector to contain count elements.
+  // @param count New size.
+  // @param value Value to initialize new elements with (may be an element of this vector).
+  void resize(size_type count, const T& value) {
+    if (count == size()) {
+      return;
+    }
+
+    const size_type extra = count > size() ? count - size() : 0;
+    if (block_ != nullptr && isShared()) {
+      T item(value); // Detaching may free the block value lives in
+      detach(extra).resize(count, item);
+    } else {
+      detach(extra).resize(count, value);
+    }
+  }
+
+  // @brief Reserve space for at least newCapacity elements (copies if shared).
+  void reserve(size_type newCapacity) {
+    detach(newCapacity > size() ? newCapacity - size() : 0).reserve(newCapacity);
+  }
+
+  // @brief Remove all elements. Shared elements are just released, not copied.
+  void clear() noexcept {
+    if (block_ != nullptr && isShared()) {
+      release();
+    } else if (block_ != nullptr) {
+      block_->elements.clear();
+    }
+  }
+
+  // @brief Exchange contents with another vector (O(1)).
+  //
+  // Allocators are exchanged only if propagate_on_container_swap is true; blocks always
+  // are, since each frees itself through its own elements' allocator.
+  void swap(SharedVector& other) noexcept {
+    using std::swap;
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      swap(alloc_, other.alloc_);
+    }
+    swap(block_, other.block_);
+  }
+
+private:
+  struct Block {
+    std::atomic<size_type> refs;
+    vector_type elements;
+
+    explicit Block(vector_type&& vec) : refs{1}, elements(std::move(vec)) {
+    }
+  };
+
+  using AllocTraits = std::allocator_traits<Allocator>;
+  using BlockAllocator = typename AllocTraits::template rebind_alloc<Block>;
+  using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+  Allocator alloc_; // Allocator for blocks this handle creates
+  Block* block_;    // Shared elements, or nullptr when nothing is allocated
+
+  bool isShared() const noexcept {
+    return block_->refs.load(std::memory_order_acquire) != 1;
+  }
+
+  Block* createBlock(vector_type&& vec) {
+    BlockAllocator blockAlloc(alloc_);
+    Block* block = BlockTraits::allocate(blockAlloc, 1);
+    try {
+      BlockTraits::construct(blockAlloc, block, std::move(vec));
+    } catch (...) {
+      BlockTraits::deallocate(blockAlloc, block, 1);
+      throw;
+    }
+    return block;
+  }
+
+  void retain() const noexcept {
+    if (block_ != nullptr) {
+      block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // @brief Drop this handle's reference, freeing the block if it was the last.
+  void release() noexcept {
+    Block* block = std::exchange(block_, nullptr);
+    if (block == nullptr || block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+
+    BlockAllocator blockAlloc(block->elements.get_allocator());
+    BlockTraits::destroy(blockAlloc, block);
+    BlockTraits::deallocate(blockAlloc, block, 1);
+  }
+
+  // @brief Make sure this handle owns its block alone.
+  // @param extra Room to leave for elements about to be added when copying.
+  // @return The owned elements.
+  vector_type& detach(size_type extra) {
+    if (block_ == nullptr) {
+      block_ = createBlock(vector_type(alloc_));
+    } else if (isShared()) {
+      vector_type copy(alloc_);
+      copy.reserve(block_->elements.size() + extra);
+      for (const T& item : block_->elements) {
+        copy.push_back(item);
+      }
+
+      Block* fresh = createBlock(std::move(copy));
+      release();
+      block_ = fresh;
+    }
+
+    return block_->elements;
+  }
+};
+
+#endif // SHAREDVECTOR_H
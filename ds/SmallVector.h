@@ -0,0 +1,663 @@
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include "ContainerStats.h"
+#include "Relocate.h"
+#include "Uninitialized.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// @brief Vector with inline storage for the first N elements.
+// @tparam T The type of elements stored in the vector.
+// @tparam N Number of elements kept inline before spilling to the heap.
+// @tparam Allocator Allocator used once the elements no longer fit inline.
+//
+// Offers the same interface as Vector. Up to N elements live in a buffer embedded in
+// the object, so small vectors never touch the allocator. Growing past N moves the
+// elements to the heap; shrink_to_fit moves them back once they fit again.
+//
+// Unlike Vector, moving a SmallVector whose elements are inline has to move the
+// elements themselves (O(size)); trivially relocatable elements do so with a memcpy.
+//
+// With DS_CONTAINER_STATS defined, stats() counts heap allocations only, so a vector
+// that never spills reports none.
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class SmallVector : private ContainerStatsRecorder {
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  static_assert(N > 0, "SmallVector: inline capacity must be positive");
+  static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+                "SmallVector: Allocator::value_type must be T");
+  static_assert(std::is_same_v<typename AllocTraits::pointer, T*>,
+                "SmallVector: Allocator must use raw pointers");
+
+  static constexpr bool NOTHROW_RELOCATE =
+      is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+public:
+  // Type definitions
+  using value_type = T;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  using ContainerStatsRecorder::stats;
+
+  // @brief Construct an empty vector with optional initial capacity.
+  // @param initialCapacity Initial capacity; values <= N use the inline buffer.
+  // @param alloc Allocator instance to use.
+  explicit SmallVector(size_type initialCapacity = 0, const Allocator& alloc = Allocator())
+      : alloc_{alloc}, elements_{inlineData()}, capacity_{N}, size_{0} {
+    reserve(initialCapacity);
+  }
+
+  // @brief Construct an empty vector using the given allocator.
+  // @param alloc Allocator instance to use.
+  explicit SmallVector(const Allocator& alloc) : SmallVector(0, alloc) {
+  }
+
+  // @brief Construct a vector with count copies of value.
+  // @param count Number of elements to construct.
+  // @param value Value to initialize elements with.
+  // @param alloc Allocator instance to use.
+  SmallVector(size_type count, const T& value, const Allocator& alloc = Allocator())
+      : SmallVector(count, alloc) {
+    uninitializedFillN(alloc_, elements_, count, value);
+    size_ = count;
+  }
+
+  // @brief Copy constructor - performs deep copy.
+  // @param other The vector to copy from.
+  SmallVector(const SmallVector& other)
+      : SmallVector(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+  }
+
+  // @brief Copy constructor with an explicit allocator - performs deep copy.
+  // @param other The vector to copy from.
+  // @param alloc Allocator instance to use.
+  SmallVector(const SmallVector& other, const Allocator& alloc)
+      : SmallVector(other.size_, alloc) {
+    uninitializedCopyN(alloc_, other.elements_, other.size_, elements_);
+    size_ = other.size_;
+    recordCopies(size_);
+  }
+
+  // @brief Copy assignment operator - performs deep copy.
+  // @param other The vector to copy from.
+  // @return Reference to this vector.
+  //
+  // The copy is built aside and then takes this vector's place, so if a copy throws the
+  // vector is unchanged (for inline copies this needs T to relocate without throwing).
+  // Adopts other's allocator if propagate_on_container_copy_assignment is true.
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+      SmallVector temp(other, propagate ? other.alloc_ : alloc_);
+
+      release(); // Storage must be returned to the allocator that provided it
+      if constexpr (propagate) {
+        alloc_ = other.alloc_;
+      }
+      moveFrom(temp); // Steals temp's heap buffer or relocates its inline elements
+      absorbStats(temp);
+    }
+
+    return *this;
+  }
+
+  // @brief Move constructor.
+  // @param other The vector to move from.
+  //
+  // Heap storage is stolen; inline elements are relocated into this vector's buffer.
+  SmallVector(SmallVector&& other) noexcept(NOTHROW_RELOCATE)
+      : alloc_{std::move(other.alloc_)}, elements_{inlineData()}, capacity_{N}, size_{0} {
+    if (other.isInline()) {
+      takeElements(other);
+    } else {
+      stealHeap(other);
+    }
+  }
+
+  // @brief Move assignment operator.
+  // @param other The vector to move from.
+  // @return Reference to this vector.
+  SmallVector& operator=(SmallVector&& other) noexcept(
+      NOTHROW_RELOCATE && (AllocTraits::propagate_on_container_move_assignment::value ||
+                           AllocTraits::is_always_equal::value)) {
+    if (this != &other) {
+      if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+        if (alloc_ != other.alloc_) {
+          release(); // Storage must be returned to the allocator that provided it
+        }
+        alloc_ = other.alloc_;
+      }
+
+      if (!other.isInline() && alloc_ == other.alloc_) {
+        release();
+        stealHeap(other);
+      } else {
+        clear();
+        reserve(other.size_);
+        takeElements(other);
+      }
+    }
+
+    return *this;
+  }
+
+  // @brief Destructor - destroys live elements and frees any heap storage.
+  ~SmallVector() {
+    release();
+  }
+
+
+  // @brief Get a copy of the allocator.
+  allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }
+
+  // @brief Get the number of elements that fit without a heap allocation.
+  static constexpr size_type inlineCapacity() noexcept {
+    return N;
+  }
+
+  // @brief Check whether the elements currently live in the inline buffer.
+  [[nodiscard]] bool isInline() const noexcept {
+    return elements_ == inlineData();
+  }
+
+
+  // Element access
+
+  // @brief Access element at index (no bounds checking).
+  // @param index The index of the element.
+  // @return Reference to the element.
+  reference operator[](size_type index) noexcept {
+    return elements_[index];
+  }
+
+  // @brief Access element at index (no bounds checking).
+  // @param index The index of the element.
+  // @return Const reference to the element.
+  const_reference operator[](size_type index) const noexcept {
+    return elements_[index];
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @param index The index of the element.
+  // @return Reference to the element.
+  // @throws std::out_of_range if index >= size.
+  reference at(size_type index) {
+    if (index >= size_) {
+      throw std::out_of_range("SmallVector::at: index out of range");
+    }
+
+    return elements_[index];
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @param index The index of the element.
+  // @return Const reference to the element.
+  // @throws std::out_of_range if index >= size.
+  const_reference at(size_type index) const {
+    if (index >= size_) {
+      throw std::out_of_range("SmallVector::at: index out of range");
+    }
+
+    return elements_[index];
+  }
+
+  // @brief Access the first element.
+  // @throws std::out_of_range if vector is empty.
+  reference front() {
+    if (empty()) {
+      throw std::out_of_range("SmallVector::front: vector is empty");
+    }
+
+    return elements_[0];
+  }
+
+  // @brief Access the first element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference front() const {
+    if (empty()) {
+      throw std::out_of_range("SmallVector::front: vector is empty");
+    }
+
+    return elements_[0];
+  }
+
+  // @brief Access the last element.
+  // @throws std::out_of_range if vector is empty.
+  reference back() {
+    if (empty()) {
+      throw std::out_of_range("SmallVector::back: vector is empty");
+    }
+
+    return elements_[size_ - 1];
+  }
+
+  // @brief Access the last element.
+  // @throws std::out_of_range if vector is empty.
+  const_reference back() const {
+    if (empty()) {
+      throw std::out_of_range("SmallVector::back: vector is empty");
+    }
+
+    return elements_[size_ - 1];
+  }
+
+  // @brief Get pointer to underlying array (inline buffer or heap).
+  pointer data() noexcept {
+    return elements_;
+  }
+
+  // @brief Get pointer to underlying array (inline buffer or heap).
+  const_pointer data() const noexcept {
+    return elements_;
+  }
+
+  // @brief Get iterator to the beginning.
+  iterator begin() noexcept {
+    return elements_;
+  }
+
+  // @brief Get iterator to the end.
+  iterator end() noexcept {
+    return elements_ + size_;
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator begin() const noexcept {
+    return elements_;
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator end() const noexcept {
+    return elements_ + size_;
+  }
+
+  // @brief Get const iterator to the beginning.
+  const_iterator cbegin() const noexcept {
+    return elements_;
+  }
+
+  // @brief Get const iterator to the end.
+  const_iterator cend() const noexcept {
+    return elements_ + size_;
+  }
+
+  // @brief Check if the vector is empty.
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // @brief Get the number of elements in the vector.
+  [[nodiscard]] size_type size() const noexcept {
+    return size_;
+  }
+
+  // @brief Get the current capacity (at least N).
+  [[nodiscard]] size_type capacity() const noexcept {
+    return capacity_;
+  }
+
+  // @brief Reserve space for at least newCapacity elements.
+  // @param newCapacity The desired capacity.
+  //
+  // Moves the elements to the heap if newCapacity exceeds the current capacity.
+  void reserve(size_type newCapacity) {
+    if (newCapacity > capacity_) {
+      reallocate(newCapacity);
+    }
+  }
+
+  // @brief Shrink the capacity to fit the current size.
+  //
+  // Elements move back into the inline buffer if they fit.
+  void shrink_to_fit() {
+    if (isInline() || capacity_ == size_) {
+      return;
+    }
+
+    if (size_ <= N) {
+      T* heap = elements_;
+      const size_type heapCapacity = capacity_;
+
+      recordGrowth();
+      uninitializedRelocate(alloc_, heap, size_, inlineData());
+      AllocTraits::deallocate(alloc_, heap, heapCapacity);
+      elements_ = inlineData();
+      capacity_ = N;
+    } else {
+      reallocate(size_);
+    }
+  }
+
+  // @brief Clear the vector, removing all elements.
+  //
+  // Size becomes 0, but capacity remains unchanged.
+  void clear() noexcept {
+    destroyN(alloc_, elements_, size_);
+    size_ = 0;
+  }
+
+  // @brief Add an element to the end of the vector (copy).
+  // @param item The element to add.
+  void push_back(const T& item) {
+    emplace_back(item);
+  }
+
+  // @brief Add an element to the end of the vector (move).
+  // @param item The element to add.
+  void push_back(T&& item) {
+    emplace_back(std::move(item));
+  }
+
+  // @brief Construct an element in place at the end of the vector.
+  // @param args Arguments forwarded to T's constructor.
+  // @return Reference to the new element.
+  //
+  // The arguments may refer to elements of this vector.
+  // Time complexity: O(1) amortized.
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      return *growAndEmplace(size_, std::forward<Args>(args)...);
+    }
+
+    AllocTraits::construct(alloc_, elements_ + size_, std::forward<Args>(args)...);
+    return elements_[size_++];
+  }
+
+  // @brief Construct an element in place before pos.
+  // @param pos Position to insert before (begin() <= pos <= end()).
+  // @param args Arguments forwarded to T's constructor.
+  // @return Iterator to the new element.
+  //
+  // Time complexity: O(n) where n is the number of elements after pos.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    const auto index = static_cast<size_type>(pos - cbegin());
+
+    if (size_ == capacity_) {
+      return growAndEmplace(index, std::forward<Args>(args)...);
+    }
+
+    if (index == size_) {
+      AllocTraits::construct(alloc_, elements_ + size_, std::forward<Args>(args)...);
+      ++size_;
+      return elements_ + index;
+    }
+
+    if constexpr (is_trivially_relocatable_v<T>) {
+      // Build the value aside (args may alias a shifting element), then memmove
+      alignas(T) unsigned char raw[sizeof(T)];
+      T* item = reinterpret_cast<T*>(raw);
+      AllocTraits::construct(alloc_, item, std::forward<Args>(args)...);
+
+      relocateWithin(alloc_, elements_ + index, size_ - index, elements_ + index + 1);
+      uninitializedRelocate(alloc_, item, 1, elements_ + index);
+      ++size_;
+
+      return elements_ + index;
+    }
+
+    // Build the value first: args may alias an element that is about to shift.
+    T item(std::forward<Args>(args)...);
+
+    AllocTraits::construct(alloc_, elements_ + size_, std::move(elements_[size_ - 1]));
+    ++size_;
+    std::move_backward(elements_ + index, elements_ + size_ - 2, elements_ + size_ - 1);
+    elements_[index] = std::move(item);
+
+    return elements_ + index;
+  }
+
+  // @brief Remove the last element.
+  // @throws std::out_of_range if vector is empty.
+  void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("SmallVector::pop_back: vector is empty");
+    }
+
+    --size_;
+    AllocTraits::destroy(alloc_, elements_ + size_);
+  }
+
+  // @brief Resize the vector to contain count elements.
+  // @param count New size.
+  //
+  // If count > size, new elements are value-initialized in place.
+  // If count < size, the vector is truncated.
+  void resize(size_type count) {
+    if (count <= size_) {
+      destroyN(alloc_, elements_ + count, size_ - count);
+      size_ = count;
+      return;
+    }
+
+    reserve(count);
+    uninitializedValueConstructN(alloc_, elements_ + size_, count - size_);
+    size_ = count;
+  }
+
+  // @brief Swap elements with another vector.
+  // @param other The vector to swap with.
+  //
+  // Heap buffers are exchanged; inline elements are relocated. Allocators are exchanged
+  // (if propagate_on_container_swap) only once both vectors are empty, so every buffer is
+  // released through the allocator that provided it.
+  void swap(SmallVector& other) noexcept(
+      NOTHROW_RELOCATE && (AllocTraits::propagate_on_container_swap::value ||
+                           AllocTraits::is_always_equal::value)) {
+    constexpr bool propagate = AllocTraits::propagate_on_container_swap::value;
+
+    if (!isInline() && !other.isInline()) {
+      if constexpr (propagate) {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+      }
+      std::swap(elements_, other.elements_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(size_, other.size_);
+      return;
+    }
+
+    // Park both contents with their own allocators: steals heap buffers or relocates
+    // inline elements, so nothing is allocated here
+    SmallVector theirs(std::move(other), other.alloc_);
+    SmallVector mine(std::move(*this), alloc_);
+
+    if constexpr (propagate) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+    moveFrom(theirs); // Allocates only for unequal, non-propagating allocators
+    other.moveFrom(mine);
+  }
+
+private:
+  static constexpr size_type GROWTH_FACTOR = 2; // Capacity growth multiplier
+
+  Allocator alloc_;     // Allocator for heap storage and element lifetimes
+  T* elements_;         // inlineData() or heap storage; [0, size_) holds live elements
+  size_type capacity_;  // Maximum capacity before reallocation (>= N)
+  size_type size_;      // Number of elements in the vector
+  alignas(T) unsigned char inline_[N * sizeof(T)]; // Inline element storage
+
+  // @brief Move-construct from other using the given allocator (used by swap).
+  SmallVector(SmallVector&& other, const Allocator& alloc)
+      : alloc_{alloc}, elements_{inlineData()}, capacity_{N}, size_{0} {
+    moveFrom(other);
+  }
+
+  T* inlineData() noexcept {
+    return reinterpret_cast<T*>(inline_);
+  }
+
+  const T* inlineData() const noexcept {
+    return reinterpret_cast<const T*>(inline_);
+  }
+
+  // @brief Take over other's heap buffer and reset other to empty inline storage.
+  void stealHeap(SmallVector& other) noexcept {
+    elements_ = other.elements_;
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+
+    other.elements_ = other.inlineData();
+    other.capacity_ = N;
+    other.size_ = 0;
+  }
+
+  // @brief Relocate other's elements into this vector's storage, leaving other empty.
+  //
+  // Requires capacity_ >= other.size_ and this vector to be empty.
+  void takeElements(SmallVector& other) noexcept(NOTHROW_RELOCATE) {
+    uninitializedRelocate(alloc_, other.elements_, other.size_, elements_);
+    recordRelocation<T>(other.size_);
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+  // @brief Move other's contents into this empty vector, stealing heap storage only
+  // when it came from an equal allocator (otherwise this may allocate).
+  void moveFrom(SmallVector& other) {
+    release();
+
+    if (!other.isInline() && alloc_ == other.alloc_) {
+      stealHeap(other);
+    } else {
+      reserve(other.size_);
+      takeElements(other);
+    }
+  }
+
+  // @brief Destroy all elements and free heap storage, returning to the inline buffer.
+  void release() noexcept {
+    destroyN(alloc_, elements_, size_);
+    if (!isInline()) {
+      AllocTraits::deallocate(alloc_, elements_, capacity_);
+    }
+    elements_ = inlineData();
+    capacity_ = N;
+    size_ = 0;
+  }
+
+  // @brief Allocate heap storage for n (> N) elements.
+  T* allocate(size_type n) {
+    T* p = AllocTraits::allocate(alloc_, n);
+    recordAllocation(n * sizeof(T));
+    recordCapacity(n);
+    return p;
+  }
+
+  // @brief Count a transfer of the live elements to another buffer.
+  //
+  // Spilling inline elements counts; the first allocation of an empty vector does not.
+  void recordGrowth() noexcept {
+    if (!isInline() || size_ > 0) {
+      recordReallocation();
+    }
+    recordRelocation<T>(size_);
+  }
+
+  // @brief Move the elements into heap storage of exactly newCapacity slots (> N).
+  void reallocate(size_type newCapacity) {
+    T* newArray = allocate(newCapacity);
+
+    try {
+      uninitializedRelocate(alloc_, elements_, size_, newArray);
+    } catch (...) {
+      AllocTraits::deallocate(alloc_, newArray, newCapacity);
+      throw;
+    }
+    recordGrowth();
+
+    if (!isInline()) {
+      AllocTraits::deallocate(alloc_, elements_, capacity_);
+    }
+    elements_ = newArray;
+    capacity_ = newCapacity;
+  }
+
+  // @brief Compute the capacity to grow to when the vector is full.
+  size_type nextCapacity() const noexcept {
+    const size_type newCapacity = capacity_ * GROWTH_FACTOR;
+    return newCapacity > capacity_ ? newCapacity : capacity_ + 1;
+  }
+
+  // @brief Spill a full vector to a larger heap buffer and construct a new element.
+  // @param index Position of the new element (index <= size_).
+  // @param args Arguments forwarded to T's constructor.
+  // @return Pointer to the new element.
+  //
+  // The new element is constructed before the old ones move, so args may alias them.
+  template <typename... Args>
+  T* growAndEmplace(size_type index, Args&&... args) {
+    const size_type newCapacity = nextCapacity();
+    T* newArray = allocate(newCapacity);
+    T* slot = newArray + index;
+
+    try {
+      AllocTraits::construct(alloc_, slot, std::forward<Args>(args)...);
+    } catch (...) {
+      AllocTraits::deallocate(alloc_, newArray, newCapacity);
+      throw;
+    }
+
+    if constexpr (NOTHROW_RELOCATE) {
+      uninitializedRelocate(alloc_, elements_, index, newArray);
+      uninitializedRelocate(alloc_, elements_ + index, size_ - index, slot + 1);
+    } else {
+      // Copy (or, for move-only types, move) both halves before destroying anything so a
+      // throwing copy leaves the vector unchanged.
+      size_type constructed = 0;
+
+      try {
+        for (; constructed < index; ++constructed) {
+          AllocTraits::construct(
+              alloc_, newArray + constructed, std::move_if_noexcept(elements_[constructed]));
+        }
+        for (; constructed < size_; ++constructed) {
+          AllocTraits::construct(alloc_, slot + 1 + constructed - index,
+                                 std::move_if_noexcept(elements_[constructed]));
+        }
+      } catch (...) {
+        destroyN(alloc_, newArray, std::min(constructed, index));
+        if (constructed > index) {
+          destroyN(alloc_, slot + 1, constructed - index);
+        }
+        AllocTraits::destroy(alloc_, slot);
+        AllocTraits::deallocate(alloc_, newArray, newCapacity);
+        throw;
+      }
+
+      destroyN(alloc_, elements_, size_);
+    }
+    recordGrowth();
+
+    if (!isInline()) {
+      AllocTraits::deallocate(alloc_, elements_, capacity_);
+    }
+    elements_ = newArray;
+    capacity_ = newCapacity;
+    ++size_;
+
+    return slot;
+  }
+};
+
+#endif // SMALLVECTOR_H
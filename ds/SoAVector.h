@@ -0,0 +1,373 @@
+#ifndef SOAVECTOR_H
+#define SOAVECTOR_H
+
+#include "Vector.h"
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// @brief Non-owning view of a contiguous run of elements (C++17 stand-in for std::span).
+// @tparam T The element type; const-qualify for a read-only view.
+template <typename T>
+class Span {
+public:
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using reference = T&;
+  using pointer = T*;
+  using iterator = T*;
+
+  Span() noexcept : data_{nullptr}, size_{0} {
+  }
+
+  Span(T* data, size_type size) noexcept : data_{data}, size_{size} {
+  }
+
+  // @brief Access element at index (no bounds checking).
+  reference operator[](size_type index) const noexcept {
+    return data_[index];
+  }
+
+  pointer data() const noexcept {
+    return data_;
+  }
+
+  [[nodiscard]] size_type size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  iterator begin() const noexcept {
+    return data_;
+  }
+
+  iterator end() const noexcept {
+    return data_ + size_;
+  }
+
+private:
+  T* data_;
+  size_type size_;
+};
+
+// Columns start on a cache line (or the field's own alignment, if stricter)
+constexpr std::size_t SOA_COLUMN_ALIGNMENT = 64;
+
+template <typename T>
+using SoAColumn =
+    AlignedVector<T, (alignof(T) > SOA_COLUMN_ALIGNMENT ? alignof(T) : SOA_COLUMN_ALIGNMENT)>;
+
+// @brief Struct-of-arrays container: one aligned Vector per field, kept the same length.
+// @tparam Fields The field types of a row.
+//
+// A scan that reads a few fields of every row only pulls those fields' columns through
+// the cache, and each column is a dense, 64-byte-aligned array the compiler can
+// vectorize (or that can be handed to the SIMD kernels via column<I>().data()).
+//
+// Rows are exposed as tuples of references, so structured bindings work:
+//
+//   SoAVector<int, double> v;
+//   v.push_back(1, 2.5);
+//   auto [id, price] = v[0]; // int&, double&
+//
+// push_back, reserve and resize touch every column in one call and keep
+// the columns in sync even if an element constructor throws. column<I>() hands out a
+// Span over a column: elements may be modified through it, but its length is fixed.
+template <typename... Fields>
+class SoAVector {
+  static_assert(sizeof...(Fields) > 0, "SoAVector: at least one field is required");
+
+  using Columns = std::tuple<SoAColumn<Fields>...>;
+  using Indices = std::index_sequence_for<Fields...>;
+
+public:
+  // Type definitions
+  using size_type = std::size_t;
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields&...>;
+  using const_reference = std::tuple<const Fields&...>;
+
+  template <std::size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+
+  static constexpr size_type FIELD_COUNT = sizeof...(Fields);
+
+  // @brief Iterator over rows; dereferences to a tuple of references.
+  template <bool Const>
+  class RowIterator {
+    using Owner = std::conditional_t<Const, const SoAVector, SoAVector>;
+
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = SoAVector::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, const_reference, SoAVector::reference>;
+    using pointer = void;
+
+    RowIterator(Owner* owner, size_type index) noexcept : owner_{owner}, index_{index} {
+    }
+
+    reference operator*() const noexcept {
+      return (*owner_)[index_];
+    }
+
+    RowIterator& operator++() noexcept {
+      ++index_;
+      return *this;
+    }
+
+    RowIterator operator++(int) noexcept {
+      RowIterator previous = *this;
+      ++index_;
+      return previous;
+    }
+
+    friend bool operator==(const RowIterator& a, const RowIterator& b) noexcept {
+      return a.index_ == b.index_;
+    }
+
+    friend bool operator!=(const RowIterator& a, const RowIterator& b) noexcept {
+      return a.index_ != b.index_;
+    }
+
+  private:
+    Owner* owner_;
+    size_type index_;
+  };
+
+  using iterator = RowIterator<false>;
+  using const_iterator = RowIterator<true>;
+
+  // @brief Construct an empty container; no memory is allocated.
+  SoAVector() = default;
+
+  // @brief Construct an empty container with room for initialCapacity rows.
+  explicit SoAVector(size_type initialCapacity) {
+    reserve(initialCapacity);
+  }
+
+
+  // Element access
+
+  // @brief Access row at index (no bounds checking).
+  // @return Tuple of references to the row's fields.
+  reference operator[](size_type index) noexcept {
+    return rowAt(index, Indices{});
+  }
+
+  // @brief Access row at index (no bounds checking).
+  // @return Tuple of const references to the row's fields.
+  const_reference operator[](size_type index) const noexcept {
+    return rowAt(index, Indices{});
+  }
+
+  // @brief Access row at index with bounds checking.
+  // @throws std::out_of_range if index >= size.
+  reference at(size_type index) {
+    if (index >= size()) {
+      throw std::out_of_range("SoAVector::at: index out of range");
+    }
+
+    return (*this)[index];
+  }
+
+  // @brief Access row at index with bounds checking.
+  // @throws std::out_of_range if index >= size.
+  const_reference at(size_type index) const {
+    if (index >= size()) {
+      throw std::out_of_range("SoAVector::at: index out of range");
+    }
+
+    return (*this)[index];
+  }
+
+  // @brief View of column I; elements are writable, the length is fixed.
+  template <std::size_t I>
+  Span<field_type<I>> column() noexcept {
+    auto& col = std::get<I>(columns_);
+    return Span<field_type<I>>(col.data(), col.size());
+  }
+
+  // @brief Read-only view of column I.
+  template <std::size_t I>
+  Span<const field_type<I>> column() const noexcept {
+    const auto& col = std::get<I>(columns_);
+    return Span<const field_type<I>>(col.data(), col.size());
+  }
+
+  iterator begin() noexcept {
+    return iterator(this, 0);
+  }
+
+  iterator end() noexcept {
+    return iterator(this, size());
+  }
+
+  const_iterator begin() const noexcept {
+    return const_iterator(this, 0);
+  }
+
+  const_iterator end() const noexcept {
+    return const_iterator(this, size());
+  }
+
+
+  // Capacity
+
+  // @brief Check if there are no rows.
+  [[nodiscard]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  // @brief Get the number of rows.
+  [[nodiscard]] size_type size() const noexcept {
+    return std::get<0>(columns_).size();
+  }
+
+  // @brief Number of rows every column can hold without reallocating.
+  [[nodiscard]] size_type capacity() const noexcept {
+    return capacityOf(Indices{});
+  }
+
+  // @brief Reserve room for at least newCapacity rows in every column.
+  // @param newCapacity The desired capacity.
+  //
+  // If an allocation fails, columns already grown keep their new capacity; the rows
+  // are unchanged.
+  void reserve(size_type newCapacity) {
+    std::apply([newCapacity](auto&... col) { (col.reserve(newCapacity), ...); }, columns_);
+  }
+
+  // @brief Shrink every column's capacity to the number of rows.
+  void shrink_to_fit() {
+    std::apply([](auto&... col) { (col.shrink_to_fit(), ...); }, columns_);
+  }
+
+
+  // Modifiers
+
+  // @brief Remove all rows; capacity is kept.
+  void clear() noexcept {
+    std::apply([](auto&... col) { (col.clear(), ...); }, columns_);
+  }
+
+  // @brief Append a row, one value per field.
+  // @param values One argument per field, each used to construct that field.
+  //
+  // If a field constructor throws, the fields already appended are removed again.
+  template <typename... Args, typename = std::enable_if_t<sizeof...(Args) == FIELD_COUNT>>
+  void push_back(Args&&... values) {
+    appendRow(std::forward_as_tuple(std::forward<Args>(values)...), Indices{});
+  }
+
+  // @brief Append a row given as a tuple.
+  // @param row The field values.
+  void push_back(const value_type& row) {
+    appendRow(row, Indices{});
+  }
+
+  // @brief Remove the last row.
+  // @throws std::out_of_range if there are no rows.
+  void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("SoAVector::pop_back: container is empty");
+    }
+
+    std::apply([](auto&... col) { (col.pop_back(), ...); }, columns_);
+  }
+
+  // @brief Resize every column to count rows; new fields are value-initialized.
+  // @param count New number of rows.
+  //
+  // Capacity for count rows is reserved in every column before any row is added, so if
+  // a field constructor throws the rows are left as they were.
+  void resize(size_type count) {
+    if (count <= size()) {
+      std::apply([count](auto&... col) { (col.resize(count), ...); }, columns_);
+      return;
+    }
+
+    reserve(count);
+    const size_type oldSize = size();
+    try {
+      std::apply([count](auto&... col) { (col.resize(count), ...); }, columns_);
+    } catch (...) {
+      std::apply([oldSize](auto&... col) { (col.resize(oldSize), ...); }, columns_);
+      throw;
+    }
+  }
+
+  // @brief Exchange contents with another container.
+  void swap(SoAVector& other) noexcept {
+    swapColumns(other, Indices{});
+  }
+
+private:
+  Columns columns_;
+
+  template <std::size_t... I>
+  reference rowAt(size_type index, std::index_sequence<I...>) noexcept {
+    return reference(std::get<I>(columns_)[index]...);
+  }
+
+  template <std::size_t... I>
+  const_reference rowAt(size_type index, std::index_sequence<I...>) const noexcept {
+    return const_reference(std::get<I>(columns_)[index]...);
+  }
+
+  template <std::size_t... I>
+  size_type capacityOf(std::index_sequence<I...>) const noexcept {
+    size_type result = std::get<0>(columns_).capacity();
+    ((result = std::get<I>(columns_).capacity() < result ? std::get<I>(columns_).capacity()
+                                                           : result),
+     ...);
+    return result;
+  }
+
+  // Appends field by field after reserving room in every column (so only a field
+  // constructor can throw); on failure the fields appended so far are popped again.
+  template <typename Tuple, std::size_t... I>
+  void appendRow(Tuple&& values, std::index_sequence<I...> indices) {
+    const size_type oldSize = size();
+    if (oldSize == capacity()) {
+      // Growing would free any argument that refers into a column: build the row first
+      value_type row(std::get<I>(std::forward<Tuple>(values))...);
+      reserve(nextCapacity(oldSize));
+      emplaceRow(std::move(row), indices);
+    } else {
+      emplaceRow(std::forward<Tuple>(values), indices);
+    }
+  }
+
+  template <typename Tuple, std::size_t... I>
+  void emplaceRow(Tuple&& values, std::index_sequence<I...>) {
+    size_type appended = 0;
+    try {
+      ((std::get<I>(columns_).emplace_back(std::get<I>(std::forward<Tuple>(values))),
+        ++appended),
+       ...);
+    } catch (...) {
+      ((I < appended ? std::get<I>(columns_).pop_back() : void()), ...);
+      throw;
+    }
+  }
+
+  // Columns grow in lock-step, with Vector's default policy and first capacity
+  static size_type nextCapacity(size_type size) noexcept {
+    return size < 16 ? 16 : DoublingGrowth::next(size, size + 1, sizeof(value_type));
+  }
+
+  template <std::size_t... I>
+  void swapColumns(SoAVector& other, std::index_sequence<I...>) noexcept {
+    (std::get<I>(columns_).swap(std::get<I>(other.columns_)), ...);
+  }
+};
+
+#endif // SOAVECTOR_H
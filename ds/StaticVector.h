@@ -0,0 +1,497 @@
+#ifndef STATICVECTOR_H
+#define STATICVECTOR_H
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace static_vector_detail {
+  // Element types stored in a plain, always-initialized array
+  template <typename T>
+  inline constexpr bool isTrivialElement_v =
+      std::is_trivial_v<T> && std::is_copy_assignable_v<T>;
+
+  // Trivial elements: every slot holds a live object, so "constructing" an element is an
+  // assignment and destroying one is a no-op. Everything is constexpr.
+  template <typename T, std::size_t N, bool Trivial = isTrivialElement_v<T>>
+  struct Storage {
+    T elements[N]{};
+    std::size_t size = 0;
+
+    template <typename... Args>
+    constexpr void construct(std::size_t index, Args&&... args) {
+      elements[index] = T(std::forward<Args>(args)...);
+    }
+
+    constexpr void defaultConstruct(std::size_t) noexcept {
+    }
+
+    constexpr void destroy(std::size_t, std::size_t) noexcept {
+    }
+  };
+
+  // Other elements: raw storage in which [0, size) are constructed on demand
+  template <typename T, std::size_t N>
+  struct Storage<T, N, false> {
+    union {
+      T elements[N];
+    };
+    std::size_t size = 0;
+
+    Storage() noexcept {
+    }
+
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    ~Storage() {
+      destroy(0, size);
+    }
+
+    template <typename... Args>
+    void construct(std::size_t index, Args&&... args) {
+      ::new (static_cast<void*>(elements + index)) T(std::forward<Args>(args)...);
+    }
+
+    void defaultConstruct(std::size_t index) {
+      ::new (static_cast<void*>(elements + index)) T;
+    }
+
+    void destroy(std::size_t first, std::size_t last) noexcept {
+      for (std::size_t i = first; i < last; ++i) {
+        elements[i].~T();
+      }
+    }
+  };
+} // namespace static_vector_detail
+
+// @brief Vector with a fixed capacity of N elements stored inside the object.
+// @tparam T The type of elements stored in the vector.
+// @tparam N Capacity; the vector never allocates.
+//
+// Offers the same interface as Vector for bounded scratch buffers on hot paths. The
+// storage is part of the object: there is no allocator and no reallocation, and
+// pointers to an element stay valid until it is removed. Growing past N throws
+// std::length_error; try_push_back and try_emplace_back return nullptr instead.
+//
+// For trivial element types (integers, floating point, plain structs) all N slots are
+// value-initialized up front and every member is constexpr, even under C++17: a
+// constexpr function can fill a StaticVector and its result can initialize a constexpr
+// variable, so lookup tables are built by the compiler rather than during static
+// initialization. Other element types live in raw storage and are constructed in place.
+//
+// Like Vector, a moved-from StaticVector is left empty. Moving is O(size).
+template <typename T, std::size_t N>
+class StaticVector {
+  static_assert(N > 0, "StaticVector: capacity must be positive");
+
+  using Storage = static_vector_detail::Storage<T, N>;
+
+public:
+  // Type definitions
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  // @brief Construct an empty vector.
+  constexpr StaticVector() noexcept = default;
+
+  // @brief Construct a vector with count copies of value.
+  // @param count Number of elements to construct.
+  // @param value Value to initialize elements with.
+  // @throws std::length_error if count > N.
+  constexpr StaticVector(size_type count, const T& value) : storage_() {
+    checkRoom(count, "StaticVector: count exceeds capacity");
+    while (storage_.size < count) {
+      appendUnchecked(value);
+    }
+  }
+
+  // @brief Copy constructor - copies the live elements.
+  // @param other The vector to copy from.
+  constexpr StaticVector(const StaticVector& other) : storage_() {
+    for (size_type i = 0; i < other.size(); ++i) {
+      appendUnchecked(other[i]);
+    }
+  }
+
+  // @brief Move constructor - moves the elements one by one, leaving other empty.
+  // @param other The vector to move from.
+  constexpr StaticVector(StaticVector&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>)
+      : storage_() {
+    for (size_type i = 0; i < other.size(); ++i) {
+      appendUnchecked(std::move(other[i]));
+    }
+    other.clear();
+  }
+
+  // @brief Copy assignment operator.
+  // @param other The vector to copy from.
+  // @return Reference to this vector.
+  //
+  // Basic guarantee: if a copy throws, this vector holds a prefix of other.
+  constexpr StaticVector& operator=(const StaticVector& other) {
+    if (this != &other) {
+      clear();
+      for (size_type i = 0; i < other.size(); ++i) {
+        appendUnchecked(other[i]);
+      }
+    }
+
+    return *this;
+  }
+
+  // @brief Move assignment operator.
+  // @param other The vector to move from; left empty.
+  // @return Reference to this vector.
+  constexpr StaticVector& operator=(StaticVector&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      clear();
+      for (size_type i = 0; i < other.size(); ++i) {
+        appendUnchecked(std::move(other[i]));
+      }
+      other.clear();
+    }
+
+    return *this;
+  }
+
+
+  // Element access
+
+  // @brief Access element at index (no bounds checking).
+  // @param index The index of the element.
+  // @return Reference to the element.
+  constexpr reference operator[](size_type index) noexcept {
+    return storage_.elements[index];
+  }
+
+  // @brief Access element at index (no bounds checking).
+  // @param index The index of the element.
+  // @return Const reference to the element.
+  constexpr const_reference operator[](size_type index) const noexcept {
+    return storage_.elements[index];
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @param index The index of the element.
+  // @return Reference to the element.
+  // @throws std::out_of_range if index >= size.
+  constexpr reference at(size_type index) {
+    if (index >= size()) {
+      throw std::out_of_range("StaticVector::at: index out of range");
+    }
+
+    return storage_.elements[index];
+  }
+
+  // @brief Access element at index with bounds checking.
+  // @param index The index of the element.
+  // @return Const reference to the element.
+  // @throws std::out_of_range if index >= size.
+  constexpr const_reference at(size_type index) const {
+    if (index >= size()) {
+      throw std::out_of_range("StaticVector::at: index out of range");
+    }
+
+    return storage_.elements[index];
+  }
+
+  // @brief Access the first element.
+  // @throws std::out_of_range if vector is empty.
+  constexpr reference front() {
+    if (empty()) {
+      throw std::out_of_range("StaticVector::front: vector is empty");
+    }
+
+    return storage_.elements[0];
+  }
+
+  // @brief Access the first element.
+  // @throws std::out_of_range if vector is empty.
+  constexpr const_reference front() const {
+    if (empty()) {
+      throw std::out_of_range("StaticVector::front: vector is empty");
+    }
+
+    return storage_.elements[0];
+  }
+
+  // @brief Access the last element.
+  // @throws std::out_of_range if vector is empty.
+  constexpr reference back() {
+    if (empty()) {
+      throw std::out_of_range("StaticVector::back: vector is empty");
+    }
+
+    return storage_.elements[size() - 1];
+  }
+
+  // @brief Access the last element.
+  // @throws std::out_of_range if vector is empty.
+  constexpr const_reference back() const {
+    if (empty()) {
+      throw std::out_of_range("StaticVector::back: vector is empty");
+    }
+
+    return storage_.elements[size() - 1];
+  }
+
+  // @brief Get pointer to the underlying array.
+  constexpr pointer data() noexcept {
+    return storage_.elements;
+  }
+
+  // @brief Get pointer to the underlying array.
+  constexpr const_pointer data() const noexcept {
+    return storage_.elements;
+  }
+
+  // @brief Get iterator to the beginning.
+  constexpr iterator begin() noexcept {
+    return storage_.elements;
+  }
+
+  // @brief Get iterator to the end.
+  constexpr iterator end() noexcept {
+    return storage_.elements + size();
+  }
+
+  // @brief Get const iterator to the beginning.
+  constexpr const_iterator begin() const noexcept {
+    return storage_.elements;
+  }
+
+  // @brief Get const iterator to the end.
+  constexpr const_iterator end() const noexcept {
+    return storage_.elements + size();
+  }
+
+  // @brief Get const iterator to the beginning.
+  constexpr const_iterator cbegin() const noexcept {
+    return begin();
+  }
+
+  // @brief Get const iterator to the end.
+  constexpr const_iterator cend() const noexcept {
+    return end();
+  }
+
+
+  // Capacity
+
+  // @brief Check if the vector is empty.
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return storage_.size == 0;
+  }
+
+  // @brief Get the number of elements in the vector.
+  [[nodiscard]] constexpr size_type size() const noexcept {
+    return storage_.size;
+  }
+
+  // @brief Get the capacity, which is always N.
+  [[nodiscard]] constexpr size_type capacity() const noexcept {
+    return N;
+  }
+
+  // @brief Check that newCapacity elements fit; the storage never changes.
+  // @param newCapacity The desired capacity.
+  // @throws std::length_error if newCapacity > N.
+  constexpr void reserve(size_type newCapacity) const {
+    checkRoom(newCapacity, "StaticVector::reserve: capacity exceeded");
+  }
+
+  // @brief No-op: the capacity is fixed.
+  constexpr void shrink_to_fit() const noexcept {
+  }
+
+
+  // Modifiers
+
+  // @brief Clear the vector, removing all elements.
+  constexpr void clear() noexcept {
+    storage_.destroy(0, storage_.size);
+    storage_.size = 0;
+  }
+
+  // @brief Add an element to the end of the vector (copy).
+  // @param item The element to add.
+  // @throws std::length_error if the vector is full.
+  constexpr void push_back(const T& item) {
+    emplace_back(item);
+  }
+
+  // @brief Add an element to the end of the vector (move).
+  // @param item The element to add.
+  // @throws std::length_error if the vector is full.
+  constexpr void push_back(T&& item) {
+    emplace_back(std::move(item));
+  }
+
+  // @brief Construct an element in place at the end of the vector.
+  // @param args Arguments forwarded to T's constructor.
+  // @return Reference to the new element.
+  // @throws std::length_error if the vector is full.
+  template <typename... Args>
+  constexpr reference emplace_back(Args&&... args) {
+    checkRoom(size() + 1, "StaticVector::emplace_back: vector is full");
+    return appendUnchecked(std::forward<Args>(args)...);
+  }
+
+  // @brief Add an element to the end unless the vector is full (copy).
+  // @param item The element to add.
+  // @return Pointer to the new element, or nullptr if the vector was full.
+  constexpr pointer try_push_back(const T& item) {
+    return try_emplace_back(item);
+  }
+
+  // @brief Add an element to the end unless the vector is full (move).
+  // @param item The element to add; left untouched if the vector is full.
+  // @return Pointer to the new element, or nullptr if the vector was full.
+  constexpr pointer try_push_back(T&& item) {
+    return try_emplace_back(std::move(item));
+  }
+
+  // @brief Construct an element in place at the end unless the vector is full.
+  // @param args Arguments forwarded to T's constructor.
+  // @return Pointer to the new element, or nullptr if the vector was full.
+  template <typename... Args>
+  constexpr pointer try_emplace_back(Args&&... args) {
+    if (size() == N) {
+      return nullptr;
+    }
+
+    return &appendUnchecked(std::forward<Args>(args)...);
+  }
+
+  // @brief Construct an element in place before pos.
+  // @param pos Position to insert before (begin() <= pos <= end()).
+  // @param args Arguments forwarded to T's constructor.
+  // @return Iterator to the new element.
+  // @throws std::length_error if the vector is full.
+  //
+  // Elements at and after pos are shifted one slot to the right.
+  template <typename... Args>
+  constexpr iterator emplace(const_iterator pos, Args&&... args) {
+    const auto index = static_cast<size_type>(pos - cbegin());
+    checkRoom(size() + 1, "StaticVector::emplace: vector is full");
+
+    if (index == size()) {
+      appendUnchecked(std::forward<Args>(args)...);
+      return begin() + index;
+    }
+
+    // Build the value first: args may alias an element that is about to shift.
+    T item(std::forward<Args>(args)...);
+
+    appendUnchecked(std::move(back()));
+    for (size_type i = size() - 2; i > index; --i) { // std::move_backward is not constexpr
+      storage_.elements[i] = std::move(storage_.elements[i - 1]);
+    }
+    storage_.elements[index] = std::move(item);
+
+    return begin() + index;
+  }
+
+  // @brief Remove the last element.
+  // @throws std::out_of_range if vector is empty.
+  constexpr void pop_back() {
+    if (empty()) {
+      throw std::out_of_range("StaticVector::pop_back: vector is empty");
+    }
+
+    --storage_.size;
+    storage_.destroy(storage_.size, storage_.size + 1);
+  }
+
+  // @brief Resize the vector to contain count elements.
+  // @param count New size.
+  // @throws std::length_error if count > N.
+  //
+  // New elements are value-initialized; if count < size, the vector is truncated.
+  constexpr void resize(size_type count) {
+    checkRoom(count, "StaticVector::resize: capacity exceeded");
+    truncate(count);
+    while (storage_.size < count) {
+      appendUnchecked();
+    }
+  }
+
+  // @brief Resize the vector to contain count elements.
+  // @param count New size.
+  // @param value Value to initialize new elements with.
+  // @throws std::length_error if count > N.
+  constexpr void resize(size_type count, const T& value) {
+    checkRoom(count, "StaticVector::resize: capacity exceeded");
+    truncate(count);
+    while (storage_.size < count) {
+      appendUnchecked(value);
+    }
+  }
+
+  // @brief Resize the vector, leaving new trivially constructible elements uninitialized.
+  // @param count New size.
+  // @throws std::length_error if count > N.
+  //
+  // For trivial element types the new elements keep whatever values their slots last held.
+  constexpr void resize_default_init(size_type count) {
+    checkRoom(count, "StaticVector::resize_default_init: capacity exceeded");
+    truncate(count);
+    for (; storage_.size < count; ++storage_.size) {
+      storage_.defaultConstruct(storage_.size);
+    }
+  }
+
+  // @brief Swap elements with another vector (O(max(size(), other.size()))).
+  // @param other The vector to swap with.
+  constexpr void swap(StaticVector& other) noexcept(std::is_nothrow_swappable_v<T> &&
+                                                    std::is_nothrow_move_constructible_v<T>) {
+    StaticVector& larger = size() >= other.size() ? *this : other;
+    StaticVector& smaller = size() >= other.size() ? other : *this;
+    const size_type common = smaller.size();
+
+    for (size_type i = 0; i < common; ++i) {
+      using std::swap;
+      swap(storage_.elements[i], other.storage_.elements[i]);
+    }
+    for (size_type i = common; i < larger.size(); ++i) {
+      smaller.appendUnchecked(std::move(larger[i]));
+    }
+    larger.truncate(common);
+  }
+
+private:
+  Storage storage_;
+
+  static constexpr void checkRoom(size_type count, const char* message) {
+    if (count > N) {
+      throw std::length_error(message);
+    }
+  }
+
+  template <typename... Args>
+  constexpr reference appendUnchecked(Args&&... args) {
+    storage_.construct(storage_.size, std::forward<Args>(args)...);
+    return storage_.elements[storage_.size++];
+  }
+
+  constexpr void truncate(size_type count) noexcept {
+    if (count < storage_.size) {
+      storage_.destroy(count, storage_.size);
+      storage_.size = count;
+    }
+  }
+};
+
+#endif // STATICVECTOR_H
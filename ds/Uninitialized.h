@@ -0,0 +1,113 @@
+#ifndef UNINITIALIZED_H
+#define UNINITIALIZED_H
+
+#include "Constexpr.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Allocator-aware element lifetime helpers for containers that manage raw storage.
+//
+// Every construction and destruction goes through std::allocator_traits so that
+// allocators with custom construct()/destroy() (e.g. std::pmr::polymorphic_allocator,
+// which performs uses-allocator construction) are honoured. The constructing helpers
+// give the strong guarantee: if an element constructor throws, the elements already
+// built are destroyed and the destination is left as raw storage.
+
+
+// @brief Destroy count live elements, leaving raw storage behind.
+// @param alloc The allocator that constructed the elements.
+// @param first Start of the elements.
+// @param count Number of elements to destroy.
+template <typename Alloc, typename T>
+DS_CONSTEXPR20 void destroyN(Alloc& alloc, T* first, std::size_t count) noexcept {
+  for (std::size_t i = 0; i < count; ++i) {
+    std::allocator_traits<Alloc>::destroy(alloc, first + i);
+  }
+}
+
+// @brief Copy-construct count elements from an input sequence into raw storage.
+// @param alloc The allocator used for construction.
+// @param first Start of the source sequence.
+// @param count Number of elements to copy.
+// @param dest Start of the uninitialized destination.
+// @return Iterator past the last source element read.
+template <typename Alloc, typename InputIt, typename T>
+DS_CONSTEXPR20 InputIt uninitializedCopyN(Alloc& alloc, InputIt first, std::size_t count,
+                                          T* dest) {
+  std::size_t constructed = 0;
+
+  try {
+    for (; constructed < count; ++constructed, ++first) {
+      std::allocator_traits<Alloc>::construct(alloc, dest + constructed, *first);
+    }
+  } catch (...) {
+    destroyN(alloc, dest, constructed);
+    throw;
+  }
+
+  return first;
+}
+
+// @brief Move-construct count elements into raw storage; the sources stay alive.
+// @param alloc The allocator used for construction.
+// @param first Start of the source elements.
+// @param count Number of elements to move.
+// @param dest Start of the uninitialized destination.
+template <typename Alloc, typename T>
+DS_CONSTEXPR20 void uninitializedMoveN(Alloc& alloc, T* first, std::size_t count,
+                                       T* dest) {
+  std::size_t constructed = 0;
+
+  try {
+    for (; constructed < count; ++constructed) {
+      std::allocator_traits<Alloc>::construct(
+          alloc, dest + constructed, std::move(first[constructed]));
+    }
+  } catch (...) {
+    destroyN(alloc, dest, constructed);
+    throw;
+  }
+}
+
+// @brief Construct count copies of value in raw storage.
+// @param alloc The allocator used for construction.
+// @param dest Start of the uninitialized destination.
+// @param count Number of elements to construct.
+// @param value The value to copy.
+template <typename Alloc, typename T>
+DS_CONSTEXPR20 void uninitializedFillN(Alloc& alloc, T* dest, std::size_t count,
+                                       const T& value) {
+  std::size_t constructed = 0;
+
+  try {
+    for (; constructed < count; ++constructed) {
+      std::allocator_traits<Alloc>::construct(alloc, dest + constructed, value);
+    }
+  } catch (...) {
+    destroyN(alloc, dest, constructed);
+    throw;
+  }
+}
+
+// @brief Value-initialize count elements in raw storage.
+// @param alloc The allocator used for construction.
+// @param dest Start of the uninitialized destination.
+// @param count Number of elements to construct.
+template <typename Alloc, typename T>
+DS_CONSTEXPR20 void uninitializedValueConstructN(Alloc& alloc, T* dest,
+                                                 std::size_t count) {
+  std::size_t constructed = 0;
+
+  try {
+    for (; constructed < count; ++constructed) {
+      std::allocator_traits<Alloc>::construct(alloc, dest + constructed);
+    }
+  } catch (...) {
+    destroyN(alloc, dest, constructed);
+    throw;
+  }
+}
+
+#endif // UNINITIALIZED_H
@@ -1,17 +1,80 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#include "AlignedAllocator.h"
+#include "ContainerStats.h"
+#include "GrowthPolicy.h"
+#include "Relocate.h"
+#include "Uninitialized.h"
+
 #include <algorithm>
 #include <cstddef>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
-template <typename T>
-class Vector {
+namespace vector_detail {
+  template <typename It, typename = void>
+  struct IteratorCategory {
+    using type = void;
+  };
+
+  template <typename It>
+  struct IteratorCategory<It,
+                          std::void_t<typename std::iterator_traits<It>::iterator_category>> {
+    using type = typename std::iterator_traits<It>::iterator_category;
+  };
+
+  // Selects the range overloads over the (count, value) ones
+  template <typename It>
+  inline constexpr bool isInputIterator_v =
+      std::is_convertible_v<typename IteratorCategory<It>::type, std::input_iterator_tag>;
+
+  // Ranges whose length is known before the first element is read
+  template <typename It>
+  inline constexpr bool isForwardIterator_v =
+      std::is_convertible_v<typename IteratorCategory<It>::type, std::forward_iterator_tag>;
+} // namespace vector_detail
+
+// @brief Dynamically-resizable contiguous array.
+// @tparam T The type of elements stored in the vector.
+//
+// @tparam Allocator Allocator used for storage and element construction.
+// @tparam Growth Growth policy deciding the new capacity when the vector is full
+//         (see GrowthPolicy.h).
+//
+// Storage is allocated uninitialized; only the live elements [0, size) are ever
+// constructed. Slots in [size, capacity) hold no objects. All allocation and element
+// construction go through std::allocator_traits, including the propagation traits on
+// copy, move and swap, so std::pmr::polymorphic_allocator and custom arena allocators
+// plug in directly.
+//
+// With DS_CONTAINER_STATS defined, every instance counts its allocations, reallocations
+// and element transfers (see ContainerStats.h); stats() reads them.
+//
+// Under C++20 every member is constexpr (see Constexpr.h), so a Vector can be built and
+// consumed inside a constant expression, e.g. to compute a lookup table.
+//
+// The range and count forms of insert/append/assign size the result up front: they
+// allocate at most once and shift the tail with a single relocation, so loading n
+// elements from a forward range into an empty vector is one allocation of n slots.
+template <typename T, typename Allocator = std::allocator<T>, typename Growth = DoublingGrowth>
+class Vector : private ContainerStatsRecorder {
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+                "Vector: Allocator::value_type must be T");
+  static_assert(std::is_same_v<typename AllocTraits::pointer, T*>,
+                "Vector: Allocator must use raw pointers");
+
 public:
   // Type definitions
   using value_type = T;
+  using allocator_type = Allocator;
+  using growth_policy = Growth;
   using size_type = std::size_t;
   using difference_type = std::ptrdiff_t;
   using reference = T&;
@@ -21,36 +84,92 @@ public:
   using iterator = T*;
   using const_iterator = const T*;
 
+  // @brief Allocation statistics of this vector (all zero unless DS_CONTAINER_STATS).
+  using ContainerStatsRecorder::stats;
+
   // @brief Construct an empty vector with optional initial capacity.
   // @param initialCapacity Initial capacity (default: 0, will allocate on first insertion).
-  explicit Vector(size_type initialCapacity = 0)
-      : elements_{initialCapacity > 0 ? std::make_unique<T[]>(initialCapacity) : nullptr},
-        capacity_{initialCapacity}, size_{0} {
+  // @param alloc Allocator instance to use.
+  explicit DS_CONSTEXPR20 Vector(size_type initialCapacity = 0,
+                                 const Allocator& alloc = Allocator())
+      : alloc_{alloc}, elements_{allocate(initialCapacity)}, capacity_{initialCapacity},
+        size_{0} {
+  }
+
+  // @brief Construct an empty vector using the given allocator.
+  // @param alloc Allocator instance to use.
+  explicit DS_CONSTEXPR20 Vector(const Allocator& alloc) : Vector(0, alloc) {
   }
 
   // @brief Construct a vector with n default-constructed elements.
   // @param count Number of elements to construct.
   // @param value Value to initialize elements with.
-  Vector(size_type count, const T& value)
-      : elements_{std::make_unique<T[]>(count)}, capacity_{count}, size_{count} {
-    std::fill_n(elements_.get(), count, value);
+  // @param alloc Allocator instance to use.
+  DS_CONSTEXPR20 Vector(size_type count, const T& value, const Allocator& alloc = Allocator())
+      : alloc_{alloc}, elements_{allocate(count)}, capacity_{count}, size_{0} {
+    try {
+      uninitializedFillN(alloc_, elements_, count, value);
+    } catch (...) {
+      deallocate(elements_, capacity_);
+      throw;
+    }
+    size_ = count;
+  }
+
+  // @brief Construct a vector holding copies of the elements of [first, last).
+  // @param first Start of the source range.
+  // @param last End of the source range.
+  // @param alloc Allocator instance to use.
+  //
+  // A forward range is allocated in one step, to exactly its length.
+  template <typename InputIt,
+            typename = std::enable_if_t<vector_detail::isInputIterator_v<InputIt>>>
+  DS_CONSTEXPR20 Vector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+      : Vector(alloc) {
+    assign(first, last);
   }
 
   // @brief Copy constructor - performs deep copy.
   // @param other The vector to copy from.
-  Vector(const Vector& other)
-      : elements_{other.size_ > 0 ? std::make_unique<T[]>(other.capacity_) : nullptr},
-        capacity_{other.capacity_}, size_{other.size_} {
-    std::copy_n(other.elements_.get(), size_, elements_.get());
+  //
+  // The allocator is obtained through select_on_container_copy_construction.
+  DS_CONSTEXPR20 Vector(const Vector& other)
+      : Vector(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+  }
+
+  // @brief Copy constructor with an explicit allocator - performs deep copy.
+  // @param other The vector to copy from.
+  // @param alloc Allocator instance to use.
+  DS_CONSTEXPR20 Vector(const Vector& other, const Allocator& alloc)
+      : alloc_{alloc}, elements_{other.size_ > 0 ? allocate(other.capacity_) : nullptr},
+        capacity_{other.size_ > 0 ? other.capacity_ : 0}, size_{0} {
+    try {
+      uninitializedCopyN(alloc_, other.elements_, other.size_, elements_);
+    } catch (...) {
+      deallocate(elements_, capacity_);
+      throw;
+    }
+    size_ = other.size_;
+    recordCopies(size_);
   }
 
   // @brief Copy assignment operator - performs deep copy.
   // @param other The vector to copy from.
   // @return Reference to this vector.
-  Vector& operator=(const Vector& other) {
+  //
+  // Adopts other's allocator if propagate_on_container_copy_assignment is true.
+  DS_CONSTEXPR20 Vector& operator=(const Vector& other) {
     if (this != &other) {
-      Vector temp(other);
-      swap(temp);
+      if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+        if (alloc_ != other.alloc_) {
+          release(); // Storage must be returned to the allocator that provided it
+        }
+        alloc_ = other.alloc_;
+      }
+
+      Vector temp(other, alloc_);
+      swapStorage(temp);
+      absorbStats(temp);
     }
 
     return *this;
@@ -58,30 +177,65 @@ public:
 
   // @brief Move constructor.
   // @param other The vector to move from.
-  Vector(Vector&& other) noexcept
-      : elements_{std::move(other.elements_)}, capacity_{other.capacity_}, size_{other.size_} {
+  DS_CONSTEXPR20 Vector(Vector&& other) noexcept
+      : alloc_{std::move(other.alloc_)}, elements_{other.elements_}, capacity_{other.capacity_},
+        size_{other.size_} {
+    other.elements_ = nullptr;
     other.capacity_ = 0;
     other.size_ = 0;
   }
 
+  // @brief Move constructor with an explicit allocator.
+  // @param other The vector to move from.
+  // @param alloc Allocator instance to use.
+  //
+  // Steals other's storage if the allocators compare equal; otherwise the elements
+  // are moved one by one into storage obtained from alloc.
+  DS_CONSTEXPR20 Vector(Vector&& other, const Allocator& alloc)
+      : alloc_{alloc}, elements_{nullptr}, capacity_{0}, size_{0} {
+    if (alloc_ == other.alloc_) {
+      swapStorage(other);
+    } else {
+      moveElementsFrom(other);
+    }
+  }
+
   // @brief Move assignment operator.
   // @param other The vector to move from.
   // @return Reference to this vector.
-  Vector& operator=(Vector&& other) noexcept {
+  //
+  // Steals other's storage when the allocator propagates or compares equal. Otherwise
+  // the elements are moved one by one into storage from this vector's allocator.
+  DS_CONSTEXPR20 Vector& operator=(Vector&& other) noexcept(
+      AllocTraits::propagate_on_container_move_assignment::value ||
+      AllocTraits::is_always_equal::value) {
     if (this != &other) {
-      elements_ = std::move(other.elements_);
-      capacity_ = other.capacity_;
-      size_ = other.size_;
-
-      other.capacity_ = 0;
-      other.size_ = 0;
+      if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+        release();
+        alloc_ = std::move(other.alloc_);
+        swapStorage(other);
+      } else if (alloc_ == other.alloc_) {
+        release();
+        swapStorage(other);
+      } else {
+        clear();
+        moveElementsFrom(other);
+      }
     }
 
     return *this;
   }
 
-  // Destructor - unique_ptr handles cleanup automatically
-  ~Vector() = default;
+  // @brief Destructor - destroys live elements and frees the storage.
+  DS_CONSTEXPR20 ~Vector() {
+    release();
+  }
+
+
+  // @brief Get a copy of the allocator.
+  DS_CONSTEXPR20 allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }
 
 
   // Element access
@@ -89,14 +243,14 @@ public:
   // @brief Access element at index (no bounds checking).
   // @param index The index of the element.
   // @return Reference to the element.
-  reference operator[](size_type index) noexcept {
+  DS_CONSTEXPR20 reference operator[](size_type index) noexcept {
     return elements_[index];
   }
 
   // @brief Access element at index (no bounds checking).
   // @param index The index of the element.
   // @return Const reference to the element.
-  const_reference operator[](size_type index) const noexcept {
+  DS_CONSTEXPR20 const_reference operator[](size_type index) const noexcept {
     return elements_[index];
   }
 
@@ -104,7 +258,7 @@ public:
   // @param index The index of the element.
   // @return Reference to the element.
   // @throws std::out_of_range if index >= size.
-  reference at(size_type index) {
+  DS_CONSTEXPR20 reference at(size_type index) {
     if (index >= size_) {
       throw std::out_of_range("Vector::at: index out of range");
     }
@@ -116,7 +270,7 @@ public:
   // @param index The index of the element.
   // @return Const reference to the element.
   // @throws std::out_of_range if index >= size.
-  const_reference at(size_type index) const {
+  DS_CONSTEXPR20 const_reference at(size_type index) const {
     if (index >= size_) {
       throw std::out_of_range("Vector::at: index out of range");
     }
@@ -127,7 +281,7 @@ public:
   // @brief Access the first element.
   // @return Reference to the first element.
   // @throws std::out_of_range if vector is empty.
-  reference front() {
+  DS_CONSTEXPR20 reference front() {
     if (empty()) {
       throw std::out_of_range("Vector::front: vector is empty");
     }
@@ -138,7 +292,7 @@ public:
   // @brief Access the first element.
   // @return Const reference to the first element.
   // @throws std::out_of_range if vector is empty.
-  const_reference front() const {
+  DS_CONSTEXPR20 const_reference front() const {
     if (empty()) {
       throw std::out_of_range("Vector::front: vector is empty");
     }
@@ -149,7 +303,7 @@ public:
   // @brief Access the last element.
   // @return Reference to the last element.
   // @throws std::out_of_range if vector is empty.
-  reference back() {
+  DS_CONSTEXPR20 reference back() {
     if (empty()) {
       throw std::out_of_range("Vector::back: vector is empty");
     }
@@ -160,7 +314,7 @@ public:
   // @brief Access the last element.
   // @return Const reference to the last element.
   // @throws std::out_of_range if vector is empty.
-  const_reference back() const {
+  DS_CONSTEXPR20 const_reference back() const {
     if (empty()) {
       throw std::out_of_range("Vector::back: vector is empty");
     }
@@ -170,61 +324,61 @@ public:
 
   // @brief Get pointer to underlying array.
   // @return Pointer to the data.
-  pointer data() noexcept {
-    return elements_.get();
+  DS_CONSTEXPR20 pointer data() noexcept {
+    return elements_;
   }
 
   // @brief Get pointer to underlying array.
   // @return Const pointer to the data.
-  const_pointer data() const noexcept {
-    return elements_.get();
+  DS_CONSTEXPR20 const_pointer data() const noexcept {
+    return elements_;
   }
 
   // @brief Get iterator to the beginning.
-  iterator begin() noexcept {
-    return elements_.get();
+  DS_CONSTEXPR20 iterator begin() noexcept {
+    return elements_;
   }
 
   // @brief Get iterator to the end.
-  iterator end() noexcept {
-    return elements_.get() + size_;
+  DS_CONSTEXPR20 iterator end() noexcept {
+    return elements_ + size_;
   }
 
   // @brief Get const iterator to the beginning.
-  const_iterator begin() const noexcept {
-    return elements_.get();
+  DS_CONSTEXPR20 const_iterator begin() const noexcept {
+    return elements_;
   }
 
   // @brief Get const iterator to the end.
-  const_iterator end() const noexcept {
-    return elements_.get() + size_;
+  DS_CONSTEXPR20 const_iterator end() const noexcept {
+    return elements_ + size_;
   }
 
   // @brief Get const iterator to the beginning.
-  const_iterator cbegin() const noexcept {
-    return elements_.get();
+  DS_CONSTEXPR20 const_iterator cbegin() const noexcept {
+    return elements_;
   }
 
   // @brief Get const iterator to the end.
-  const_iterator cend() const noexcept {
-    return elements_.get() + size_;
+  DS_CONSTEXPR20 const_iterator cend() const noexcept {
+    return elements_ + size_;
   }
 
   // @brief Check if the vector is empty.
   // @return True if size is 0, false otherwise.
-  [[nodiscard]] bool empty() const noexcept {
+  [[nodiscard]] DS_CONSTEXPR20 bool empty() const noexcept {
     return size_ == 0;
   }
 
   // @brief Get the number of elements in the vector.
   // @return The size.
-  [[nodiscard]] size_type size() const noexcept {
+  [[nodiscard]] DS_CONSTEXPR20 size_type size() const noexcept {
     return size_;
   }
 
   // @brief Get the current capacity of the internal array.
   // @return The capacity.
-  [[nodiscard]] size_type capacity() const noexcept {
+  [[nodiscard]] DS_CONSTEXPR20 size_type capacity() const noexcept {
     return capacity_;
   }
 
@@ -233,131 +387,687 @@ public:
   //
   // If new capacity > current capacity, reallocates to capacity of at least newCapacity.
   // Does not change the size or contents of the vector.
-  void reserve(size_type newCapacity) {
+  DS_CONSTEXPR20 void reserve(size_type newCapacity) {
     if (newCapacity <= capacity_) {
       return;
     }
 
-    auto newArray = std::make_unique<T[]>(newCapacity);
-
-    // Move elements to new array
-    for (size_type i = 0; i < size_; ++i) {
-      newArray[i] = std::move(elements_[i]);
-    }
-
-    elements_ = std::move(newArray);
-    capacity_ = newCapacity;
+    reallocate(newCapacity);
   }
 
   // @brief Shrink the capacity to fit the current size.
   //
   // Reduce memory usage by reallocating to the minimum capacity.
-  void shrink_to_fit() {
+  DS_CONSTEXPR20 void shrink_to_fit() {
     if (capacity_ > size_) {
-      size_type newCapacity = size_;
-
-      if (newCapacity == 0) {
-        elements_.reset();
-        capacity_ = 0;
-      } else {
-        auto newArray = std::make_unique<T[]>(newCapacity);
-        for (size_type i = 0; i < size_; ++i) {
-          newArray[i] = std::move(elements_[i]);
-        }
-
-        elements_ = std::move(newArray);
-        capacity_ = newCapacity;
-      }
+      reallocate(size_);
     }
   }
 
   // @brief Clear the vector, removing all elements.
   //
-  // Size becomes 0, but capacity remains unchanged.
-  void clear() noexcept {
-    std::destroy_n(elements_.get(), size_);
+  // Size becomes 0, but capacity remains unchanged. Destroyed slots return to
+  // raw storage.
+  DS_CONSTEXPR20 void clear() noexcept {
+    destroyN(alloc_, elements_, size_);
     size_ = 0;
   }
 
+  // @brief Replace the contents with copies of the elements of [first, last).
+  // @param first Start of the source range (may lie within this vector).
+  // @param last End of the source range.
+  //
+  // A forward range longer than the capacity is copied into a new buffer of exactly its
+  // length, which then replaces the old one; otherwise the elements are assigned in
+  // place and the excess destroyed.
+  template <typename InputIt,
+            typename = std::enable_if_t<vector_detail::isInputIterator_v<InputIt>>>
+  DS_CONSTEXPR20 void assign(InputIt first, InputIt last) {
+    if constexpr (vector_detail::isForwardIterator_v<InputIt>) {
+      const auto count = static_cast<size_type>(std::distance(first, last));
+      if (count > capacity_) {
+        Vector temp(count, alloc_);
+        uninitializedCopyN(alloc_, first, count, temp.elements_);
+        temp.size_ = count;
+        release();
+        swapStorage(temp);
+        absorbStats(temp);
+        return;
+      }
+
+      // A source inside this vector starts at or after elements_, so copying forward
+      // never overwrites an element before it is read
+      const size_type assigned = std::min(count, size_);
+      std::copy_n(first, assigned, elements_);
+      std::advance(first, assigned);
+      if (count > size_) {
+        uninitializedCopyN(alloc_, first, count - size_, elements_ + size_);
+      } else {
+        destroyN(alloc_, elements_ + count, size_ - count);
+      }
+      size_ = count;
+    } else {
+      clear();
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    }
+  }
+
+  // @brief Replace the contents with count copies of value.
+  // @param count New size.
+  // @param value The value to copy (may be an element of this vector).
+  DS_CONSTEXPR20 void assign(size_type count, const T& value) {
+    if (count > capacity_) {
+      Vector temp(count, value, alloc_);
+      release();
+      swapStorage(temp);
+      absorbStats(temp);
+      return;
+    }
+
+    if (pointsInto(&value)) {
+      const T copy(value);
+      assign(count, copy);
+      return;
+    }
+
+    std::fill_n(elements_, std::min(count, size_), value);
+    if (count > size_) {
+      uninitializedFillN(alloc_, elements_ + size_, count - size_, value);
+    } else {
+      destroyN(alloc_, elements_ + count, size_ - count);
+    }
+    size_ = count;
+  }
+
   // @brief Add an element to the end of the vector (copy).
   // @param item The element to add.
   //
   // Time complexity: O(1) amortized.
   //
-  void push_back(const T& item) {
-    ensureCapacity();
-    elements_[size_++] = item;
+  DS_CONSTEXPR20 void push_back(const T& item) {
+    emplace_back(item);
   }
 
   // @brief Add an element to the end of the vector (move).
   // @param item The element to add.
   //
   // Time complexity: O(1) amortized.
-  void push_back(T&& item) {
-    ensureCapacity();
-    elements_[size_++] = std::move(item);
+  DS_CONSTEXPR20 void push_back(T&& item) {
+    emplace_back(std::move(item));
+  }
+
+  // @brief Construct an element in place at the end of the vector.
+  // @param args Arguments forwarded to T's constructor.
+  // @return Reference to the new element.
+  //
+  // The arguments may refer to elements of this vector; on reallocation the new
+  // element is constructed before the existing ones are moved.
+  // Time complexity: O(1) amortized.
+  template <typename... Args>
+  DS_CONSTEXPR20 reference emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      return *growAndEmplace(size_, std::forward<Args>(args)...);
+    }
+
+    AllocTraits::construct(alloc_, elements_ + size_, std::forward<Args>(args)...);
+    return elements_[size_++];
+  }
+
+  // @brief Append copies of the elements of [first, last).
+  // @param first Start of the source range (may lie within this vector).
+  // @param last End of the source range.
+  //
+  // For a forward range the vector grows at most once, to the capacity the growth
+  // policy picks for the final size. If a copy throws, the vector is unchanged.
+  template <typename InputIt,
+            typename = std::enable_if_t<vector_detail::isInputIterator_v<InputIt>>>
+  DS_CONSTEXPR20 void append(InputIt first, InputIt last) {
+    insert(cend(), first, last);
+  }
+
+  // @brief Append count copies of value.
+  // @param count Number of copies.
+  // @param value The value to copy (may be an element of this vector).
+  DS_CONSTEXPR20 void append(size_type count, const T& value) {
+    insert(cend(), count, value);
+  }
+
+  // @brief Construct an element in place before pos.
+  // @param pos Position to insert before (begin() <= pos <= end()).
+  // @param args Arguments forwarded to T's constructor.
+  // @return Iterator to the new element.
+  //
+  // Elements at and after pos are shifted one slot to the right.
+  // Time complexity: O(n) where n is the number of elements after pos.
+  template <typename... Args>
+  DS_CONSTEXPR20 iterator emplace(const_iterator pos, Args&&... args) {
+    const auto index = static_cast<size_type>(pos - cbegin());
+
+    if (size_ == capacity_) {
+      return growAndEmplace(index, std::forward<Args>(args)...);
+    }
+
+    if (index == size_) {
+      AllocTraits::construct(alloc_, elements_ + size_, std::forward<Args>(args)...);
+      ++size_;
+      return elements_ + index;
+    }
+
+    if constexpr (is_trivially_relocatable_v<T>) {
+      if (!isConstantEvaluated()) {
+        // Build the value in raw storage first (args may alias an element that is about
+        // to shift), then open the gap with one memmove and drop the value into it.
+        alignas(T) unsigned char raw[sizeof(T)];
+        T* item = reinterpret_cast<T*>(raw);
+        AllocTraits::construct(alloc_, item, std::forward<Args>(args)...);
+
+        relocateWithin(alloc_, elements_ + index, size_ - index, elements_ + index + 1);
+        uninitializedRelocate(alloc_, item, 1, elements_ + index);
+        ++size_;
+
+        return elements_ + index;
+      }
+    }
+
+    // Build the value first: args may alias an element that is about to shift.
+    T item(std::forward<Args>(args)...);
+
+    AllocTraits::construct(alloc_, elements_ + size_, std::move(elements_[size_ - 1]));
+    ++size_;
+    std::move_backward(elements_ + index, elements_ + size_ - 2, elements_ + size_ - 1);
+    elements_[index] = std::move(item);
+
+    return elements_ + index;
+  }
+
+  // @brief Insert a copy of item before pos.
+  // @return Iterator to the new element.
+  DS_CONSTEXPR20 iterator insert(const_iterator pos, const T& item) {
+    return emplace(pos, item);
+  }
+
+  // @brief Insert item before pos (move).
+  // @return Iterator to the new element.
+  DS_CONSTEXPR20 iterator insert(const_iterator pos, T&& item) {
+    return emplace(pos, std::move(item));
+  }
+
+  // @brief Insert count copies of value before pos.
+  // @param pos Position to insert before (begin() <= pos <= end()).
+  // @param count Number of copies.
+  // @param value The value to copy (may be an element of this vector).
+  // @return Iterator to the first inserted element, or pos if count is 0.
+  //
+  // If a copy throws, the vector is unchanged.
+  // Time complexity: O(count + n) where n is the number of elements after pos.
+  DS_CONSTEXPR20 iterator insert(const_iterator pos, size_type count, const T& value) {
+    const auto index = static_cast<size_type>(pos - cbegin());
+    if (index < size_ && size_ + count <= capacity_ && pointsInto(&value)) {
+      const T copy(value); // Shifting the tail would move value
+      return insert(pos, count, copy);
+    }
+
+    return insertGap(index, count, [&](T* dest) {
+      uninitializedFillN(alloc_, dest, count, value);
+    });
+  }
+
+  // @brief Insert copies of the elements of [first, last) before pos.
+  // @param pos Position to insert before (begin() <= pos <= end()).
+  // @param first Start of the source range (may lie within this vector).
+  // @param last End of the source range.
+  // @return Iterator to the first inserted element, or pos if the range is empty.
+  //
+  // A forward range is measured first: the vector reallocates at most once and the
+  // elements after pos are shifted with one relocation (a memmove for trivially
+  // relocatable types). If a copy throws, the vector is unchanged. Input-only ranges are
+  // appended one element at a time and then rotated into place; if reading or copying
+  // one throws, the appended elements are destroyed again (capacity may have grown).
+  // Time complexity: O(m + n) for m inserted elements and n elements after pos.
+  template <typename InputIt,
+            typename = std::enable_if_t<vector_detail::isInputIterator_v<InputIt>>>
+  DS_CONSTEXPR20 iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    const auto index = static_cast<size_type>(pos - cbegin());
+
+    if constexpr (vector_detail::isForwardIterator_v<InputIt>) {
+      const auto count = static_cast<size_type>(std::distance(first, last));
+      if constexpr (std::is_pointer_v<InputIt>) {
+        if (index < size_ && size_ + count <= capacity_ && count > 0 && pointsInto(&*first)) {
+          // Shifting the tail would move the source: copy it out first
+          Vector temp(first, last, alloc_);
+          return insert(pos, std::make_move_iterator(temp.begin()),
+                        std::make_move_iterator(temp.end()));
+        }
+      }
+
+      return insertGap(index, count, [&](T* dest) {
+        uninitializedCopyN(alloc_, first, count, dest);
+      });
+    } else {
+      const size_type oldSize = size_;
+      try {
+        for (; first != last; ++first) {
+          emplace_back(*first);
+        }
+      } catch (...) {
+        destroyN(alloc_, elements_ + oldSize, size_ - oldSize);
+        size_ = oldSize;
+        throw;
+      }
+      std::rotate(elements_ + index, elements_ + oldSize, elements_ + size_);
+      return elements_ + index;
+    }
+  }
+
+  // @brief Remove the element at pos.
+  // @param pos Position of the element (begin() <= pos < end()).
+  // @return Iterator to the element that followed it.
+  DS_CONSTEXPR20 iterator erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+  }
+
+  // @brief Remove the elements of [first, last).
+  // @param first Start of the range to remove.
+  // @param last End of the range to remove (first <= last <= end()).
+  // @return Iterator to the element that followed the removed range.
+  //
+  // The elements after the range move down with one relocation (a memmove for trivially
+  // relocatable types).
+  // Time complexity: O(m + n) for m removed elements and n elements after last.
+  DS_CONSTEXPR20 iterator erase(const_iterator first, const_iterator last) {
+    const auto index = static_cast<size_type>(first - cbegin());
+    const auto count = static_cast<size_type>(last - first);
+    if (count == 0) {
+      return elements_ + index;
+    }
+
+    const size_type tail = size_ - index - count;
+    if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+      destroyN(alloc_, elements_ + index, count);
+      relocateWithin(alloc_, elements_ + index + count, tail, elements_ + index);
+    } else {
+      std::move(elements_ + index + count, elements_ + size_, elements_ + index);
+      destroyN(alloc_, elements_ + index + tail, count);
+    }
+    size_ -= count;
+
+    return elements_ + index;
   }
 
   // @brief Remove the last element.
   // @throws std::out_of_range if vector is empty.
   //
   // Time complexity: O(1).
-  void pop_back() {
+  DS_CONSTEXPR20 void pop_back() {
     if (empty()) {
       throw std::out_of_range("Vector::pop_back: vector is empty");
     }
 
     --size_;
+    AllocTraits::destroy(alloc_, elements_ + size_);
   }
 
   // @brief Resize the vector to contain count elements.
   // @param count New size.
   //
-  // If count > size, new elements are default constructed.
-  // If count < size, the vector is truncated.
-  void resize(size_type count) {
+  // If count > size, new elements are value-initialized in place.
+  // If count < size, the vector is truncated and the removed elements destroyed.
+  DS_CONSTEXPR20 void resize(size_type count) {
+    if (count <= size_) {
+      destroyN(alloc_, elements_ + count, size_ - count);
+      size_ = count;
+      return;
+    }
+
     if (count > capacity_) {
       reserve(count);
     }
 
-    if (count > size_) {
-      for (size_type i = size_; i < count; ++i) {
-        elements_[i] = T();
-      }
+    uninitializedValueConstructN(alloc_, elements_ + size_, count - size_);
+    size_ = count;
+  }
+
+  // @brief Resize the vector to contain count elements, copying value into new slots.
+  // @param count New size.
+  // @param value Value to initialize new elements with (may be an element of this vector).
+  //
+  // If count < size, the vector is truncated.
+  DS_CONSTEXPR20 void resize(size_type count, const T& value) {
+    if (count <= size_) {
+      destroyN(alloc_, elements_ + count, size_ - count);
+      size_ = count;
+      return;
+    }
+
+    if (count <= capacity_) {
+      uninitializedFillN(alloc_, elements_ + size_, count - size_, value);
+      size_ = count;
+      return;
+    }
+
+    // Fill the new storage before relocating, while value is still valid
+    T* newArray = allocate(count);
+
+    try {
+      uninitializedFillN(alloc_, newArray + size_, count - size_, value);
+    } catch (...) {
+      deallocate(newArray, count);
+      throw;
+    }
+
+    try {
+      uninitializedRelocate(alloc_, elements_, size_, newArray);
+    } catch (...) {
+      destroyN(alloc_, newArray + size_, count - size_);
+      deallocate(newArray, count);
+      throw;
+    }
+
+    recordGrowth();
+    deallocate(elements_, capacity_);
+    elements_ = newArray;
+    capacity_ = count;
+    size_ = count;
+  }
+
+  // @brief Resize the vector, leaving new trivially constructible elements uninitialized.
+  // @param count New size.
+  //
+  // For buffers that are about to be overwritten (e.g. by read() or recv()), this skips
+  // the zero-fill resize(count) performs. New elements are default-initialized:
+  // trivially default-constructible types keep whatever bytes the storage holds, other
+  // types are constructed as usual. If count < size, the vector is truncated.
+  DS_CONSTEXPR20 void resize_default_init(size_type count) {
+    if (count <= size_) {
+      destroyN(alloc_, elements_ + count, size_ - count);
+      size_ = count;
+      return;
     }
 
+    if (count > capacity_) {
+      reserve(count);
+    }
+
+    if constexpr (!std::is_trivially_default_constructible_v<T>) {
+      uninitializedValueConstructN(alloc_, elements_ + size_, count - size_);
+    }
     size_ = count;
   }
 
   // @brief Swap elements with another vector.
   // @param other The vector to swap with.
-  void swap(Vector& other) noexcept {
-    std::swap(size_, other.size_);
-    std::swap(capacity_, other.capacity_);
-    std::swap(elements_, other.elements_);
+  //
+  // Allocators are swapped if propagate_on_container_swap is true; otherwise they must
+  // compare equal.
+  DS_CONSTEXPR20 void swap(Vector& other) noexcept {
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+
+    swapStorage(other);
   }
 
 private:
-  static constexpr size_type DEFAULT_CAPACITY = 16; // Default initial capacity
-  static constexpr size_type GROWTH_FACTOR = 2;     // Capacity growth multiplier
+  static constexpr size_type DEFAULT_CAPACITY = 16; // Minimum capacity of the first allocation
+
+  Allocator alloc_;     // Allocator for storage and element lifetimes
+  T* elements_;        // Uninitialized storage; [0, size_) holds live elements
+  size_type capacity_; // Maximum capacity before reallocation
+  size_type size_;     // Number of elements in the vector
+
+  // @brief Allocate uninitialized storage for n elements.
+  // @param n Number of element slots (0 yields nullptr).
+  DS_CONSTEXPR20 T* allocate(size_type n) {
+    if (n == 0) {
+      return nullptr;
+    }
+
+    T* p = AllocTraits::allocate(alloc_, n);
+    recordAllocation(n * sizeof(T));
+    recordCapacity(n);
+    return p;
+  }
+
+  // @brief Count a transfer of the live elements to a new buffer.
+  DS_CONSTEXPR20 void recordGrowth() noexcept {
+    if (capacity_ > 0) {
+      recordReallocation();
+    }
+    recordRelocation<T>(size_);
+  }
+
+  // @brief Free storage obtained from allocate(). Elements must already be destroyed.
+  DS_CONSTEXPR20 void deallocate(T* p, size_type n) noexcept {
+    if (p != nullptr) {
+      AllocTraits::deallocate(alloc_, p, n);
+    }
+  }
+
+  // @brief Exchange storage (but not allocators) with another vector.
+  DS_CONSTEXPR20 void swapStorage(Vector& other) noexcept {
+    std::swap(elements_, other.elements_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+  }
+
+  // @brief Move other's elements into fresh storage from this vector's allocator.
+  // @param other The vector to move from; left empty but keeps its storage.
+  //
+  // Used when the allocators differ and storage cannot be stolen. This vector must
+  // be empty.
+  DS_CONSTEXPR20 void moveElementsFrom(Vector& other) {
+    if (other.size_ > capacity_) {
+      T* newArray = allocate(other.size_);
+      deallocate(elements_, capacity_);
+      elements_ = newArray;
+      capacity_ = other.size_;
+    }
+
+    uninitializedMoveN(alloc_, other.elements_, other.size_, elements_);
+    size_ = other.size_;
+    recordMoves(size_);
+    other.clear();
+  }
+
+  // @brief Destroy all elements and free the storage, leaving the vector empty.
+  DS_CONSTEXPR20 void release() noexcept {
+    destroyN(alloc_, elements_, size_);
+    deallocate(elements_, capacity_);
+    elements_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+  }
+
+  // @brief Move the live elements into fresh storage of exactly newCapacity slots.
+  // @param newCapacity The new capacity (must be >= size_).
+  //
+  // Trivially relocatable elements are moved with a single memcpy. Others are moved
+  // if their move constructor is noexcept and copied otherwise, so a throwing copy
+  // leaves the vector unchanged.
+  DS_CONSTEXPR20 void reallocate(size_type newCapacity) {
+    T* newArray = allocate(newCapacity);
+
+    try {
+      uninitializedRelocate(alloc_, elements_, size_, newArray);
+    } catch (...) {
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+
+    recordGrowth();
+    deallocate(elements_, capacity_);
+    elements_ = newArray;
+    capacity_ = newCapacity;
+  }
+
+  // @brief Compute the capacity to grow to, as decided by the growth policy.
+  // @param required Minimum number of elements the new storage must hold.
+  DS_CONSTEXPR20 size_type nextCapacity(size_type required) const noexcept {
+    if (capacity_ == 0 && required < DEFAULT_CAPACITY) {
+      required = DEFAULT_CAPACITY;
+    }
+
+    return Growth::next(capacity_, required, sizeof(T));
+  }
+
+  // @brief Check whether p points at one of the live elements.
+  DS_CONSTEXPR20 bool pointsInto(const T* p) const noexcept {
+    if (isConstantEvaluated()) {
+      // Ordering unrelated pointers is not a constant expression; equality is
+      for (size_type i = 0; i < size_; ++i) {
+        if (p == elements_ + i) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    return !std::less<const T*>()(p, elements_) && std::less<const T*>()(p, elements_ + size_);
+  }
 
-  std::unique_ptr<T[]> elements_; // Array holding vector elements
-  size_type capacity_;            // Maximum capacity before reallocation
-  size_type size_;                // Number of elements in the vector
+  // @brief Open a gap of count slots at index and fill it.
+  // @param index Position of the gap (index <= size_).
+  // @param count Number of slots.
+  // @param fill Callable constructing count elements in raw storage; on failure it must
+  //        destroy what it built and rethrow. Its source may alias the elements unless
+  //        the gap is opened in place.
+  // @return Iterator to the first element of the gap.
+  //
+  // In place, the tail is relocated up in one step, the gap filled and, if that throws,
+  // the tail relocated back. Types whose move may throw cannot be shifted back safely,
+  // so they take the reallocating path, like a full vector does: the gap is filled in
+  // the new buffer first, then the old elements are transferred around it.
+  template <typename Fill>
+  DS_CONSTEXPR20 iterator insertGap(size_type index, size_type count, Fill&& fill) {
+    if (count == 0) {
+      return elements_ + index;
+    }
+
+    constexpr bool shiftable =
+        is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+    if (shiftable && size_ + count <= capacity_) {
+      if constexpr (shiftable) {
+        T* gap = elements_ + index;
+        relocateWithin(alloc_, gap, size_ - index, gap + count);
+        try {
+          fill(gap);
+        } catch (...) {
+          relocateWithin(alloc_, gap + count, size_ - index, gap);
+          throw;
+        }
+        size_ += count;
+        return gap;
+      }
+    }
+
+    const size_type newCapacity =
+        size_ + count <= capacity_ ? capacity_ : nextCapacity(size_ + count);
+    T* newArray = allocate(newCapacity);
+    try {
+      fill(newArray + index);
+    } catch (...) {
+      deallocate(newArray, newCapacity);
+      throw;
+    }
 
-  // @brief Ensure there is capacity for at least one more element.
-  void ensureCapacity() {
-    if (size_ >= capacity_) {
-      size_type newCapacity = capacity_ == 0 ? DEFAULT_CAPACITY : capacity_ * GROWTH_FACTOR;
+    try {
+      relocateAround(newArray, index, count);
+    } catch (...) {
+      destroyN(alloc_, newArray + index, count);
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+
+    recordGrowth();
+    deallocate(elements_, capacity_);
+    elements_ = newArray;
+    capacity_ = newCapacity;
+    size_ += count;
+
+    return elements_ + index;
+  }
+
+  // @brief Transfer the live elements into newArray around a gap the caller has filled.
+  // @param newArray Fresh storage; slots [index, index + gap) are already constructed.
+  // @param index Elements before index keep their position, the others move up by gap.
+  // @param gap Size of the gap.
+  //
+  // Trivially relocatable and nothrow-movable elements are relocated. Others are copied
+  // (or, for move-only types, moved) before the originals are destroyed, so if a copy
+  // throws, the copies are destroyed again and the vector is unchanged.
+  DS_CONSTEXPR20 void relocateAround(T* newArray, size_type index, size_type gap) {
+    if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+      uninitializedRelocate(alloc_, elements_, index, newArray);
+      uninitializedRelocate(alloc_, elements_ + index, size_ - index, newArray + index + gap);
+    } else {
+      size_type constructed = 0;
 
-      // Overflow check
-      if (newCapacity <= capacity_ && capacity_ > 0) {
-        newCapacity = capacity_ + 1;
+      try {
+        for (; constructed < index; ++constructed) {
+          AllocTraits::construct(
+              alloc_, newArray + constructed, std::move_if_noexcept(elements_[constructed]));
+        }
+        for (; constructed < size_; ++constructed) {
+          AllocTraits::construct(alloc_, newArray + constructed + gap,
+                                 std::move_if_noexcept(elements_[constructed]));
+        }
+      } catch (...) {
+        destroyN(alloc_, newArray, std::min(constructed, index));
+        if (constructed > index) {
+          destroyN(alloc_, newArray + index + gap, constructed - index);
+        }
+        throw;
       }
 
-      reserve(newCapacity);
+      destroyN(alloc_, elements_, size_);
+    }
+  }
+
+  // @brief Reallocate a full vector and construct a new element at index.
+  // @param index Position of the new element (index <= size_).
+  // @param args Arguments forwarded to T's constructor.
+  // @return Pointer to the new element.
+  //
+  // The new element is constructed first so that args may safely refer to
+  // elements of this vector; the old elements are moved around it afterwards.
+  template <typename... Args>
+  DS_CONSTEXPR20 T* growAndEmplace(size_type index, Args&&... args) {
+    const size_type newCapacity = nextCapacity(size_ + 1);
+    T* newArray = allocate(newCapacity);
+    T* slot = newArray + index;
+
+    try {
+      AllocTraits::construct(alloc_, slot, std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(newArray, newCapacity);
+      throw;
+    }
+
+    try {
+      relocateAround(newArray, index, 1);
+    } catch (...) {
+      AllocTraits::destroy(alloc_, slot);
+      deallocate(newArray, newCapacity);
+      throw;
     }
+
+    recordGrowth();
+    deallocate(elements_, capacity_);
+    elements_ = newArray;
+    capacity_ = newCapacity;
+    ++size_;
+
+    return slot;
   }
 };
 
+// @brief Vector whose data() is aligned to Alignment bytes across every reallocation.
+// @tparam T The type of elements stored in the vector.
+// @tparam Alignment Alignment in bytes (default: one cache line / an AVX-512 register).
+template <typename T, std::size_t Alignment = 64>
+using AlignedVector = Vector<T, AlignedAllocator<T, Alignment>>;
+
 #endif // VECTOR_H
@@ -0,0 +1,32 @@
+#ifndef COUNTING_RESOURCE_H
+#define COUNTING_RESOURCE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+// Memory resource that forwards to new/delete and counts what passes through it.
+class CountingResource : public std::pmr::memory_resource {
+public:
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t bytesInUse = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    bytesInUse += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    ++deallocations;
+    bytesInUse -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+#endif // COUNTING_RESOURCE_H
@@ -0,0 +1,31 @@
+#ifndef LIST_TEST_UTILS_H
+#define LIST_TEST_UTILS_H
+
+#include <cstddef>
+#include <vector>
+
+// Element that counts its move constructions, so tests can tell how many elements an
+// edit shifted or relocated.
+struct MoveCounter {
+  static inline std::size_t moves = 0;
+  int value;
+
+  explicit MoveCounter(int v) : value{v} {
+  }
+  MoveCounter(const MoveCounter&) = default;
+  MoveCounter(MoveCounter&& other) noexcept : value{other.value} {
+    ++moves;
+  }
+  MoveCounter& operator=(const MoveCounter&) = default;
+};
+
+// Elements of a list with forEach(), in order.
+template <template <typename, typename, typename> class ListType, typename E, typename A,
+          typename G>
+std::vector<E> contents(const ListType<E, A, G>& list) {
+  std::vector<E> out;
+  list.forEach([&](const E& item) { out.push_back(item); });
+  return out;
+}
+
+#endif // LIST_TEST_UTILS_H
@@ -0,0 +1,59 @@
+#include "../ds/AlignedAllocator.h"
+#include "../ds/AList.h"
+#include "../ds/Vector.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+
+namespace {
+  bool isAligned(const void* p, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+  }
+} // namespace
+
+TEST(AlignedAllocatorTest, AllocateIsAligned) {
+  AlignedAllocator<float, 64> alloc;
+  for (std::size_t n : {1, 3, 17, 1000}) {
+    float* p = alloc.allocate(n);
+    EXPECT_TRUE(isAligned(p, 64));
+    alloc.deallocate(p, n);
+  }
+}
+
+TEST(AlignedAllocatorTest, RebindKeepsAlignment) {
+  using Rebound = std::allocator_traits<AlignedAllocator<char, 128>>::rebind_alloc<double>;
+  static_assert(std::is_same_v<Rebound, AlignedAllocator<double, 128>>);
+
+  Rebound alloc;
+  double* p = alloc.allocate(5);
+  EXPECT_TRUE(isAligned(p, 128));
+  alloc.deallocate(p, 5);
+}
+
+TEST(AlignedAllocatorTest, AllocatorsCompareEqual) {
+  EXPECT_TRUE((AlignedAllocator<int, 64>{} == AlignedAllocator<float, 64>{}));
+  EXPECT_FALSE((AlignedAllocator<int, 64>{} != AlignedAllocator<int, 64>{}));
+}
+
+TEST(AlignedAllocatorTest, AlignedVectorStaysAlignedAcrossGrowth) {
+  AlignedVector<float> vec;
+  for (int i = 0; i < 10000; ++i) {
+    vec.push_back(static_cast<float>(i));
+    ASSERT_TRUE(isAligned(vec.data(), 64));
+  }
+
+  vec.shrink_to_fit();
+  EXPECT_TRUE(isAligned(vec.data(), 64));
+  EXPECT_EQ(vec[9999], 9999.0f);
+}
+
+TEST(AlignedAllocatorTest, AlignedAList) {
+  AList<double, AlignedAllocator<double, 32>> list(1);
+  for (int i = 0; i < 100; ++i) {
+    list.append(i);
+  }
+
+  EXPECT_EQ(list.length(), 100);
+  list.moveToPos(99);
+  EXPECT_EQ(list.getValue(), 99.0);
+}
@@ -1,6 +1,9 @@
 #include "../ds/AList.h"
+#include "CountingResource.h"
 
 #include <gtest/gtest.h>
+#include <memory_resource>
+#include <string>
 
 TEST(AListTest, DefaultConstruction) {
   AList<int> list;
@@ -44,3 +47,162 @@ TEST(AListTest, RemoveFromEmptyListThrows) {
   AList<int> list;
   EXPECT_THROW(list.remove(), std::out_of_range);
 }
+
+TEST(AListTest, GrowPreservesElements) {
+  AList<std::string> list(2);
+  for (int i = 0; i < 50; ++i) {
+    list.append(std::to_string(i));
+  }
+  list.moveToPos(10);
+  list.insert("x");
+  list.shrink_to_fit();
+
+  EXPECT_EQ(list.length(), 51);
+  EXPECT_EQ(list.capacity(), 51);
+  EXPECT_EQ(list.getValue(), "x");
+  list.next();
+  EXPECT_EQ(list.getValue(), "10");
+
+  list.moveToPos(50);
+  EXPECT_EQ(list.getValue(), "49");
+}
+
+TEST(AListTest, InsertAndRemoveShiftTrivialElements) {
+  AList<int> list;
+  for (int i = 0; i < 5; ++i) {
+    list.append(i);
+  }
+  list.moveToPos(2);
+  list.insert(42);
+  EXPECT_EQ(list.length(), 6);
+
+  list.moveToPos(0);
+  EXPECT_EQ(list.remove(), 0);
+  EXPECT_EQ(list.getValue(), 1);
+  list.moveToPos(1);
+  EXPECT_EQ(list.getValue(), 42);
+  list.moveToPos(4);
+  EXPECT_EQ(list.getValue(), 4);
+}
+
+TEST(AListTest, ClearKeepsCapacity) {
+  AList<std::string> list(4);
+  list.append("a");
+  list.append("b");
+  list.clear();
+
+  EXPECT_EQ(list.length(), 0);
+  EXPECT_EQ(list.capacity(), 4);
+  list.append("c");
+  EXPECT_EQ(list.getValue(), "c");
+}
+
+TEST(AListTest, PolymorphicAllocator) {
+  CountingResource resource;
+  {
+    AList<int, std::pmr::polymorphic_allocator<int>> list(2, &resource);
+    for (int i = 0; i < 20; ++i) {
+      list.append(i);
+    }
+    EXPECT_GE(resource.allocations, 2);
+
+    AList<int, std::pmr::polymorphic_allocator<int>> copy(list);
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy.length(), 20);
+  }
+  EXPECT_EQ(resource.bytesInUse, 0);
+}
+
+TEST(AListTest, MoveAssignBetweenUnequalAllocators) {
+  CountingResource first;
+  CountingResource second;
+  using PmrList = AList<std::string, std::pmr::polymorphic_allocator<std::string>>;
+
+  PmrList source(&first);
+  source.append("a");
+  source.append("b");
+  source.next();
+
+  PmrList target(&second);
+  target = std::move(source);
+
+  EXPECT_EQ(target.get_allocator().resource(), &second);
+  EXPECT_EQ(target.length(), 2);
+  EXPECT_EQ(target.getValue(), "b");
+  EXPECT_EQ(source.length(), 0);
+}
+
+TEST(AListTest, GrowthPolicy) {
+  AList<int, std::allocator<int>, AdditiveGrowth<5>> list(2);
+  for (int i = 0; i < 10; ++i) {
+    list.append(i);
+  }
+
+  EXPECT_EQ(list.capacity(), 12);
+  list.moveToPos(9);
+  EXPECT_EQ(list.getValue(), 9);
+}
+
+TEST(AListTest, RangeOperationsShiftOnce) {
+  AList<std::string> list(4);
+  for (int i = 0; i < 4; ++i) {
+    list.append(std::to_string(i));
+  }
+  const std::string batch[] = {"a", "b", "c"};
+
+  List<std::string>& base = list;
+  base.moveToPos(1);
+  base.insertRange(batch, batch + 3);
+  EXPECT_EQ(list.capacity(), 8); // One reallocation for the whole batch
+  EXPECT_EQ(list.getValue(), "a");
+  base.appendRange(batch, batch + 2);
+
+  const std::string expected[] = {"0", "a", "b", "c", "1", "2", "3", "a", "b"};
+  ASSERT_EQ(list.length(), 9);
+  for (std::size_t i = 0; i < 9; ++i) {
+    EXPECT_EQ(list.data()[i], expected[i]);
+  }
+
+  base.moveToPos(2);
+  EXPECT_THROW(base.removeRange(8), std::out_of_range);
+  EXPECT_EQ(list.length(), 9);
+  base.removeRange(4);
+  EXPECT_EQ(list.length(), 5);
+  EXPECT_EQ(list.getValue(), "3");
+
+  // Inserting part of the list into itself copies the source first
+  list.moveToStart();
+  list.insertRange(list.data() + 1, list.data() + 5);
+  const std::string spliced[] = {"a", "3", "a", "b", "0", "a", "3", "a", "b"};
+  ASSERT_EQ(list.length(), 9);
+  for (std::size_t i = 0; i < 9; ++i) {
+    EXPECT_EQ(list.data()[i], spliced[i]);
+  }
+}
+
+TEST(AListTest, RangeOperationsWithThrowingMove) {
+  // No nothrow move: insertRange falls back to one insert() per element
+  struct ThrowingMove {
+    int value;
+    ThrowingMove(int v) : value{v} {
+    }
+    ThrowingMove(const ThrowingMove&) = default;
+    ThrowingMove(ThrowingMove&& other) : value{other.value} {
+    }
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+    ThrowingMove& operator=(ThrowingMove&&) = default;
+  };
+
+  AList<ThrowingMove> list;
+  const ThrowingMove batch[] = {1, 2, 3};
+  list.appendRange(batch, batch + 3);
+  list.moveToPos(1);
+  list.insertRange(batch, batch + 3);
+  list.removeRange(2);
+
+  const int expected[] = {1, 3, 2, 3};
+  ASSERT_EQ(list.length(), 4);
+  for (std::size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(list.data()[i].value, expected[i]);
+  }
+}
@@ -0,0 +1,197 @@
+#include "../ds/BitVector.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+  const SimdLevel ALL_LEVELS[] = {
+      SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512};
+
+  // Random bits with the given density, mirrored into a std::vector<bool>
+  BitVector<> randomBits(std::size_t size, double density, std::vector<bool>& expected) {
+    std::mt19937 rng(static_cast<unsigned>(size));
+    std::bernoulli_distribution coin(density);
+    BitVector<> bits;
+    expected.clear();
+    for (std::size_t i = 0; i < size; ++i) {
+      const bool value = coin(rng);
+      bits.push_back(value);
+      expected.push_back(value);
+    }
+    return bits;
+  }
+
+  void expectSameBits(const BitVector<>& bits, const std::vector<bool>& expected) {
+    ASSERT_EQ(bits.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(bits[i], expected[i]) << "bit " << i;
+    }
+  }
+} // namespace
+
+TEST(BitVectorTest, PacksBitsIntoWords) {
+  BitVector<> bits(130, false);
+  EXPECT_EQ(bits.size(), 130u);
+  EXPECT_EQ(bits.wordCount(), 3u);
+  EXPECT_EQ(bits.count(), 0u);
+
+  bits[0] = true;
+  bits.set(64);
+  bits[129] = bits[0];
+  EXPECT_TRUE(bits.at(129));
+  EXPECT_EQ(bits.data()[1], 1u);
+  EXPECT_EQ(bits.count(), 3u);
+
+  bits.flip(0);
+  bits[64].flip();
+  EXPECT_FALSE(bits.test(0));
+  EXPECT_FALSE(bits.test(64));
+  EXPECT_THROW(bits.at(130), std::out_of_range);
+}
+
+TEST(BitVectorTest, PushPopAndResizeKeepTailClear) {
+  BitVector<> bits(70, true);
+  EXPECT_EQ(bits.count(), 70u);
+  EXPECT_EQ(bits.data()[1], (std::uint64_t{1} << 6) - 1);
+
+  bits.resize(65);
+  EXPECT_EQ(bits.count(), 65u);
+  EXPECT_EQ(bits.data()[1], 1u);
+
+  bits.pop_back();
+  EXPECT_EQ(bits.wordCount(), 1u);
+  bits.push_back(false);
+  EXPECT_EQ(bits.count(), 64u); // The popped bit did not come back
+
+  bits.resize(200, true);
+  EXPECT_EQ(bits.count(), 199u); // Bit 64 stays clear
+  bits.clear();
+  EXPECT_TRUE(bits.empty());
+  EXPECT_THROW(bits.pop_back(), std::out_of_range);
+}
+
+TEST(BitVectorTest, RangeOperationsMatchBitwiseLoop) {
+  std::vector<bool> expected;
+  BitVector<> bits = randomBits(1000, 0.5, expected);
+
+  const std::size_t ranges[][2] = {{0, 0}, {3, 9}, {60, 70}, {64, 128}, {5, 999}, {0, 1000}};
+  for (const auto& range : ranges) {
+    bits.flipRange(range[0], range[1]);
+    for (std::size_t i = range[0]; i < range[1]; ++i) {
+      expected[i] = !expected[i];
+    }
+    expectSameBits(bits, expected);
+
+    bits.setRange(range[1] / 2, range[1]);
+    for (std::size_t i = range[1] / 2; i < range[1]; ++i) {
+      expected[i] = true;
+    }
+    expectSameBits(bits, expected);
+
+    bits.resetRange(range[0], (range[0] + range[1]) / 2);
+    for (std::size_t i = range[0]; i < (range[0] + range[1]) / 2; ++i) {
+      expected[i] = false;
+    }
+    expectSameBits(bits, expected);
+  }
+
+  EXPECT_THROW(bits.setRange(10, 1001), std::out_of_range);
+  EXPECT_THROW(bits.flipRange(10, 9), std::out_of_range);
+}
+
+TEST(BitVectorTest, CountMatchesAcrossSimdLevels) {
+  std::vector<bool> expected;
+  const BitVector<> bits = randomBits(5000, 0.3, expected);
+
+  std::size_t ones = 0;
+  for (bool bit : expected) {
+    ones += bit;
+  }
+  EXPECT_EQ(bits.count(), ones);
+  for (SimdLevel level : ALL_LEVELS) {
+    for (std::size_t words = 0; words <= bits.wordCount(); words += 7) {
+      EXPECT_EQ(simdPopcount(bits.data(), words, level),
+                simdPopcount(bits.data(), words, SimdLevel::Scalar));
+    }
+  }
+
+  for (std::size_t first = 0; first < 300; first += 37) {
+    for (std::size_t last = first; last < 5000; last += 611) {
+      std::size_t slow = 0;
+      for (std::size_t i = first; i < last; ++i) {
+        slow += expected[i];
+      }
+      EXPECT_EQ(bits.count(first, last), slow) << first << ".." << last;
+    }
+  }
+}
+
+TEST(BitVectorTest, RankAndSelectMatchLinearScan) {
+  for (double density : {0.001, 0.1, 0.5, 0.97}) {
+    std::vector<bool> expected;
+    BitVector<> bits = randomBits(70000, density, expected);
+    bits.buildRankIndex();
+    ASSERT_TRUE(bits.hasRankIndex());
+
+    std::vector<std::size_t> positions;
+    std::size_t rank = 0;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(bits.rank1(i), rank) << "position " << i;
+      if (expected[i]) {
+        positions.push_back(i);
+        ++rank;
+      }
+    }
+    EXPECT_EQ(bits.rank1(bits.size()), rank);
+    EXPECT_EQ(bits.rank0(bits.size()), bits.size() - rank);
+    EXPECT_EQ(bits.count(), rank);
+
+    for (std::size_t k = 0; k < positions.size(); ++k) {
+      ASSERT_EQ(bits.select1(k), positions[k]) << "rank " << k;
+    }
+    EXPECT_THROW(bits.select1(positions.size()), std::out_of_range);
+    EXPECT_THROW(bits.rank1(bits.size() + 1), std::out_of_range);
+  }
+}
+
+TEST(BitVectorTest, RankIndexIsSmallAndDiscardedByModifiers) {
+  BitVector<> bits(1 << 22, true);
+  bits.buildRankIndex();
+  EXPECT_EQ(bits.select1(3000000), 3000000u);
+
+  // One word per 2048 bits plus the select samples: under 4% of the bits
+  const double overhead = static_cast<double>(bits.rankIndexBytes()) / (bits.wordCount() * 8);
+  EXPECT_LT(overhead, 0.04);
+
+  bits.reset(0);
+  EXPECT_FALSE(bits.hasRankIndex());
+  EXPECT_THROW(bits.rank1(0), std::logic_error);
+  EXPECT_THROW(bits.select1(0), std::logic_error);
+
+  bits.buildRankIndex();
+  EXPECT_EQ(bits.rank1(10), 9u);
+  EXPECT_EQ(bits.select1(0), 1u);
+
+  BitVector<> empty;
+  empty.buildRankIndex();
+  EXPECT_EQ(empty.rank1(0), 0u);
+  EXPECT_THROW(empty.select1(0), std::out_of_range);
+}
+
+TEST(BitVectorTest, CopySwapAndCompare) {
+  std::vector<bool> expected;
+  BitVector<> a = randomBits(300, 0.5, expected);
+  BitVector<> b = a;
+  EXPECT_EQ(a, b);
+
+  b.flip(299);
+  EXPECT_NE(a, b);
+
+  BitVector<> c(10, true);
+  c.swap(b);
+  EXPECT_EQ(c.size(), 300u);
+  EXPECT_EQ(b.count(), 10u);
+}
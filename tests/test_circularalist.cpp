@@ -0,0 +1,259 @@
+#include "../ds/CircularAList.h"
+#include "CountingResource.h"
+#include "ListTestUtils.h"
+
+#include <algorithm>
+#include <deque>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST(CircularAListTest, InsertMultipleElements) {
+  CircularAList<int> list;
+  list.insert(3);
+  list.insert(2);
+  list.insert(1);
+
+  EXPECT_EQ(list.length(), 3);
+
+  list.moveToStart();
+  EXPECT_EQ(list.getValue(), 1);
+
+  list.next();
+  EXPECT_EQ(list.getValue(), 2);
+
+  list.next();
+  EXPECT_EQ(list.getValue(), 3);
+}
+
+TEST(CircularAListTest, RemoveAndPositionErrors) {
+  CircularAList<int> list;
+  EXPECT_THROW(list.remove(), std::out_of_range);
+  EXPECT_THROW((void)list.getValue(), std::out_of_range);
+  EXPECT_THROW(list.moveToPos(1), std::out_of_range);
+
+  list.append(1);
+  list.append(2);
+  list.moveToPos(1);
+  EXPECT_EQ(list.remove(), 2);
+  EXPECT_THROW(list.remove(), std::out_of_range);
+  list.prev();
+  EXPECT_EQ(list.remove(), 1);
+  EXPECT_EQ(list.length(), 0);
+}
+
+TEST(CircularAListTest, SlidingWindowWrapsWithoutShifting) {
+  CircularAList<MoveCounter> list(8);
+  for (int i = 0; i < 8; ++i) {
+    list.append(MoveCounter(i));
+  }
+
+  MoveCounter::moves = 0;
+  for (int i = 8; i < 1000; ++i) {
+    list.moveToStart();
+    EXPECT_EQ(list.remove().value, i - 8);
+    list.append(MoveCounter(i));
+  }
+
+  // One move per removed value; AList would shift the other 7 each time
+  EXPECT_EQ(MoveCounter::moves, 992u);
+  EXPECT_EQ(list.capacity(), 8);
+  list.moveToPos(7);
+  EXPECT_EQ(list.getValue().value, 999);
+}
+
+TEST(CircularAListTest, MiddleEditsShiftShorterSide) {
+  CircularAList<MoveCounter> list(128);
+  for (int i = 0; i < 100; ++i) {
+    list.append(MoveCounter(i));
+  }
+
+  MoveCounter::moves = 0;
+  list.moveToPos(10);
+  list.insert(MoveCounter(-1));
+  EXPECT_EQ(MoveCounter::moves, 10u + 1); // The prefix, plus the new value into its slot
+
+  MoveCounter::moves = 0;
+  list.moveToPos(95);
+  list.remove();
+  EXPECT_EQ(MoveCounter::moves, 5u + 1); // The returned value, plus the suffix
+
+  list.moveToPos(10);
+  EXPECT_EQ(list.getValue().value, -1);
+  list.moveToPos(9);
+  EXPECT_EQ(list.getValue().value, 9);
+  list.moveToPos(95);
+  EXPECT_EQ(list.getValue().value, 95);
+}
+
+TEST(CircularAListTest, RandomEditsMatchDeque) {
+  std::mt19937 rng(11);
+  CircularAList<std::string> list(1);
+  std::deque<std::string> expected;
+  std::size_t cursor = 0;
+
+  for (int step = 0; step < 3000; ++step) {
+    const unsigned op = rng() % 6;
+    if (op == 0) {
+      cursor = rng() % (expected.size() + 1);
+      list.moveToPos(cursor);
+    } else if (op == 1 && cursor < expected.size()) {
+      ASSERT_EQ(list.remove(), expected[cursor]);
+      expected.erase(expected.begin() + cursor);
+    } else if (op == 2) {
+      list.moveToStart();
+      cursor = 0;
+    } else if (op == 3) {
+      list.append("a" + std::to_string(step));
+      expected.push_back("a" + std::to_string(step));
+    } else {
+      list.insert(std::to_string(step));
+      expected.insert(expected.begin() + cursor, std::to_string(step));
+    }
+
+    ASSERT_EQ(list.length(), expected.size());
+    if (cursor < expected.size()) {
+      ASSERT_EQ(list.getValue(), expected[cursor]) << "step " << step;
+    }
+  }
+  EXPECT_EQ(contents(list), std::vector<std::string>(expected.begin(), expected.end()));
+}
+
+TEST(CircularAListTest, CapacityIsPowerOfTwo) {
+  CircularAList<int, std::allocator<int>, AdditiveGrowth<5>> list(3);
+  EXPECT_EQ(list.capacity(), 4);
+  for (int i = 0; i < 10; ++i) {
+    list.append(i);
+  }
+  EXPECT_EQ(list.capacity(), 16);
+
+  list.reserve(17);
+  EXPECT_EQ(list.capacity(), 32);
+  list.shrink_to_fit();
+  EXPECT_EQ(list.capacity(), 16);
+  list.moveToPos(9);
+  EXPECT_EQ(list.getValue(), 9);
+}
+
+TEST(CircularAListTest, CopyAndMoveWrappedContents) {
+  CircularAList<std::string> list(4);
+  for (int i = 0; i < 4; ++i) {
+    list.append(std::to_string(i));
+  }
+  list.moveToStart();
+  list.remove();
+  list.append("4"); // Wraps into slot 0
+  list.next();
+
+  CircularAList<std::string> copy(list);
+  EXPECT_EQ(contents(copy), (std::vector<std::string>{"1", "2", "3", "4"}));
+  EXPECT_EQ(copy.getValue(), "2");
+
+  CircularAList<std::string> moved(std::move(copy));
+  EXPECT_EQ(contents(moved), contents(list));
+  EXPECT_EQ(copy.length(), 0);
+
+  list.clear();
+  list = moved;
+  EXPECT_EQ(contents(list), contents(moved));
+}
+
+TEST(CircularAListTest, MoveAssignBetweenUnequalAllocators) {
+  CountingResource first;
+  CountingResource second;
+  using PmrList = CircularAList<std::string, std::pmr::polymorphic_allocator<std::string>>;
+  {
+    PmrList source(2, &first);
+    source.append("x");
+    source.append("a");
+    source.moveToStart();
+    source.remove();
+    source.append("b"); // Wraps
+    source.next();
+
+    PmrList target(&second);
+    target = std::move(source);
+
+    EXPECT_EQ(target.get_allocator().resource(), &second);
+    EXPECT_EQ(contents(target), (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(target.getValue(), "b");
+    EXPECT_EQ(source.length(), 0);
+  }
+  EXPECT_EQ(first.bytesInUse, 0);
+  EXPECT_EQ(second.bytesInUse, 0);
+}
+
+TEST(CircularAListTest, RangeOperationsShiftShorterSideOnce) {
+  CircularAList<MoveCounter> list(128);
+  for (int i = 0; i < 100; ++i) {
+    list.append(MoveCounter(i));
+  }
+  const MoveCounter batch[] = {MoveCounter(-1), MoveCounter(-2), MoveCounter(-3)};
+  List<MoveCounter>& base = list;
+
+  MoveCounter::moves = 0;
+  base.moveToPos(90);
+  base.insertRange(batch, batch + 3);
+  EXPECT_EQ(MoveCounter::moves, 10u); // Only the suffix moves, once
+  EXPECT_EQ(list.getValue().value, -1);
+
+  MoveCounter::moves = 0;
+  base.moveToPos(5);
+  base.removeRange(20);
+  EXPECT_EQ(MoveCounter::moves, 5u); // Only the prefix moves, once
+  EXPECT_EQ(list.getValue().value, 25);
+  EXPECT_THROW(base.removeRange(79), std::out_of_range);
+
+  std::vector<int> values;
+  list.forEach([&](const MoveCounter& item) { values.push_back(item.value); });
+  ASSERT_EQ(values.size(), 83u);
+  EXPECT_EQ(values[4], 4);
+  EXPECT_EQ(values[70], -1);
+  EXPECT_EQ(values[72], -3);
+  EXPECT_EQ(values[73], 90);
+}
+
+TEST(CircularAListTest, RangeOperationsAcrossTheWrap) {
+  CircularAList<std::string> list(8);
+  for (int i = 0; i < 6; ++i) {
+    list.append(std::to_string(i));
+  }
+  list.moveToStart();
+  list.removeRange(4); // Head now at slot 4
+  const std::string batch[] = {"a", "b", "c", "d", "e"};
+  list.appendRange(batch, batch + 5); // Wraps past slot 7
+
+  list.moveToPos(1);
+  list.insertRange(batch, batch + 2);
+  EXPECT_EQ(list.capacity(), 16);
+  EXPECT_EQ(contents(list),
+            (std::vector<std::string>{"4", "a", "b", "5", "a", "b", "c", "d", "e"}));
+
+  list.moveToPos(3);
+  list.removeRange(4);
+  list.moveToStart();
+  list.insertRange(batch + 3, batch + 5);
+  EXPECT_EQ(contents(list), (std::vector<std::string>{"d", "e", "4", "a", "b", "d", "e"}));
+}
+
+TEST(CircularAListTest, AppendOwnElementWhileGrowing) {
+  const std::string longValue(40, 'x'); // Heap-allocated, so a dangling copy is visible
+  CircularAList<std::string> list(1);
+  list.append(longValue);
+
+  list.append(list.getValue());
+  list.moveToEnd();
+  list.prev();
+  EXPECT_EQ(list.getValue(), longValue);
+
+  // insert() at the end takes the same path
+  ASSERT_EQ(list.capacity(), 2);
+  list.moveToStart();
+  const std::string& own = list.getValue();
+  list.moveToEnd();
+  list.insert(own);
+  EXPECT_EQ(list.getValue(), longValue);
+  EXPECT_EQ(list.capacity(), 4);
+}
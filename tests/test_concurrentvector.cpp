@@ -0,0 +1,169 @@
+#include "../ds/ConcurrentVector.h"
+#include "CountingResource.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentVectorTest, SequentialPushBack) {
+  ConcurrentVector<int> vec;
+  EXPECT_TRUE(vec.empty());
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(vec.push_back(i * 2), static_cast<std::size_t>(i));
+  }
+
+  EXPECT_EQ(vec.size(), 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(vec[i], i * 2);
+  }
+}
+
+TEST(ConcurrentVectorTest, AddressesNeverChange) {
+  ConcurrentVector<std::string> vec;
+  vec.push_back("first");
+  const std::string* first = &vec[0];
+
+  for (int i = 0; i < 10000; ++i) {
+    vec.emplace_back(std::to_string(i));
+  }
+
+  EXPECT_EQ(&vec[0], first);
+  EXPECT_EQ(*first, "first");
+  EXPECT_EQ(vec[10000], "9999");
+}
+
+TEST(ConcurrentVectorTest, AtChecksPublication) {
+  ConcurrentVector<int> vec;
+  vec.push_back(5);
+
+  EXPECT_TRUE(vec.published(0));
+  EXPECT_FALSE(vec.published(1));
+  EXPECT_EQ(vec.at(0), 5);
+  EXPECT_THROW(vec.at(1), std::out_of_range);
+}
+
+namespace {
+  struct ThrowOnNegative {
+    static inline int live = 0;
+    int value;
+
+    explicit ThrowOnNegative(int v) : value{v} {
+      if (v < 0) {
+        throw std::runtime_error("negative");
+      }
+      ++live;
+    }
+    ~ThrowOnNegative() {
+      --live;
+    }
+  };
+} // namespace
+
+TEST(ConcurrentVectorTest, ThrowingConstructorLeavesUnpublishedHole) {
+  {
+    ConcurrentVector<ThrowOnNegative> vec;
+    vec.emplace_back(1);
+    EXPECT_THROW(vec.emplace_back(-1), std::runtime_error);
+    vec.emplace_back(3);
+
+    EXPECT_EQ(vec.size(), 3u);
+    EXPECT_TRUE(vec.published(0));
+    EXPECT_FALSE(vec.published(1));
+    EXPECT_EQ(vec[2].value, 3);
+    EXPECT_EQ(ThrowOnNegative::live, 2);
+  }
+
+  // Only the published elements were destroyed
+  EXPECT_EQ(ThrowOnNegative::live, 0);
+}
+
+TEST(ConcurrentVectorTest, ReserveAllocatesUpFront) {
+  CountingResource resource;
+  {
+    ConcurrentVector<int, std::pmr::polymorphic_allocator<int>> vec(&resource);
+    vec.reserve(100);
+    const std::size_t allocations = resource.allocations;
+
+    for (int i = 0; i < 100; ++i) {
+      vec.push_back(i);
+    }
+    EXPECT_EQ(resource.allocations, allocations);
+  }
+
+  EXPECT_EQ(resource.bytesInUse, 0u);
+}
+
+TEST(ConcurrentVectorTest, ClearFreesEverything) {
+  CountingResource resource;
+  ConcurrentVector<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>> vec(
+      &resource);
+  for (int i = 0; i < 50; ++i) {
+    vec.emplace_back("a string long enough to need its own heap allocation");
+  }
+
+  // Elements were built with uses-allocator construction
+  EXPECT_EQ(vec[0].get_allocator().resource(), &resource);
+
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(resource.bytesInUse, 0u);
+}
+
+TEST(ConcurrentVectorTest, ConcurrentProducers) {
+  constexpr int THREADS = 8;
+  constexpr int PER_THREAD = 20000;
+
+  ConcurrentVector<long> vec;
+  std::vector<std::thread> producers;
+  for (int t = 0; t < THREADS; ++t) {
+    producers.emplace_back([&vec, t] {
+      for (int i = 0; i < PER_THREAD; ++i) {
+        const std::size_t index = vec.push_back(long{t} * PER_THREAD + i);
+        ASSERT_EQ(vec[index], long{t} * PER_THREAD + i);
+      }
+    });
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+
+  ASSERT_EQ(vec.size(), std::size_t{THREADS} * PER_THREAD);
+
+  // Every value appears exactly once
+  std::vector<bool> seen(vec.size());
+  for (std::size_t i = 0; i < vec.size(); ++i) {
+    ASSERT_FALSE(seen[vec[i]]);
+    seen[vec[i]] = true;
+  }
+}
+
+TEST(ConcurrentVectorTest, ReadersSeePublishedElements) {
+  ConcurrentVector<std::size_t> vec;
+  std::atomic<bool> done{false};
+
+  std::thread writer([&] {
+    for (std::size_t i = 0; i < 50000; ++i) {
+      vec.push_back(i);
+    }
+    done = true;
+  });
+
+  std::size_t checked = 0;
+  while (!done || checked < vec.size()) {
+    const std::size_t size = vec.size();
+    for (std::size_t i = checked; i < size; ++i) {
+      if (vec.published(i)) {
+        ASSERT_EQ(vec[i], i);
+      }
+    }
+    checked = size;
+  }
+
+  writer.join();
+  EXPECT_EQ(vec.size(), 50000u);
+}
@@ -0,0 +1,247 @@
+#include "../ds/AList.h"
+#include "../ds/ContainerStats.h"
+#include "../ds/HugeVector.h"
+#include "../ds/LList.h"
+#include "../ds/SegmentedVector.h"
+#include "../ds/Serialization.h"
+#include "../ds/SmallVector.h"
+#include "../ds/Vector.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Built twice: into unit_tests (hooks compiled out) and into container_stats_tests
+// (DS_CONTAINER_STATS defined).
+
+namespace {
+  // Copyable, with a move constructor that may throw: growth must copy it
+  struct ThrowingMove {
+    int value = 0;
+    ThrowingMove() = default;
+    ThrowingMove(const ThrowingMove&) = default;
+    ThrowingMove(ThrowingMove&& other) noexcept(false) : value{other.value} {}
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+  };
+} // namespace
+
+#ifndef DS_CONTAINER_STATS
+
+TEST(ContainerStatsTest, DisabledHooksAddNoState) {
+  struct VectorLayout {
+    std::allocator<int> alloc;
+    int* elements;
+    std::size_t capacity;
+    std::size_t size;
+  };
+
+  EXPECT_TRUE(std::is_empty_v<ContainerStatsRecorder>);
+  EXPECT_EQ(sizeof(Vector<int>), sizeof(VectorLayout));
+
+  Vector<int> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(vec.stats().allocations, 0u);
+  EXPECT_EQ(globalContainerStats().allocations, 0u);
+}
+
+#else
+
+TEST(ContainerStatsTest, VectorCountsGrowth) {
+  Vector<int> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(i);
+  }
+
+  // Doubling from 16: 16, 32, 64, 128
+  const ContainerStats& stats = vec.stats();
+  EXPECT_EQ(stats.allocations, 4u);
+  EXPECT_EQ(stats.bytesAllocated, (16u + 32u + 64u + 128u) * sizeof(int));
+  EXPECT_EQ(stats.reallocations, 3u);
+  EXPECT_EQ(stats.elementsMoved, 16u + 32u + 64u);
+  EXPECT_EQ(stats.elementsCopied, 0u);
+  EXPECT_EQ(stats.peakCapacity, 128u);
+
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.stats().reallocations, 4u);
+  EXPECT_EQ(vec.stats().peakCapacity, 128u);
+}
+
+TEST(ContainerStatsTest, ReserveAvoidsReallocation) {
+  Vector<std::string> vec;
+  vec.reserve(100);
+  for (int i = 0; i < 100; ++i) {
+    vec.emplace_back("x");
+  }
+
+  EXPECT_EQ(vec.stats().allocations, 1u);
+  EXPECT_EQ(vec.stats().reallocations, 0u);
+  EXPECT_EQ(vec.stats().elementsMoved, 0u);
+}
+
+TEST(ContainerStatsTest, ThrowingMoveIsCountedAsCopy) {
+  Vector<ThrowingMove> vec;
+  for (int i = 0; i < 17; ++i) {
+    vec.push_back(ThrowingMove{});
+  }
+
+  EXPECT_EQ(vec.stats().reallocations, 1u);
+  EXPECT_EQ(vec.stats().elementsCopied, 16u);
+  EXPECT_EQ(vec.stats().elementsMoved, 0u);
+}
+
+TEST(ContainerStatsTest, CopiesStartFresh) {
+  Vector<int> vec;
+  for (int i = 0; i < 20; ++i) {
+    vec.push_back(i);
+  }
+
+  Vector<int> copy(vec);
+  EXPECT_EQ(copy.stats().allocations, 1u);
+  EXPECT_EQ(copy.stats().elementsCopied, 20u);
+  EXPECT_EQ(copy.stats().reallocations, 0u);
+
+  Vector<int> moved(std::move(vec));
+  EXPECT_EQ(moved.stats().allocations, 0u);
+
+  Vector<int> assigned;
+  assigned = copy;
+  EXPECT_EQ(assigned.stats().allocations, 1u);
+  EXPECT_EQ(assigned.stats().elementsCopied, 20u);
+}
+
+TEST(ContainerStatsTest, AListCountsResize) {
+  AList<int> list(4);
+  for (int i = 0; i < 9; ++i) {
+    list.append(i);
+  }
+
+  // 4 -> 8 -> 16
+  EXPECT_EQ(list.stats().allocations, 3u);
+  EXPECT_EQ(list.stats().reallocations, 2u);
+  EXPECT_EQ(list.stats().elementsMoved, 4u + 8u);
+  EXPECT_EQ(list.stats().peakCapacity, 16u);
+}
+
+TEST(ContainerStatsTest, LListCountsNodes) {
+  LList<int> list;
+  for (int i = 0; i < 10; ++i) {
+    list.append(i);
+  }
+  list.moveToStart();
+  list.remove();
+
+  EXPECT_EQ(list.stats().allocations, 11u); // Header plus ten elements
+  EXPECT_EQ(list.stats().bytesAllocated, 11 * sizeof(Link<int>));
+  EXPECT_EQ(list.stats().reallocations, 0u);
+  EXPECT_EQ(list.stats().peakCapacity, 10u);
+
+  LList<int> copy(list);
+  EXPECT_EQ(copy.stats().elementsCopied, 9u);
+}
+
+TEST(ContainerStatsTest, SmallVectorCountsOnlyHeapStorage) {
+  SmallVector<int, 8> vec;
+  for (int i = 0; i < 8; ++i) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(vec.stats().allocations, 0u);
+
+  vec.push_back(8); // Spills the 8 inline elements to 16 heap slots
+  vec.reserve(100);
+  EXPECT_EQ(vec.stats().allocations, 2u);
+  EXPECT_EQ(vec.stats().bytesAllocated, (16u + 100u) * sizeof(int));
+  EXPECT_EQ(vec.stats().reallocations, 2u);
+  EXPECT_EQ(vec.stats().elementsMoved, 8u + 9u);
+  EXPECT_EQ(vec.stats().peakCapacity, 100u);
+
+  vec.resize(4);
+  vec.shrink_to_fit(); // Back inline
+  EXPECT_EQ(vec.stats().reallocations, 3u);
+  EXPECT_EQ(vec.stats().elementsMoved, 8u + 9u + 4u);
+
+  SmallVector<int, 8> copy(vec);
+  EXPECT_EQ(copy.stats().allocations, 0u);
+  EXPECT_EQ(copy.stats().elementsCopied, 4u);
+}
+
+TEST(ContainerStatsTest, HugeVectorCountsMappings) {
+  HugeVector<int> vec;
+  vec.reserve(10);
+  vec.reserve(1 << 20);
+
+  EXPECT_EQ(vec.stats().allocations, 2u);
+  EXPECT_EQ(vec.stats().reallocations, 1u);
+  EXPECT_EQ(vec.stats().elementsMoved, 0u); // mremap moves pages, not elements
+  EXPECT_EQ(vec.stats().peakCapacity, vec.capacity());
+}
+
+TEST(ContainerStatsTest, SegmentedVectorCountsChunks) {
+  SegmentedVector<int, 16> vec;
+  for (int i = 0; i < 40; ++i) {
+    vec.push_back(i);
+  }
+
+  EXPECT_EQ(vec.stats().allocations, 3u);
+  EXPECT_EQ(vec.stats().bytesAllocated, 3 * 16 * sizeof(int));
+  EXPECT_EQ(vec.stats().reallocations, 0u);
+  EXPECT_EQ(vec.stats().elementsMoved, 0u);
+  EXPECT_EQ(vec.stats().peakCapacity, 48u);
+}
+
+TEST(ContainerStatsTest, GlobalAggregates) {
+  resetGlobalContainerStats();
+
+  {
+    Vector<int> a;
+    a.reserve(1000);
+    LList<int> b;
+    b.append(1);
+  }
+
+  const ContainerStats global = globalContainerStats();
+  EXPECT_EQ(global.allocations, 3u);
+  EXPECT_EQ(global.bytesAllocated, 1000 * sizeof(int) + 2 * sizeof(Link<int>));
+  EXPECT_EQ(global.peakCapacity, 1000u);
+
+  resetGlobalContainerStats();
+  EXPECT_EQ(globalContainerStats().allocations, 0u);
+}
+
+TEST(ContainerStatsTest, DeserializeReservesOnce) {
+  Vector<std::uint8_t> bytes;
+  bytes.resize((std::size_t{3} << 20) + 5, 7); // Several read chunks
+  std::stringstream buffer;
+  BinaryWriter writer(buffer);
+  serialize(writer, bytes);
+  serialize(writer, bytes);
+
+  BinaryReader reader(buffer);
+  Vector<std::uint8_t> vec;
+  deserialize(reader, vec);
+  EXPECT_EQ(vec.size(), bytes.size());
+  EXPECT_EQ(vec.stats().allocations, 1u);
+  EXPECT_EQ(vec.stats().reallocations, 0u);
+
+  // Without the header's count, chunks grow the target geometrically, not to the exact size
+  StreamReader<std::uint8_t> stream(reader);
+  Vector<std::uint8_t> grown;
+  while (stream.appendChunk(grown, 4096) > 0) {
+  }
+  EXPECT_EQ(grown.size(), bytes.size());
+  EXPECT_LE(grown.stats().reallocations, 10u); // 4 KiB doubled up to 4 MiB, not 768 copies
+
+  Vector<int> ints;
+  ints.resize(600000, 3);
+  serialize(writer, ints);
+  AList<int> list(0);
+  deserialize(reader, list);
+  EXPECT_EQ(list.length(), ints.size());
+  EXPECT_EQ(list.stats().allocations, 1u);
+  EXPECT_EQ(list.stats().reallocations, 0u);
+}
+
+#endif // DS_CONTAINER_STATS
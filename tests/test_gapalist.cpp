@@ -0,0 +1,216 @@
+#include "../ds/GapAList.h"
+#include "CountingResource.h"
+#include "ListTestUtils.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST(GapAListTest, InsertMultipleElements) {
+  GapAList<int> list;
+  list.insert(3);
+  list.insert(2);
+  list.insert(1);
+
+  EXPECT_EQ(list.length(), 3);
+
+  list.moveToStart();
+  EXPECT_EQ(list.getValue(), 1);
+
+  list.next();
+  EXPECT_EQ(list.getValue(), 2);
+
+  list.next();
+  EXPECT_EQ(list.getValue(), 3);
+}
+
+TEST(GapAListTest, RemoveAndPositionErrors) {
+  GapAList<int> list;
+  EXPECT_THROW(list.remove(), std::out_of_range);
+  EXPECT_THROW((void)list.getValue(), std::out_of_range);
+  EXPECT_THROW(list.moveToPos(1), std::out_of_range);
+
+  list.append(1);
+  list.append(2);
+  list.moveToPos(1);
+  EXPECT_EQ(list.remove(), 2);
+  EXPECT_THROW(list.remove(), std::out_of_range);
+  list.prev();
+  EXPECT_EQ(list.remove(), 1);
+  EXPECT_EQ(list.length(), 0);
+}
+
+TEST(GapAListTest, RandomEditsMatchVector) {
+  std::mt19937 rng(5);
+  GapAList<std::string> list(1);
+  std::vector<std::string> expected;
+  std::size_t cursor = 0;
+
+  for (int step = 0; step < 3000; ++step) {
+    const unsigned op = rng() % 6;
+    if (op == 0) {
+      cursor = rng() % (expected.size() + 1);
+      list.moveToPos(cursor);
+    } else if (op == 1 && cursor < expected.size()) {
+      ASSERT_EQ(list.remove(), expected[cursor]);
+      expected.erase(expected.begin() + cursor);
+    } else if (op == 2) {
+      list.next();
+      cursor = std::min(cursor + 1, expected.size());
+    } else if (op == 3) {
+      list.append("a" + std::to_string(step));
+      expected.push_back("a" + std::to_string(step));
+    } else {
+      list.insert(std::to_string(step));
+      expected.insert(expected.begin() + cursor, std::to_string(step));
+    }
+
+    ASSERT_EQ(list.length(), expected.size());
+    ASSERT_EQ(list.currPos(), cursor);
+    if (cursor < expected.size()) {
+      ASSERT_EQ(list.getValue(), expected[cursor]) << "step " << step;
+    }
+  }
+  EXPECT_EQ(contents(list), expected);
+}
+
+TEST(GapAListTest, CursorEditsDoNotShiftTail) {
+  GapAList<MoveCounter> list;
+  for (int i = 0; i < 1000; ++i) {
+    list.append(MoveCounter(i));
+  }
+
+  // Typing in the middle: every insert lands next to the previous one
+  list.moveToPos(500);
+  list.reserve(3000);
+  MoveCounter::moves = 0;
+  for (int i = 0; i < 1000; ++i) {
+    list.insert(MoveCounter(-i));
+    list.next();
+  }
+  for (int i = 0; i < 500; ++i) {
+    list.prev();
+    list.remove();
+  }
+
+  // 500 to move the gap once plus one per removed value; AList would shift ~10^6
+  EXPECT_LT(MoveCounter::moves, 1100u);
+  EXPECT_EQ(list.length(), 1500);
+  list.moveToPos(499);
+  EXPECT_EQ(list.getValue().value, 499);
+  list.next();
+  EXPECT_EQ(list.getValue().value, 0);
+}
+
+TEST(GapAListTest, DataClosesTheGap) {
+  GapAList<int> list;
+  for (int i = 0; i < 10; ++i) {
+    list.append(i);
+  }
+  list.moveToPos(3);
+  list.insert(42);
+  list.moveToEnd();
+
+  const int* data = list.data();
+  const int expected[] = {0, 1, 2, 42, 3, 4, 5, 6, 7, 8, 9};
+  for (std::size_t i = 0; i < list.length(); ++i) {
+    EXPECT_EQ(data[i], expected[i]);
+  }
+  EXPECT_EQ(list.currPos(), 11);
+
+  // Inserting an element of the list itself survives the gap move
+  list.moveToPos(3);
+  const int& own = list.getValue();
+  list.moveToPos(8);
+  list.insert(own);
+  EXPECT_EQ(list.getValue(), 42);
+}
+
+TEST(GapAListTest, CopyAndMove) {
+  GapAList<std::string> list(2);
+  for (int i = 0; i < 20; ++i) {
+    list.append(std::to_string(i));
+  }
+  list.moveToPos(5);
+  list.insert("x");
+
+  GapAList<std::string> copy(list);
+  EXPECT_EQ(contents(copy), contents(list));
+  EXPECT_EQ(copy.getValue(), "x");
+
+  copy.remove();
+  GapAList<std::string> moved(std::move(copy));
+  EXPECT_EQ(moved.length(), 20);
+  EXPECT_EQ(moved.getValue(), "5");
+  EXPECT_EQ(copy.length(), 0);
+
+  list = moved;
+  EXPECT_EQ(contents(list), contents(moved));
+  list.shrink_to_fit();
+  EXPECT_EQ(list.capacity(), 20);
+  EXPECT_EQ(list.getValue(), "5");
+}
+
+TEST(GapAListTest, MoveAssignBetweenUnequalAllocators) {
+  CountingResource first;
+  CountingResource second;
+  using PmrList = GapAList<std::string, std::pmr::polymorphic_allocator<std::string>>;
+  {
+    PmrList source(&first);
+    source.append("b");
+    source.moveToStart();
+    source.insert("a");
+    source.next();
+
+    PmrList target(&second);
+    target = std::move(source);
+
+    EXPECT_EQ(target.get_allocator().resource(), &second);
+    EXPECT_EQ(contents(target), (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(target.getValue(), "b");
+    EXPECT_EQ(source.length(), 0);
+  }
+  EXPECT_EQ(first.bytesInUse, 0);
+  EXPECT_EQ(second.bytesInUse, 0);
+}
+
+TEST(GapAListTest, GrowthPolicy) {
+  GapAList<int, std::allocator<int>, AdditiveGrowth<5>> list(2);
+  for (int i = 0; i < 10; ++i) {
+    list.append(i);
+  }
+
+  EXPECT_EQ(list.capacity(), 12);
+  list.moveToPos(9);
+  EXPECT_EQ(list.getValue(), 9);
+  list.clear();
+  EXPECT_EQ(list.capacity(), 12);
+}
+
+TEST(GapAListTest, RangeOperationsFillTheGap) {
+  GapAList<std::string> list(4);
+  const std::string batch[] = {"a", "b", "c"};
+  List<std::string>& base = list;
+
+  base.appendRange(batch, batch + 3);
+  base.moveToPos(1);
+  base.insertRange(batch, batch + 3);
+  EXPECT_EQ(list.getValue(), "a");
+  base.next();
+  base.insertRange(batch + 2, batch + 3);
+  EXPECT_EQ(contents(list), (std::vector<std::string>{"a", "a", "c", "b", "c", "b", "c"}));
+
+  base.moveToPos(2);
+  EXPECT_THROW(base.removeRange(6), std::out_of_range);
+  base.removeRange(3);
+  EXPECT_EQ(list.getValue(), "b");
+  EXPECT_EQ(contents(list), (std::vector<std::string>{"a", "a", "b", "c"}));
+
+  // Inserting part of the list into itself copies the source first
+  list.moveToStart();
+  list.insertRange(list.data() + 2, list.data() + 4);
+  EXPECT_EQ(contents(list), (std::vector<std::string>{"b", "c", "a", "a", "b", "c"}));
+}
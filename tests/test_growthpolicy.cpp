@@ -0,0 +1,46 @@
+#include "../ds/GrowthPolicy.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+
+TEST(GrowthPolicyTest, Doubling) {
+  EXPECT_EQ(DoublingGrowth::next(16, 17, 4), 32);
+  EXPECT_EQ(DoublingGrowth::next(0, 1, 4), 1);
+  EXPECT_EQ(DoublingGrowth::next(16, 100, 4), 100);
+}
+
+TEST(GrowthPolicyTest, HalfAgain) {
+  EXPECT_EQ(HalfAgainGrowth::next(16, 17, 4), 24);
+  EXPECT_EQ(HalfAgainGrowth::next(1, 2, 4), 2);
+}
+
+TEST(GrowthPolicyTest, Additive) {
+  EXPECT_EQ(AdditiveGrowth<1000>::next(5000, 5001, 8), 6000);
+  EXPECT_EQ(AdditiveGrowth<10>::next(0, 50, 8), 50);
+}
+
+TEST(GrowthPolicyTest, FactorSaturatesInsteadOfOverflowing) {
+  const std::size_t maxElements = std::numeric_limits<std::size_t>::max() / 8;
+  EXPECT_EQ(DoublingGrowth::next(maxElements - 1, maxElements, 8), maxElements);
+}
+
+TEST(GrowthPolicyTest, PageRoundsToWholePages) {
+  using Policy = PageGrowth<4096, AdditiveGrowth<1>>;
+  EXPECT_EQ(Policy::next(1024, 1025, 4), 2048); // 4100 bytes round up to 8192
+  EXPECT_EQ(Policy::next(10, 11, 4), 11);       // Below a page: left alone
+  EXPECT_EQ(Policy::next(1000, 1001, 24), 1024); // 24024 bytes round up to 24576
+}
+
+TEST(GrowthPolicyTest, SizeClassRounding) {
+  using Policy = SizeClassGrowth<>;
+  EXPECT_EQ(Policy::roundToSizeClass(1), 16);
+  EXPECT_EQ(Policy::roundToSizeClass(100), 112);
+  EXPECT_EQ(Policy::roundToSizeClass(129), 160);
+  EXPECT_EQ(Policy::roundToSizeClass(256), 256);
+  EXPECT_EQ(Policy::roundToSizeClass(257), 320);
+  EXPECT_EQ(Policy::roundToSizeClass(1000), 1024);
+  EXPECT_EQ(Policy::roundToSizeClass(1025), 1280);
+
+  // 10 x 12-byte elements doubled = 240 bytes -> 256-byte class holds 21 elements
+  EXPECT_EQ(Policy::next(10, 11, 12), 21);
+}
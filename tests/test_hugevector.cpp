@@ -0,0 +1,136 @@
+#include "../ds/HugeVector.h"
+
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+
+#include <cstdint>
+#include <memory>
+#include <unistd.h>
+
+TEST(HugeVectorTest, DefaultConstruction) {
+  HugeVector<int> vec;
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_EQ(vec.capacity(), 0);
+  EXPECT_EQ(vec.data(), nullptr);
+}
+
+TEST(HugeVectorTest, CapacityIsWholePages) {
+  HugeVector<std::uint32_t> vec(1);
+  const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+  EXPECT_EQ(vec.mappedBytes(), pageSize);
+  EXPECT_EQ(vec.capacity(), pageSize / sizeof(std::uint32_t));
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % pageSize, 0);
+}
+
+TEST(HugeVectorTest, GrowPreservesContents) {
+  HugeVector<std::uint64_t> vec;
+  const std::size_t count = 1 << 20; // 8 MiB, several remaps
+  for (std::size_t i = 0; i < count; ++i) {
+    vec.push_back(i * 3);
+  }
+
+  ASSERT_EQ(vec.size(), count);
+  EXPECT_GE(vec.capacity(), count);
+  for (std::size_t i = 0; i < count; i += 4099) {
+    EXPECT_EQ(vec[i], i * 3);
+  }
+  EXPECT_EQ(vec.back(), (count - 1) * 3);
+}
+
+TEST(HugeVectorTest, TransparentHugePagesOption) {
+  HugeVector<char> vec(1, true);
+  EXPECT_TRUE(vec.usesHugePages());
+  EXPECT_EQ(vec.mappedBytes(), std::size_t{2} << 20);
+
+  vec.push_back('x');
+  EXPECT_EQ(vec[0], 'x');
+}
+
+TEST(HugeVectorTest, HugePageMappingsStayAligned) {
+  const std::uintptr_t hugePage = std::uintptr_t{2} << 20;
+  HugeVector<std::uint64_t> vec(1, true);
+  HugeVector<std::uint64_t> neighbour(1, true); // Likely blocks growing vec in place
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % hugePage, 0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(neighbour.data()) % hugePage, 0);
+
+  const std::size_t count = 1 << 20; // 8 MiB
+  for (std::size_t i = 0; i < count; ++i) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % hugePage, 0);
+  EXPECT_EQ(vec.mappedBytes() % hugePage, 0);
+  EXPECT_EQ(vec[count - 1], count - 1);
+  EXPECT_EQ(vec[12345], 12345u);
+}
+
+TEST(HugeVectorTest, EmplaceAndPushBackAliasing) {
+  HugeVector<int> vec;
+  vec.push_back(1);
+  vec.push_back(3);
+  vec.emplace(vec.begin() + 1, 2);
+  vec.emplace(vec.begin(), vec[2]);
+
+  ASSERT_EQ(vec.size(), 4);
+  EXPECT_EQ(vec[0], 3);
+  EXPECT_EQ(vec[1], 1);
+  EXPECT_EQ(vec[2], 2);
+  EXPECT_EQ(vec[3], 3);
+
+  HugeVector<int> full(1);
+  full.resize(full.capacity());
+  full[0] = 42;
+  full.push_back(full[0]); // Forces a remap while referring to an element
+  EXPECT_EQ(full.back(), 42);
+}
+
+TEST(HugeVectorTest, TriviallyRelocatableElements) {
+  HugeVector<std::unique_ptr<int>> vec;
+  for (int i = 0; i < 5000; ++i) {
+    vec.emplace_back(std::make_unique<int>(i));
+  }
+
+  EXPECT_EQ(*vec[4999], 4999);
+  vec.resize(10);
+  EXPECT_EQ(vec.size(), 10);
+}
+
+TEST(HugeVectorTest, CopyMoveAndSwap) {
+  HugeVector<int> original(100, 7);
+  HugeVector<int> copy(original);
+  copy[0] = 1;
+  EXPECT_EQ(original[0], 7);
+
+  HugeVector<int> moved(std::move(copy));
+  EXPECT_EQ(moved[0], 1);
+  EXPECT_TRUE(copy.empty());
+
+  moved.swap(original);
+  EXPECT_EQ(moved[0], 7);
+  EXPECT_EQ(original[0], 1);
+}
+
+TEST(HugeVectorTest, ShrinkAndClear) {
+  HugeVector<int> vec;
+  vec.resize(100000);
+  vec.resize(10);
+  vec.shrink_to_fit();
+  EXPECT_LT(vec.capacity(), 100000);
+  EXPECT_EQ(vec.size(), 10);
+
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 0);
+}
+
+TEST(HugeVectorTest, AccessorsThrowWhenEmpty) {
+  HugeVector<int> vec;
+  EXPECT_THROW(vec.front(), std::out_of_range);
+  EXPECT_THROW(vec.back(), std::out_of_range);
+  EXPECT_THROW(vec.pop_back(), std::out_of_range);
+  EXPECT_THROW(vec.at(0), std::out_of_range);
+}
+
+#endif // defined(__linux__)
@@ -1,6 +1,9 @@
 #include "../ds/LList.h"
+#include "CountingResource.h"
 
 #include <gtest/gtest.h>
+#include <memory_resource>
+#include <string>
 
 TEST(LListTest, DefaultConstruction) {
   LList<int> list;
@@ -201,3 +204,116 @@ TEST(LListTest, InvalidPositionThrows) {
 
   EXPECT_THROW(list.moveToPos(5), std::out_of_range);
 }
+
+TEST(LListTest, PolymorphicAllocatorOwnsNodes) {
+  CountingResource resource;
+  {
+    LList<int, std::pmr::polymorphic_allocator<int>> list(&resource);
+    for (int i = 0; i < 10; ++i) {
+      list.append(i);
+    }
+    EXPECT_EQ(resource.allocations, 11); // Header plus one node per element
+
+    list.moveToStart();
+    list.remove();
+    EXPECT_EQ(resource.deallocations, 1);
+  }
+  EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+TEST(LListTest, MoveAssignBetweenUnequalAllocators) {
+  CountingResource first;
+  CountingResource second;
+  using PmrList = LList<std::string, std::pmr::polymorphic_allocator<std::string>>;
+
+  PmrList source(&first);
+  source.append("a");
+  source.append("b");
+  source.next();
+
+  PmrList target(&second);
+  target = std::move(source);
+
+  EXPECT_EQ(target.get_allocator().resource(), &second);
+  EXPECT_EQ(target.length(), 2);
+  EXPECT_EQ(target.getValue(), "b");
+  EXPECT_EQ(source.length(), 0);
+  EXPECT_EQ(first.bytesInUse, sizeof(Link<std::string>));      // Fresh header only
+  EXPECT_EQ(second.bytesInUse, 3 * sizeof(Link<std::string>)); // Header plus two nodes
+}
+
+TEST(LListTest, RangeOperationsSpliceChains) {
+  CountingResource resource;
+  {
+    LList<std::string, std::pmr::polymorphic_allocator<std::string>> list(&resource);
+    const std::string batch[] = {"a", "b", "c"};
+    List<std::string>& base = list;
+
+    base.appendRange(batch, batch + 3);
+    base.moveToPos(1);
+    base.insertRange(batch, batch + 2);
+    EXPECT_EQ(list.getValue(), "a");
+    EXPECT_EQ(resource.allocations, 6u); // Header plus one node per element
+
+    base.moveToEnd();
+    base.insertRange(batch + 2, batch + 3);
+    base.appendRange(batch, batch + 1);
+
+    std::string joined;
+    list.forEach([&](const std::string& s) { joined += s; });
+    EXPECT_EQ(joined, "aabbcca");
+
+    base.moveToPos(4);
+    EXPECT_THROW(base.removeRange(4), std::out_of_range);
+    EXPECT_EQ(list.length(), 7);
+    base.removeRange(3);
+    EXPECT_EQ(resource.deallocations, 3u);
+    base.append("z"); // The tail moved back to the cursor
+    joined.clear();
+    list.forEach([&](const std::string& s) { joined += s; });
+    EXPECT_EQ(joined, "aabbz");
+  }
+  EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+namespace {
+  // Copy constructor that throws once copiesLeft runs out
+  struct CopyLimit {
+    static inline int copiesLeft = 0;
+    int value = 0;
+
+    CopyLimit() = default;
+    CopyLimit(int v) : value{v} {
+    }
+    CopyLimit(const CopyLimit& other) : value{other.value} {
+      if (copiesLeft-- == 0) {
+        throw std::runtime_error("copy failed");
+      }
+    }
+    CopyLimit& operator=(const CopyLimit&) = default;
+  };
+} // namespace
+
+TEST(LListTest, CopyAssignmentThatThrowsKeepsList) {
+  CopyLimit::copiesLeft = 100;
+  LList<CopyLimit> source;
+  LList<CopyLimit> target;
+  for (int i = 0; i < 5; ++i) {
+    source.append(i);
+    target.append(10 + i);
+  }
+  target.moveToPos(2);
+
+  CopyLimit::copiesLeft = 3;
+  EXPECT_THROW(target = source, std::runtime_error);
+  EXPECT_EQ(target.length(), 5);
+  EXPECT_EQ(target.getValue().value, 12);
+
+  CopyLimit::copiesLeft = 100;
+  target.append(15);
+  target.moveToStart();
+  EXPECT_EQ(target.getValue().value, 10);
+  target = source;
+  EXPECT_EQ(target.length(), 5);
+  EXPECT_EQ(target.getValue().value, 0);
+}
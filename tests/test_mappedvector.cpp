@@ -0,0 +1,176 @@
+#include "../ds/MappedVector.h"
+
+#include <gtest/gtest.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+  struct Record {
+    std::uint64_t id;
+    double score;
+  };
+
+  // Unique scratch file, removed when the test ends
+  class TempFile {
+  public:
+    TempFile()
+        : path_{(std::filesystem::temp_directory_path() /
+                 ("mappedvector_" + std::to_string(::getpid()) + "_" +
+                  std::to_string(counter_++)))
+                    .string()} {
+    }
+    ~TempFile() {
+      std::filesystem::remove(path_);
+    }
+
+    const std::string& path() const noexcept {
+      return path_;
+    }
+
+  private:
+    static inline int counter_ = 0;
+    std::string path_;
+  };
+} // namespace
+
+TEST(MappedVectorTest, CreateEmpty) {
+  TempFile file;
+  MappedVector<int> vec(file.path());
+
+  EXPECT_TRUE(vec.empty());
+  EXPECT_FALSE(vec.readOnly());
+  EXPECT_EQ(vec.mappedBytes() % static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)), 0u);
+  EXPECT_EQ(std::filesystem::file_size(file.path()), vec.mappedBytes());
+}
+
+TEST(MappedVectorTest, ContentsPersistAcrossReopen) {
+  TempFile file;
+  {
+    MappedVector<Record> vec(file.path());
+    for (std::uint64_t i = 0; i < 10000; ++i) {
+      vec.push_back(Record{i, i * 0.5});
+    }
+    vec.sync();
+  }
+
+  MappedVector<Record> reopened(file.path(), MapMode::ReadOnly);
+  EXPECT_TRUE(reopened.readOnly());
+  ASSERT_EQ(reopened.size(), 10000u);
+  EXPECT_EQ(reopened[1234].id, 1234u);
+  EXPECT_EQ(reopened.back().score, 9999 * 0.5);
+}
+
+TEST(MappedVectorTest, AppendGrowsFile) {
+  TempFile file;
+  MappedVector<std::uint32_t> vec(file.path());
+  const std::size_t initialBytes = vec.mappedBytes();
+
+  for (std::uint32_t i = 0; i < 100000; ++i) {
+    vec.push_back(i);
+  }
+
+  EXPECT_GT(vec.mappedBytes(), initialBytes);
+  EXPECT_GE(vec.capacity(), vec.size());
+  EXPECT_EQ(std::filesystem::file_size(file.path()), vec.mappedBytes());
+  EXPECT_EQ(vec[99999], 99999u);
+
+  vec.shrink_to_fit();
+  EXPECT_LT(vec.capacity() - vec.size(), static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)));
+  EXPECT_EQ(vec[99999], 99999u);
+}
+
+TEST(MappedVectorTest, ReopenReadWriteAndAppend) {
+  TempFile file;
+  {
+    MappedVector<int> vec(file.path());
+    vec.push_back(1);
+    vec.push_back(2);
+  }
+  {
+    MappedVector<int> vec(file.path());
+    vec.push_back(vec[0]); // Argument aliases an element
+    vec.pop_back();
+    vec.push_back(3);
+  }
+
+  MappedVector<int> vec(file.path(), MapMode::ReadOnly);
+  ASSERT_EQ(vec.size(), 3u);
+  EXPECT_EQ(vec[2], 3);
+}
+
+TEST(MappedVectorTest, ResizeValueInitializes) {
+  TempFile file;
+  MappedVector<double> vec(file.path());
+  vec.resize(5000);
+
+  EXPECT_EQ(vec.size(), 5000u);
+  for (double x : vec) {
+    ASSERT_EQ(x, 0.0);
+  }
+
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+}
+
+TEST(MappedVectorTest, ReadOnlyRejectsModifiers) {
+  TempFile file;
+  {
+    MappedVector<int> vec(file.path());
+    vec.push_back(7);
+  }
+
+  MappedVector<int> vec(file.path(), MapMode::ReadOnly);
+  EXPECT_THROW(vec.push_back(1), std::logic_error);
+  EXPECT_THROW(vec.resize(10), std::logic_error);
+  EXPECT_THROW(vec.clear(), std::logic_error);
+  EXPECT_EQ(vec.at(0), 7);
+}
+
+TEST(MappedVectorTest, RejectsMismatchedFiles) {
+  TempFile file;
+  {
+    MappedVector<std::uint32_t> vec(file.path());
+    vec.push_back(1);
+  }
+
+  EXPECT_THROW(MappedVector<std::uint64_t>(file.path()), std::runtime_error);
+
+  TempFile garbage;
+  std::ofstream(garbage.path()) << "definitely not a mapped vector, but long enough to "
+                                   "cover the whole sixty-four byte header";
+  EXPECT_THROW(MappedVector<int>(garbage.path(), MapMode::ReadOnly), std::runtime_error);
+}
+
+TEST(MappedVectorTest, MissingFileReadOnlyThrows) {
+  TempFile file;
+  EXPECT_THROW(MappedVector<int>(file.path(), MapMode::ReadOnly), std::system_error);
+}
+
+TEST(MappedVectorTest, MoveTransfersMapping) {
+  TempFile file;
+  MappedVector<int> vec(file.path());
+  vec.push_back(42);
+
+  MappedVector<int> moved(std::move(vec));
+  EXPECT_EQ(moved[0], 42);
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.data(), nullptr);
+
+  // The moved-from vector is closed, not an empty writable file
+  EXPECT_THROW(vec.clear(), std::logic_error);
+  EXPECT_THROW(vec.push_back(1), std::logic_error);
+  EXPECT_THROW(vec.reserve(10), std::logic_error);
+
+  MappedVector<int> assigned(file.path());
+  assigned = std::move(moved);
+  EXPECT_EQ(assigned[0], 42);
+  EXPECT_THROW(moved.resize(1), std::logic_error);
+}
+
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,144 @@
+#include "../ds/PackedIntVector.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+  const IntPacking ALL_PACKINGS[] = {
+      IntPacking::FixedWidth, IntPacking::FrameOfReference, IntPacking::DeltaVarint};
+
+  // Non-decreasing values from base, with gaps below maxGap
+  template <typename T>
+  std::vector<T> sortedValues(std::size_t count, T base, std::uint64_t maxGap) {
+    std::mt19937_64 rng(count);
+    std::uniform_int_distribution<std::uint64_t> gap(0, maxGap - 1);
+    std::vector<T> values;
+    T value = base;
+    for (std::size_t i = 0; i < count; ++i) {
+      value += static_cast<T>(gap(rng));
+      values.push_back(value);
+    }
+    return values;
+  }
+
+  template <typename T>
+  void checkRoundTrip(IntPacking packing, unsigned width, const std::vector<T>& values) {
+    PackedIntVector<T> packed(packing, width);
+    packed.append(values.data(), values.size());
+    ASSERT_EQ(packed.size(), values.size());
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(packed[i], values[i]) << "index " << i;
+    }
+
+    std::size_t i = 0;
+    for (T value : packed) {
+      ASSERT_EQ(value, values[i++]);
+    }
+    EXPECT_EQ(i, values.size());
+
+    Vector<T> decoded;
+    decoded.push_back(7);
+    packed.decode(decoded);
+    ASSERT_EQ(decoded.size(), values.size() + 1);
+    EXPECT_EQ(decoded[0], 7u);
+    for (std::size_t j = 0; j < values.size(); ++j) {
+      ASSERT_EQ(decoded[j + 1], values[j]) << "index " << j;
+    }
+  }
+} // namespace
+
+TEST(PackedIntVectorTest, RoundTripsEveryEncoding) {
+  for (std::size_t size : {0, 1, 127, 128, 129, 1000}) {
+    const auto small = sortedValues<std::uint32_t>(size, 0, 1000); // Below 2^20
+    for (IntPacking packing : ALL_PACKINGS) {
+      checkRoundTrip<std::uint32_t>(packing, 20, small);
+    }
+
+    const auto large = sortedValues<std::uint64_t>(size, std::uint64_t{1} << 50,
+                                                   std::uint64_t{1} << 40);
+    checkRoundTrip<std::uint64_t>(IntPacking::FixedWidth, 64, large);
+    checkRoundTrip<std::uint64_t>(IntPacking::FrameOfReference, 0, large);
+    checkRoundTrip<std::uint64_t>(IntPacking::DeltaVarint, 0, large);
+  }
+}
+
+TEST(PackedIntVectorTest, IteratorStartsMidBlock) {
+  const auto values = sortedValues<std::uint32_t>(300, 5, 1000);
+  PackedIntVector<std::uint32_t> packed(IntPacking::DeltaVarint);
+  packed.append(values.data(), values.size());
+
+  PackedIntVector<std::uint32_t>::const_iterator it(&packed, 200);
+  for (std::size_t i = 200; i < values.size(); ++i, ++it) {
+    ASSERT_EQ(*it, values[i]);
+  }
+  EXPECT_EQ(it, packed.end());
+  EXPECT_THROW(packed.at(300), std::out_of_range);
+}
+
+TEST(PackedIntVectorTest, CompressesSmallRanges) {
+  const std::size_t count = 100000;
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<std::uint32_t> counter(0, 4095);
+  std::vector<std::uint32_t> counters(count);
+  for (std::uint32_t& c : counters) {
+    c = 1000000 + counter(rng);
+  }
+
+  // 12-bit offsets from a large base: a bit over 1.5 bytes per value instead of 4
+  PackedIntVector<std::uint32_t> forPacked(IntPacking::FrameOfReference);
+  forPacked.append(counters.data(), counters.size());
+  forPacked.shrink_to_fit();
+  EXPECT_LT(forPacked.memoryBytes(), count * 17 / 10);
+
+  // Sorted IDs with gaps below 128: one byte per value, plus the block headers, instead of 8
+  const auto ids = sortedValues<std::uint64_t>(count, 0, 128);
+  PackedIntVector<std::uint64_t> deltaPacked(IntPacking::DeltaVarint);
+  deltaPacked.append(ids.data(), ids.size());
+  deltaPacked.shrink_to_fit();
+  EXPECT_LT(deltaPacked.memoryBytes(), count * 5 / 4);
+  EXPECT_EQ(deltaPacked[count - 1], ids.back());
+}
+
+TEST(PackedIntVectorTest, RejectsValuesTheEncodingCannotHold) {
+  EXPECT_THROW(PackedIntVector<std::uint32_t>(IntPacking::FixedWidth, 0), std::invalid_argument);
+  EXPECT_THROW(PackedIntVector<std::uint32_t>(IntPacking::FixedWidth, 33), std::invalid_argument);
+
+  PackedIntVector<std::uint32_t> fixed(IntPacking::FixedWidth, 4);
+  fixed.push_back(15);
+  EXPECT_THROW(fixed.push_back(16), std::out_of_range);
+
+  PackedIntVector<std::uint32_t> delta(IntPacking::DeltaVarint);
+  delta.push_back(10);
+  EXPECT_THROW(delta.push_back(9), std::invalid_argument);
+  EXPECT_EQ(delta.size(), 1u);
+
+  delta.clear();
+  delta.push_back(3);
+  EXPECT_EQ(delta[0], 3u);
+}
+
+TEST(PackedIntVectorTest, UnpackMatchesAcrossSimdLevels) {
+  const SimdLevel levels[] = {
+      SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512};
+  std::mt19937_64 rng(7);
+  std::vector<std::uint64_t> words(64);
+  for (std::uint64_t& w : words) {
+    w = rng();
+  }
+
+  for (unsigned width = 0; width <= 32; ++width) {
+    const std::size_t count = width == 0 ? 100 : (words.size() - 1) * 64 / width;
+    std::vector<std::uint32_t> expected(count);
+    std::vector<std::uint32_t> actual(count);
+    SimdScalar::unpack32(words.data(), width, expected.data(), count);
+    for (SimdLevel level : levels) {
+      simdUnpack32(words.data(), width, actual.data(), count, level);
+      EXPECT_EQ(actual, expected) << "width " << width;
+    }
+  }
+  EXPECT_THROW(simdUnpack32(words.data(), 33, nullptr, 0), std::out_of_range);
+}
@@ -0,0 +1,156 @@
+#include "../al/Parallel.h"
+#include "../ds/Vector.h"
+
+#include <algorithm>
+#include <functional>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  Vector<int> randomInts(std::size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(-1000, 1000);
+
+    Vector<int> vec;
+    vec.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      vec.push_back(dist(gen));
+    }
+    return vec;
+  }
+
+  const std::size_t GRAINS[] = {0, 1, 7, 100, 100000};
+} // namespace
+
+TEST(ParallelTest, ForEach) {
+  ThreadPool pool(4);
+
+  for (std::size_t grain : GRAINS) {
+    Vector<int> vec(5000, 1);
+    parallelForEach(pool, vec, [](int& x) { x *= 3; }, grain);
+    EXPECT_EQ(std::count(vec.begin(), vec.end(), 3), 5000);
+  }
+}
+
+TEST(ParallelTest, Transform) {
+  ThreadPool pool(4);
+  const Vector<int> vec = randomInts(10000, 1);
+
+  for (std::size_t grain : GRAINS) {
+    Vector<long> out;
+    parallelTransform(pool, vec, out, [](int x) { return long{x} * x; }, grain);
+
+    ASSERT_EQ(out.size(), vec.size());
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+      EXPECT_EQ(out[i], long{vec[i]} * vec[i]);
+    }
+  }
+}
+
+TEST(ParallelTest, Reduce) {
+  ThreadPool pool(4);
+  const Vector<int> vec = randomInts(12345, 2);
+  const long expected = std::accumulate(vec.begin(), vec.end(), 10L);
+
+  for (std::size_t grain : GRAINS) {
+    EXPECT_EQ(parallelReduce(pool, vec, 10L, std::plus<>{}, grain), expected);
+  }
+
+  Vector<int> empty;
+  EXPECT_EQ(parallelReduce(pool, empty, 42L), 42L);
+}
+
+TEST(ParallelTest, ReduceKeepsOrderForNonCommutativeOp) {
+  ThreadPool pool(4);
+  Vector<std::string> words;
+  for (int i = 0; i < 500; ++i) {
+    words.push_back(std::to_string(i % 10));
+  }
+
+  const std::string expected = std::accumulate(words.begin(), words.end(), std::string(">"));
+  EXPECT_EQ(parallelReduce(pool, words, std::string(">"), std::plus<>{}, 16), expected);
+}
+
+TEST(ParallelTest, Sort) {
+  ThreadPool pool(4);
+
+  for (std::size_t grain : GRAINS) {
+    Vector<int> vec = randomInts(20000, 3);
+    std::vector<int> expected(vec.begin(), vec.end());
+    std::sort(expected.begin(), expected.end());
+
+    parallelSort(pool, vec, std::less<>{}, grain == 0 ? 0 : grain + 1);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin()));
+  }
+}
+
+TEST(ParallelTest, SortSplitsMergesOfSkewedRuns) {
+  ThreadPool pool(4);
+
+  for (std::size_t grain : {2, 64}) {
+    // Many duplicates, and halves whose values barely overlap
+    Vector<int> vec;
+    for (int i = 0; i < 10000; ++i) {
+      vec.push_back(i < 5000 ? (i * 7) % 50 : 40 + (i * 13) % 300);
+    }
+    std::vector<int> expected(vec.begin(), vec.end());
+    std::sort(expected.begin(), expected.end());
+
+    parallelSort(pool, vec, std::less<>{}, grain);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin()));
+  }
+}
+
+TEST(ParallelTest, SortWithComparator) {
+  ThreadPool pool(2);
+  Vector<int> vec = randomInts(5000, 4);
+
+  parallelSort(pool, vec, std::greater<>{}, 64);
+  EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end(), std::greater<>{}));
+}
+
+TEST(ParallelTest, InclusiveScan) {
+  ThreadPool pool(4);
+
+  for (std::size_t size : {1, 2, 99, 1000, 4097}) {
+    const Vector<int> vec = randomInts(size, static_cast<unsigned>(size));
+    std::vector<int> expected(size);
+    std::partial_sum(vec.begin(), vec.end(), expected.begin());
+
+    for (std::size_t grain : GRAINS) {
+      Vector<int> out;
+      parallelInclusiveScan(pool, vec, out, std::plus<>{}, grain);
+      ASSERT_EQ(out.size(), size);
+      EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+    }
+  }
+}
+
+TEST(ParallelTest, InclusiveScanInPlace) {
+  ThreadPool pool(3);
+  Vector<int> vec(1000, 1);
+
+  parallelInclusiveScan(pool, vec.begin(), vec.end(), vec.begin(), std::plus<>{}, 64);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(vec[i], i + 1);
+  }
+}
+
+TEST(ParallelTest, ExceptionPropagates) {
+  ThreadPool pool(4);
+  Vector<int> vec(10000, 0);
+  vec[7777] = 1;
+
+  EXPECT_THROW(parallelForEach(
+                   pool, vec,
+                   [](int x) {
+                     if (x == 1) {
+                       throw std::runtime_error("bad element");
+                     }
+                   },
+                   100),
+               std::runtime_error);
+}
@@ -0,0 +1,115 @@
+#include "../ds/Relocate.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+namespace {
+  struct Point {
+    int x;
+    int y;
+  };
+
+  // Opts in to trivial relocation despite a user-provided move constructor.
+  struct Handle {
+    int* resource;
+
+    explicit Handle(int* r) : resource{r} {
+    }
+    Handle(Handle&& other) noexcept : resource{other.resource} {
+      other.resource = nullptr;
+    }
+    ~Handle() {
+      delete resource;
+    }
+  };
+} // namespace
+
+template <>
+struct is_trivially_relocatable<Handle> : std::true_type {};
+
+TEST(RelocateTest, Traits) {
+  EXPECT_TRUE(is_trivially_relocatable_v<int>);
+  EXPECT_TRUE(is_trivially_relocatable_v<Point>);
+  EXPECT_TRUE(is_trivially_relocatable_v<std::unique_ptr<int>>);
+  EXPECT_TRUE(is_trivially_relocatable_v<Handle>);
+  EXPECT_FALSE(is_trivially_relocatable_v<std::string>);
+}
+
+TEST(RelocateTest, UninitializedRelocateTrivial) {
+  Point src[3] = {{1, 2}, {3, 4}, {5, 6}};
+  alignas(Point) unsigned char raw[sizeof(src)];
+  auto* dest = reinterpret_cast<Point*>(raw);
+
+  std::allocator<Point> alloc;
+  uninitializedRelocate(alloc, src, 3, dest);
+  EXPECT_EQ(dest[0].x, 1);
+  EXPECT_EQ(dest[2].y, 6);
+}
+
+TEST(RelocateTest, UninitializedRelocateUniquePtr) {
+  std::allocator<std::unique_ptr<int>> alloc;
+  auto* src = alloc.allocate(2);
+  auto* dest = alloc.allocate(2);
+  ::new (static_cast<void*>(src)) std::unique_ptr<int>(new int(7));
+  ::new (static_cast<void*>(src + 1)) std::unique_ptr<int>(new int(8));
+
+  uninitializedRelocate(alloc, src, 2, dest);
+  EXPECT_EQ(*dest[0], 7);
+  EXPECT_EQ(*dest[1], 8);
+
+  std::destroy_n(dest, 2);
+  alloc.deallocate(src, 2);
+  alloc.deallocate(dest, 2);
+}
+
+TEST(RelocateTest, UninitializedRelocateNonTrivial) {
+  std::allocator<std::string> alloc;
+  auto* src = alloc.allocate(2);
+  auto* dest = alloc.allocate(2);
+  ::new (static_cast<void*>(src)) std::string("alpha");
+  ::new (static_cast<void*>(src + 1)) std::string("beta");
+
+  uninitializedRelocate(alloc, src, 2, dest);
+  EXPECT_EQ(dest[0], "alpha");
+  EXPECT_EQ(dest[1], "beta");
+
+  std::destroy_n(dest, 2);
+  alloc.deallocate(src, 2);
+  alloc.deallocate(dest, 2);
+}
+
+TEST(RelocateTest, RelocateWithinOverlapping) {
+  std::allocator<std::string> alloc;
+  auto* buf = alloc.allocate(4);
+  ::new (static_cast<void*>(buf)) std::string("a");
+  ::new (static_cast<void*>(buf + 1)) std::string("b");
+  ::new (static_cast<void*>(buf + 2)) std::string("c");
+
+  relocateWithin(alloc, buf, 3, buf + 1); // Open a gap at the front
+  ::new (static_cast<void*>(buf)) std::string("z");
+  EXPECT_EQ(buf[0], "z");
+  EXPECT_EQ(buf[3], "c");
+
+  std::destroy_at(buf);
+  relocateWithin(alloc, buf + 1, 3, buf); // Close it again
+  EXPECT_EQ(buf[0], "a");
+  EXPECT_EQ(buf[2], "c");
+
+  std::destroy_n(buf, 3);
+  alloc.deallocate(buf, 4);
+}
+
+TEST(RelocateTest, RelocateWithinOptInType) {
+  std::allocator<Handle> alloc;
+  auto* buf = alloc.allocate(3);
+  ::new (static_cast<void*>(buf)) Handle(new int(1));
+  ::new (static_cast<void*>(buf + 1)) Handle(new int(2));
+
+  relocateWithin(alloc, buf, 2, buf + 1);
+  EXPECT_EQ(*buf[1].resource, 1);
+  EXPECT_EQ(*buf[2].resource, 2);
+
+  std::destroy_n(buf + 1, 2);
+  alloc.deallocate(buf, 3);
+}
@@ -0,0 +1,184 @@
+#include "../ds/SegmentedVector.h"
+#include "CountingResource.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST(SegmentedVectorTest, DefaultConstruction) {
+  SegmentedVector<int> vec;
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.size(), 0u);
+  EXPECT_EQ(vec.capacity(), 0u);
+}
+
+TEST(SegmentedVectorTest, PushBackAcrossChunks) {
+  SegmentedVector<int, 4> vec;
+  for (int i = 0; i < 10; ++i) {
+    vec.push_back(i);
+  }
+
+  EXPECT_EQ(vec.size(), 10u);
+  EXPECT_EQ(vec.capacity(), 12u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(vec[i], i);
+  }
+  EXPECT_EQ(vec.front(), 0);
+  EXPECT_EQ(vec.back(), 9);
+}
+
+TEST(SegmentedVectorTest, ReferencesStayValidOnGrowth) {
+  SegmentedVector<std::string, 8> vec;
+  vec.push_back("anchor");
+  std::string* anchor = &vec[0];
+  auto it = vec.begin();
+
+  for (int i = 0; i < 1000; ++i) {
+    vec.emplace_back(std::to_string(i));
+  }
+
+  EXPECT_EQ(&vec[0], anchor);
+  EXPECT_EQ(*anchor, "anchor");
+  EXPECT_EQ(*it, "anchor"); // Index-based iterators survive growth as well
+}
+
+TEST(SegmentedVectorTest, AtAndEmptyAccessThrow) {
+  SegmentedVector<int> vec;
+  EXPECT_THROW(vec.at(0), std::out_of_range);
+  EXPECT_THROW(vec.front(), std::out_of_range);
+  EXPECT_THROW(vec.back(), std::out_of_range);
+  EXPECT_THROW(vec.pop_back(), std::out_of_range);
+
+  vec.push_back(1);
+  EXPECT_EQ(vec.at(0), 1);
+  EXPECT_THROW(vec.at(1), std::out_of_range);
+}
+
+TEST(SegmentedVectorTest, RandomAccessIterators) {
+  SegmentedVector<int, 16> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(99 - i);
+  }
+
+  std::sort(vec.begin(), vec.end());
+  EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend()));
+  EXPECT_EQ(vec.end() - vec.begin(), 100);
+  EXPECT_EQ(*(vec.begin() + 42), 42);
+  EXPECT_EQ(vec.begin()[17], 17);
+
+  SegmentedVector<int, 16>::const_iterator cit = vec.begin();
+  EXPECT_EQ(*(cit + 99), 99);
+  EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0), 4950);
+}
+
+TEST(SegmentedVectorTest, Emplace) {
+  SegmentedVector<std::string, 4> vec;
+  vec.push_back("a");
+  vec.push_back("c");
+  vec.push_back("d");
+
+  auto it = vec.emplace(vec.cbegin() + 1, "b");
+  EXPECT_EQ(*it, "b");
+  vec.emplace(vec.cend(), "e");
+  vec.emplace(vec.cbegin(), vec[4]); // Argument aliases an element
+
+  const std::vector<std::string> expected{"e", "a", "b", "c", "d", "e"};
+  EXPECT_TRUE(std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()));
+}
+
+TEST(SegmentedVectorTest, ResizeVariants) {
+  SegmentedVector<int, 8> vec;
+  vec.resize(20);
+  EXPECT_EQ(vec.size(), 20u);
+  EXPECT_EQ(std::count(vec.begin(), vec.end(), 0), 20);
+
+  vec.resize(30, 7);
+  EXPECT_EQ(vec[29], 7);
+  EXPECT_EQ(vec[19], 0);
+
+  vec.resize(5);
+  EXPECT_EQ(vec.size(), 5u);
+  EXPECT_EQ(vec.capacity(), 32u);
+
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 8u);
+
+  vec.resize_default_init(100);
+  EXPECT_EQ(vec.size(), 100u);
+}
+
+TEST(SegmentedVectorTest, ReserveAndClearKeepChunks) {
+  SegmentedVector<int, 8> vec;
+  vec.reserve(50);
+  EXPECT_EQ(vec.capacity(), 56u);
+
+  int* first = &vec.emplace_back(1);
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.capacity(), 56u);
+  EXPECT_EQ(&vec.emplace_back(2), first);
+}
+
+TEST(SegmentedVectorTest, CopyAndMove) {
+  SegmentedVector<std::string, 4> vec;
+  for (int i = 0; i < 10; ++i) {
+    vec.push_back(std::to_string(i));
+  }
+
+  SegmentedVector<std::string, 4> copy(vec);
+  EXPECT_EQ(copy.size(), 10u);
+  EXPECT_EQ(copy[9], "9");
+  EXPECT_NE(&copy[0], &vec[0]);
+
+  const std::string* element = &vec[3];
+  SegmentedVector<std::string, 4> moved(std::move(vec));
+  EXPECT_EQ(&moved[3], element); // Chunks are stolen, not copied
+  EXPECT_TRUE(vec.empty());
+
+  SegmentedVector<std::string, 4> assigned;
+  assigned = copy;
+  EXPECT_EQ(assigned[5], "5");
+  assigned = std::move(moved);
+  EXPECT_EQ(&assigned[3], element);
+
+  assigned.swap(copy);
+  EXPECT_EQ(&copy[3], element);
+}
+
+TEST(SegmentedVectorTest, PmrAllocatorUsedForChunksAndDirectory) {
+  CountingResource resource;
+  {
+    SegmentedVector<std::pmr::string, 4, std::pmr::polymorphic_allocator<std::pmr::string>> vec(
+        &resource);
+    for (int i = 0; i < 20; ++i) {
+      vec.emplace_back("long enough to allocate from the resource, surely");
+    }
+
+    EXPECT_EQ(vec[0].get_allocator().resource(), &resource);
+    EXPECT_GT(resource.allocations, 20u);
+  }
+
+  EXPECT_EQ(resource.bytesInUse, 0u);
+  EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+TEST(SegmentedVectorTest, MoveAssignUnequalAllocatorsMovesElements) {
+  CountingResource first;
+  CountingResource second;
+  using PmrSegmented = SegmentedVector<int, 4, std::pmr::polymorphic_allocator<int>>;
+
+  PmrSegmented a(&first);
+  PmrSegmented b(&second);
+  for (int i = 0; i < 9; ++i) {
+    b.push_back(i);
+  }
+
+  a = std::move(b);
+  EXPECT_EQ(a.size(), 9u);
+  EXPECT_EQ(a[8], 8);
+  EXPECT_EQ(a.get_allocator().resource(), &first);
+  EXPECT_TRUE(b.empty());
+}
@@ -0,0 +1,242 @@
+#include "../ds/AList.h"
+#include "../ds/LList.h"
+#include "../ds/Serialization.h"
+#include "../ds/Vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+namespace {
+  struct Point {
+    std::int32_t x;
+    std::int32_t y;
+  };
+
+  // A non-trivially-copyable type with a user-provided Codec
+  struct Named {
+    std::string name;
+    std::int64_t id;
+  };
+} // namespace
+
+template <>
+struct Codec<Named> {
+  static void encode(BinaryWriter& out, const Named& value) {
+    Codec<std::string>::encode(out, value.name);
+    out.writeScalar(value.id);
+  }
+
+  static Named decode(BinaryReader& in) {
+    Named value;
+    value.name = Codec<std::string>::decode(in);
+    value.id = in.readScalar<std::int64_t>();
+    return value;
+  }
+};
+
+TEST(SerializationTest, VectorOfTriviallyCopyableRoundTrip) {
+  Vector<Point> vec;
+  for (std::int32_t i = 0; i < 1000; ++i) {
+    vec.push_back(Point{i, -i});
+  }
+
+  std::stringstream stream;
+  BinaryWriter writer(stream);
+  serialize(writer, vec);
+
+  // Header plus the raw elements, nothing else
+  EXPECT_EQ(stream.str().size(), 20 + 1000 * sizeof(Point));
+
+  Vector<Point> loaded;
+  loaded.push_back(Point{7, 7}); // Replaced, not appended to
+  BinaryReader reader(stream);
+  deserialize(reader, loaded);
+
+  ASSERT_EQ(loaded.size(), 1000u);
+  EXPECT_EQ(loaded[999].x, 999);
+  EXPECT_EQ(loaded[999].y, -999);
+}
+
+TEST(SerializationTest, VectorOfStringsUsesCodec) {
+  Vector<std::string> vec;
+  vec.push_back("");
+  vec.push_back("hello");
+  vec.push_back(std::string(10000, 'x'));
+
+  std::stringstream stream;
+  BinaryWriter writer(stream);
+  serialize(writer, vec);
+
+  Vector<std::string> loaded;
+  BinaryReader reader(stream);
+  deserialize(reader, loaded);
+
+  ASSERT_EQ(loaded.size(), 3u);
+  EXPECT_EQ(loaded[0], "");
+  EXPECT_EQ(loaded[1], "hello");
+  EXPECT_EQ(loaded[2], std::string(10000, 'x'));
+}
+
+TEST(SerializationTest, UserCodec) {
+  Vector<Named> vec;
+  vec.push_back(Named{"alpha", 1});
+  vec.push_back(Named{"beta", -2});
+
+  std::stringstream stream;
+  BinaryWriter writer(stream);
+  serialize(writer, vec);
+
+  Vector<Named> loaded;
+  BinaryReader reader(stream);
+  deserialize(reader, loaded);
+
+  ASSERT_EQ(loaded.size(), 2u);
+  EXPECT_EQ(loaded[1].name, "beta");
+  EXPECT_EQ(loaded[1].id, -2);
+}
+
+TEST(SerializationTest, AListRoundTrip) {
+  AList<double> list;
+  for (int i = 0; i < 300; ++i) {
+    list.append(i * 0.25);
+  }
+
+  std::stringstream stream;
+  BinaryWriter writer(stream);
+  serialize(writer, list);
+
+  AList<double> loaded;
+  BinaryReader reader(stream);
+  deserialize(reader, loaded);
+
+  ASSERT_EQ(loaded.length(), 300u);
+  loaded.moveToPos(299);
+  EXPECT_EQ(loaded.getValue(), 299 * 0.25);
+}
+
+TEST(SerializationTest, LListRoundTrip) {
+  LList<std::string> list;
+  list.append("one");
+  list.append("two");
+  list.append("three");
+
+  std::stringstream stream;
+  BinaryWriter writer(stream);
+  serialize(writer, list);
+
+  LList<std::string> loaded;
+  BinaryReader reader(stream);
+  deserialize(reader, loaded);
+
+  ASSERT_EQ(loaded.length(), 3u);
+  loaded.moveToStart();
+  EXPECT_EQ(loaded.getValue(), "one");
+  loaded.moveToEnd();
+  loaded.prev();
+  EXPECT_EQ(loaded.getValue(), "three");
+}
+
+TEST(SerializationTest, FormatIsSharedAcrossContainers) {
+  LList<std::int32_t> list;
+  for (std::int32_t i = 0; i < 50; ++i) {
+    list.append(i);
+  }
+
+  std::stringstream stream;
+  BinaryWriter writer(stream);
+  serialize(writer, list);
+
+  Vector<std::int32_t> vec;
+  BinaryReader reader(stream);
+  deserialize(reader, vec);
+
+  ASSERT_EQ(vec.size(), 50u);
+  EXPECT_EQ(vec[49], 49);
+}
+
+TEST(SerializationTest, StreamReaderReadsBoundedChunks) {
+  Vector<std::uint16_t> vec;
+  for (int i = 0; i < 1000; ++i) {
+    vec.push_back(static_cast<std::uint16_t>(i));
+  }
+
+  std::stringstream stream;
+  BinaryWriter writer(stream);
+  serialize(writer, vec);
+
+  BinaryReader reader(stream);
+  StreamReader<std::uint16_t> chunks(reader);
+  EXPECT_EQ(chunks.total(), 1000u);
+
+  Vector<std::uint16_t> chunk;
+  std::size_t seen = 0;
+  while (std::size_t n = chunks.readChunk(chunk, 64)) {
+    ASSERT_LE(n, 64u);
+    ASSERT_EQ(chunk.size(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(chunk[i], seen + i);
+    }
+    seen += n;
+  }
+
+  EXPECT_EQ(seen, 1000u);
+  EXPECT_EQ(chunks.remaining(), 0u);
+  EXPECT_LE(chunk.capacity(), 64u); // Capacity reused rather than growing
+}
+
+TEST(SerializationTest, ForeignByteOrderIsConverted) {
+  Vector<std::uint32_t> vec;
+  vec.push_back(0x11223344);
+
+  std::stringstream stream;
+  BinaryWriter writer(stream);
+  serialize(writer, vec);
+
+  // Rewrite the stream as if a host of the other byte order had produced it
+  std::string bytes = stream.str();
+  bytes[5] = static_cast<char>(bytes[5] == 1 ? 2 : 1);
+  std::reverse(bytes.begin() + 8, bytes.begin() + 12);  // element size
+  std::reverse(bytes.begin() + 12, bytes.begin() + 20); // count
+  std::reverse(bytes.begin() + 20, bytes.begin() + 24); // the element
+
+  std::stringstream foreign(bytes);
+  BinaryReader reader(foreign);
+  Vector<std::uint32_t> loaded;
+  deserialize(reader, loaded);
+
+  ASSERT_EQ(loaded.size(), 1u);
+  EXPECT_EQ(loaded[0], 0x11223344u);
+}
+
+TEST(SerializationTest, RejectsBadInput) {
+  Vector<int> vec;
+  vec.push_back(1);
+  vec.push_back(2);
+
+  std::stringstream stream;
+  BinaryWriter writer(stream);
+  serialize(writer, vec);
+  const std::string bytes = stream.str();
+
+  {
+    std::stringstream wrongType(bytes);
+    BinaryReader reader(wrongType);
+    Vector<double> loaded;
+    EXPECT_THROW(deserialize(reader, loaded), SerializationError);
+  }
+  {
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+    BinaryReader reader(truncated);
+    Vector<int> loaded;
+    EXPECT_THROW(deserialize(reader, loaded), SerializationError);
+  }
+  {
+    std::stringstream garbage("not a serialized container");
+    BinaryReader reader(garbage);
+    Vector<int> loaded;
+    EXPECT_THROW(deserialize(reader, loaded), SerializationError);
+  }
+}
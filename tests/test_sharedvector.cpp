@@ -0,0 +1,185 @@
+#include "../ds/SharedVector.h"
+#include "CountingResource.h"
+
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <string>
+#include <thread>
+
+using PmrSharedVector = SharedVector<int, std::pmr::polymorphic_allocator<int>>;
+
+TEST(SharedVectorTest, EmptyAllocatesNothing) {
+  SharedVector<int> vec;
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.useCount(), 0u);
+  EXPECT_EQ(vec.begin(), vec.end());
+  EXPECT_THROW(vec.front(), std::out_of_range);
+  EXPECT_THROW(vec.pop_back(), std::out_of_range);
+}
+
+TEST(SharedVectorTest, AdoptsVectorWithoutCopying) {
+  Vector<std::string> source;
+  source.push_back("a");
+  source.push_back("b");
+  const std::string* elements = source.data();
+
+  SharedVector<std::string> vec(std::move(source));
+  EXPECT_EQ(vec.data(), elements);
+  EXPECT_EQ(vec.size(), 2u);
+  EXPECT_EQ(vec.at(1), "b");
+}
+
+TEST(SharedVectorTest, SnapshotsShareStorage) {
+  CountingResource resource;
+  PmrSharedVector vec(&resource);
+  for (int i = 0; i < 1000; ++i) {
+    vec.push_back(i);
+  }
+  const auto allocations = resource.allocations;
+
+  PmrSharedVector snap = vec.snapshot();
+  PmrSharedVector another = snap;
+
+  EXPECT_EQ(resource.allocations, allocations);
+  EXPECT_EQ(snap.data(), vec.data());
+  EXPECT_EQ(vec.useCount(), 3u);
+}
+
+TEST(SharedVectorTest, FirstMutationCopies) {
+  CountingResource resource;
+  PmrSharedVector vec(&resource);
+  for (int i = 0; i < 10; ++i) {
+    vec.push_back(i);
+  }
+
+  PmrSharedVector snap = vec.snapshot();
+  vec.push_back(10);
+
+  EXPECT_NE(snap.data(), vec.data());
+  EXPECT_EQ(snap.size(), 10u);
+  EXPECT_EQ(vec.size(), 11u);
+  EXPECT_EQ(vec.back(), 10);
+  EXPECT_EQ(snap.useCount(), 1u);
+  EXPECT_EQ(vec.useCount(), 1u);
+
+  // Now unshared: later changes happen in place
+  const auto allocations = resource.allocations;
+  const int* elements = vec.data();
+  vec.mutate()[0] = 42;
+  vec.pop_back();
+  EXPECT_EQ(vec.data(), elements);
+  EXPECT_EQ(resource.allocations, allocations);
+  EXPECT_EQ(vec[0], 42);
+  EXPECT_EQ(snap[0], 0);
+}
+
+TEST(SharedVectorTest, DetachCopiesOnlyLiveElements) {
+  Vector<int> source(1000);
+  source.push_back(1);
+
+  SharedVector<int> vec(std::move(source));
+  SharedVector<int> snap = vec.snapshot();
+  vec.reserve(4);
+
+  EXPECT_LT(vec.mutate().capacity(), 1000u);
+  EXPECT_EQ(vec[0], 1);
+}
+
+TEST(SharedVectorTest, EmplaceFromSharedElement) {
+  SharedVector<std::string> vec;
+  vec.push_back(std::string(64, 'x'));
+  SharedVector<std::string> snap = vec.snapshot();
+
+  vec.push_back(vec[0]); // Refers into the block that detaching releases
+  vec.resize(4, vec[0]);
+
+  EXPECT_EQ(vec.size(), 4u);
+  EXPECT_EQ(vec[3], std::string(64, 'x'));
+  EXPECT_EQ(snap.size(), 1u);
+}
+
+TEST(SharedVectorTest, ClearReleasesSharedElements) {
+  CountingResource resource;
+  PmrSharedVector vec(&resource);
+  vec.resize(100);
+  PmrSharedVector snap = vec.snapshot();
+  const auto allocations = resource.allocations;
+
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(resource.allocations, allocations);
+  EXPECT_EQ(snap.size(), 100u);
+}
+
+TEST(SharedVectorTest, LastHandleFreesStorage) {
+  CountingResource resource;
+  {
+    PmrSharedVector vec(&resource);
+    vec.push_back(1);
+    PmrSharedVector snap = vec.snapshot();
+    PmrSharedVector moved = std::move(vec);
+    EXPECT_EQ(moved.useCount(), 2u);
+  }
+  EXPECT_EQ(resource.bytesInUse, 0u);
+}
+
+TEST(SharedVectorTest, PmrAssignmentKeepsOwnResource) {
+  CountingResource first;
+  CountingResource second;
+  {
+    PmrSharedVector a(&first);
+    a.push_back(1);
+    PmrSharedVector b(&second);
+    b.push_back(2);
+
+    b = a; // Shares a's block; b keeps allocating from its own resource
+    EXPECT_EQ(b.get_allocator().resource(), &second);
+    EXPECT_EQ(a.useCount(), 2u);
+    b.push_back(3);
+    EXPECT_EQ(second.allocations, 4u); // Block and elements, twice
+    EXPECT_EQ(a.size(), 1u);
+
+    PmrSharedVector c(&second);
+    c = std::move(a);
+    EXPECT_EQ(c.get_allocator().resource(), &second);
+    EXPECT_EQ(c[0], 1);
+
+    c.swap(b);
+    EXPECT_EQ(c.size(), 2u);
+    EXPECT_EQ(b.size(), 1u);
+  }
+  EXPECT_EQ(first.bytesInUse, 0u);
+  EXPECT_EQ(second.bytesInUse, 0u);
+}
+
+TEST(SharedVectorTest, ConcurrentReadersAndWriter) {
+  SharedVector<int> config;
+  for (int i = 0; i < 1000; ++i) {
+    config.push_back(i);
+  }
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([snap = config.snapshot()] {
+      for (int round = 0; round < 50; ++round) {
+        SharedVector<int> local = snap;
+        long sum = 0;
+        for (int value : local) {
+          sum += value;
+        }
+        ASSERT_EQ(sum, 999 * 1000 / 2);
+      }
+    });
+  }
+
+  for (int round = 0; round < 50; ++round) {
+    config.mutate()[0] = round;
+    SharedVector<int> published = config.snapshot();
+    config.push_back(round);
+  }
+
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(config.size(), 1050u);
+}
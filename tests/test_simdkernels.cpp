@@ -0,0 +1,132 @@
+#include "../al/SimdKernels.h"
+#include "../ds/Vector.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+  const SimdLevel ALL_LEVELS[] = {
+      SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512};
+
+  // Sizes around every register width, so both full blocks and tails are exercised
+  const std::size_t SIZES[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200, 1000};
+
+  template <typename T>
+  std::vector<T> randomData(std::size_t count, std::uint32_t seed, int lo, int hi) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(lo, hi);
+    std::vector<T> data(count);
+    for (T& x : data) {
+      x = static_cast<T>(dist(gen));
+    }
+    return data;
+  }
+
+  template <typename T>
+  void checkAgainstScalar(int lo, int hi) {
+    for (std::size_t size : SIZES) {
+      const std::vector<T> data = randomData<T>(size, static_cast<std::uint32_t>(size), lo, hi);
+      const T* p = data.data();
+
+      for (SimdLevel level : ALL_LEVELS) {
+        for (int v = lo; v <= hi; v += (hi - lo) / 8 + 1) {
+          const T value = static_cast<T>(v);
+          EXPECT_EQ(simdFind(p, size, value, level), SimdScalar::find(p, size, value));
+          EXPECT_EQ(simdCount(p, size, value, level), SimdScalar::count(p, size, value));
+        }
+
+        if (size > 0) {
+          EXPECT_EQ(simdMin(p, size, level), SimdScalar::min(p, size));
+          EXPECT_EQ(simdMax(p, size, level), SimdScalar::max(p, size));
+        }
+        // Small integer values keep float sums exact, whatever the summation order
+        EXPECT_EQ(simdSum(p, size, level), SimdScalar::sum(p, size));
+      }
+    }
+  }
+} // namespace
+
+TEST(SimdKernelsTest, Int32MatchesScalar) {
+  checkAgainstScalar<std::int32_t>(-50, 50);
+}
+
+TEST(SimdKernelsTest, Uint8MatchesScalar) {
+  checkAgainstScalar<std::uint8_t>(0, 255);
+}
+
+TEST(SimdKernelsTest, FloatMatchesScalar) {
+  checkAgainstScalar<float>(-100, 100);
+}
+
+TEST(SimdKernelsTest, FindReturnsFirstMatch) {
+  std::vector<std::int32_t> data(100, 0);
+  data[40] = 7;
+  data[41] = 7;
+  data[90] = 7;
+
+  for (SimdLevel level : ALL_LEVELS) {
+    EXPECT_EQ(simdFind(data.data(), data.size(), 7, level), 40u);
+    EXPECT_EQ(simdFind(data.data(), data.size(), 8, level), data.size());
+    EXPECT_EQ(simdCount(data.data(), data.size(), 7, level), 3u);
+  }
+}
+
+TEST(SimdKernelsTest, Int32SumDoesNotOverflow) {
+  const std::vector<std::int32_t> data(1000, INT32_MAX);
+
+  for (SimdLevel level : ALL_LEVELS) {
+    EXPECT_EQ(simdSum(data.data(), data.size(), level), std::int64_t{INT32_MAX} * 1000);
+  }
+}
+
+TEST(SimdKernelsTest, Uint8SumDoesNotWrap) {
+  const std::vector<std::uint8_t> data(1000, 255);
+
+  for (SimdLevel level : ALL_LEVELS) {
+    EXPECT_EQ(simdSum(data.data(), data.size(), level), 255000u);
+  }
+}
+
+TEST(SimdKernelsTest, ExtremesAtEitherEnd) {
+  std::vector<std::int32_t> data(77, 5);
+  data.front() = INT32_MIN;
+  data.back() = INT32_MAX;
+
+  for (SimdLevel level : ALL_LEVELS) {
+    EXPECT_EQ(simdMin(data.data(), data.size(), level), INT32_MIN);
+    EXPECT_EQ(simdMax(data.data(), data.size(), level), INT32_MAX);
+  }
+}
+
+TEST(SimdKernelsTest, EmptyMinMaxThrows) {
+  const float* none = nullptr;
+  EXPECT_THROW(simdMin(none, 0), std::out_of_range);
+  EXPECT_THROW(simdMax(none, 0), std::out_of_range);
+}
+
+TEST(SimdKernelsTest, DetectedLevelIsStable) {
+  EXPECT_EQ(simdLevel(), detectSimdLevel());
+}
+
+TEST(SimdKernelsTest, VectorOverloads) {
+  Vector<float> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(static_cast<float>(i % 10));
+  }
+
+  EXPECT_EQ(simdFind(vec, 3), 3u);
+  EXPECT_TRUE(simdContains(vec, 9));
+  EXPECT_FALSE(simdContains(vec, 10));
+  EXPECT_EQ(simdCount(vec, 0), 10u);
+  EXPECT_EQ(simdMin(vec), 0.0f);
+  EXPECT_EQ(simdMax(vec), 9.0f);
+  EXPECT_EQ(simdSum(vec), 450.0f);
+
+  AlignedVector<std::uint8_t> bytes;
+  bytes.resize(300);
+  bytes[250] = 1;
+  EXPECT_EQ(simdFind(bytes, 1), 250u);
+  EXPECT_EQ(simdSum(bytes), 1u);
+}
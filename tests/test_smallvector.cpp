@@ -0,0 +1,280 @@
+#include "../ds/SmallVector.h"
+#include "CountingResource.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+using PmrSmallVector = SmallVector<int, 4, std::pmr::polymorphic_allocator<int>>;
+
+namespace {
+  // Stateful allocator that travels with swap(), drawing from a CountingResource
+  template <typename T>
+  struct SwappingAllocator {
+    using value_type = T;
+    using propagate_on_container_swap = std::true_type;
+
+    CountingResource* resource;
+
+    explicit SwappingAllocator(CountingResource* r) : resource{r} {
+    }
+    template <typename U>
+    SwappingAllocator(const SwappingAllocator<U>& other) : resource{other.resource} {
+    }
+
+    T* allocate(std::size_t n) {
+      return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, std::size_t n) {
+      resource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    friend bool operator==(const SwappingAllocator& a, const SwappingAllocator& b) {
+      return a.resource == b.resource;
+    }
+    friend bool operator!=(const SwappingAllocator& a, const SwappingAllocator& b) {
+      return a.resource != b.resource;
+    }
+  };
+
+  // Copying throws once copiesLeft runs out; moving never throws
+  struct CopyLimit {
+    static inline int copiesLeft = 0;
+    int value;
+
+    explicit CopyLimit(int v) : value{v} {
+    }
+    CopyLimit(const CopyLimit& other) : value{other.value} {
+      if (copiesLeft-- <= 0) {
+        throw std::runtime_error("copy limit");
+      }
+    }
+    CopyLimit(CopyLimit&&) noexcept = default;
+    CopyLimit& operator=(const CopyLimit&) = default;
+    CopyLimit& operator=(CopyLimit&&) noexcept = default;
+  };
+} // namespace
+
+TEST(SmallVectorTest, DefaultConstructionIsInline) {
+  SmallVector<int, 8> vec;
+  EXPECT_EQ(vec.size(), 0);
+  EXPECT_EQ(vec.capacity(), 8);
+  EXPECT_TRUE(vec.isInline());
+  EXPECT_EQ((SmallVector<int, 8>::inlineCapacity()), 8);
+}
+
+TEST(SmallVectorTest, StaysInlineUpToN) {
+  CountingResource resource;
+  PmrSmallVector vec(&resource);
+  for (int i = 0; i < 4; ++i) {
+    vec.push_back(i);
+  }
+
+  EXPECT_TRUE(vec.isInline());
+  EXPECT_EQ(resource.allocations, 0);
+  EXPECT_EQ(vec[3], 3);
+}
+
+TEST(SmallVectorTest, SpillsToHeapPastN) {
+  CountingResource resource;
+  {
+    PmrSmallVector vec(&resource);
+    for (int i = 0; i < 5; ++i) {
+      vec.push_back(i);
+    }
+
+    EXPECT_FALSE(vec.isInline());
+    EXPECT_EQ(resource.allocations, 1);
+    EXPECT_EQ(vec.capacity(), 8);
+    for (int i = 0; i < 5; ++i) {
+      EXPECT_EQ(vec[i], i);
+    }
+  }
+  EXPECT_EQ(resource.bytesInUse, 0);
+}
+
+TEST(SmallVectorTest, ShrinkToFitReturnsInline) {
+  SmallVector<std::string, 2> vec;
+  vec.push_back("a");
+  vec.push_back("b");
+  vec.push_back("c");
+  EXPECT_FALSE(vec.isInline());
+
+  vec.pop_back();
+  vec.shrink_to_fit();
+  EXPECT_TRUE(vec.isInline());
+  EXPECT_EQ(vec[1], "b");
+}
+
+TEST(SmallVectorTest, CountAndValueConstruction) {
+  SmallVector<int, 2> vec(5, 9);
+  EXPECT_EQ(vec.size(), 5);
+  EXPECT_EQ(vec.back(), 9);
+}
+
+TEST(SmallVectorTest, CopyInlineAndHeap) {
+  SmallVector<std::string, 2> small;
+  small.push_back("x");
+  SmallVector<std::string, 2> smallCopy(small);
+  EXPECT_TRUE(smallCopy.isInline());
+  EXPECT_EQ(smallCopy[0], "x");
+
+  SmallVector<std::string, 2> big(3, "y");
+  SmallVector<std::string, 2> bigCopy;
+  bigCopy = big;
+  EXPECT_FALSE(bigCopy.isInline());
+  EXPECT_EQ(bigCopy.size(), 3);
+  EXPECT_EQ(bigCopy[2], "y");
+}
+
+TEST(SmallVectorTest, CopyAssignmentThatThrowsKeepsVector) {
+  SmallVector<CopyLimit, 2> target;
+  SmallVector<CopyLimit, 2> source;
+  for (int i = 0; i < 3; ++i) {
+    target.emplace_back(i);
+    source.emplace_back(10 + i);
+  }
+
+  CopyLimit::copiesLeft = 2;
+  EXPECT_THROW(target = source, std::runtime_error);
+  ASSERT_EQ(target.size(), 3);
+  EXPECT_EQ(target[2].value, 2);
+
+  SmallVector<CopyLimit, 2> inlineTarget;
+  inlineTarget.emplace_back(7);
+  CopyLimit::copiesLeft = 1;
+  EXPECT_THROW(inlineTarget = source, std::runtime_error);
+  ASSERT_EQ(inlineTarget.size(), 1);
+  EXPECT_EQ(inlineTarget[0].value, 7);
+
+  CopyLimit::copiesLeft = 3;
+  inlineTarget = source;
+  EXPECT_EQ(inlineTarget[2].value, 12);
+}
+
+TEST(SmallVectorTest, MoveInlineRelocatesElements) {
+  SmallVector<std::unique_ptr<int>, 4> source;
+  source.push_back(std::make_unique<int>(1));
+  source.push_back(std::make_unique<int>(2));
+
+  SmallVector<std::unique_ptr<int>, 4> target(std::move(source));
+  EXPECT_TRUE(target.isInline());
+  EXPECT_EQ(*target[1], 2);
+  EXPECT_TRUE(source.empty());
+}
+
+TEST(SmallVectorTest, MoveHeapStealsBuffer) {
+  SmallVector<std::string, 1> source(3, "z");
+  const std::string* buffer = source.data();
+
+  SmallVector<std::string, 1> target;
+  target = std::move(source);
+  EXPECT_EQ(target.data(), buffer);
+  EXPECT_TRUE(source.empty());
+  EXPECT_TRUE(source.isInline());
+}
+
+TEST(SmallVectorTest, SwapMixedStorage) {
+  SmallVector<std::string, 2> inlineVec;
+  inlineVec.push_back("i");
+  SmallVector<std::string, 2> heapVec(4, "h");
+
+  inlineVec.swap(heapVec);
+  EXPECT_EQ(inlineVec.size(), 4);
+  EXPECT_FALSE(inlineVec.isInline());
+  EXPECT_EQ(heapVec.size(), 1);
+  EXPECT_TRUE(heapVec.isInline());
+  EXPECT_EQ(heapVec[0], "i");
+}
+
+TEST(SmallVectorTest, SwapPropagatesAllocatorWithInlineSide) {
+  CountingResource first;
+  CountingResource second;
+  using SwapVector = SmallVector<std::string, 2, SwappingAllocator<std::string>>;
+  {
+    SwapVector inlineVec(SwappingAllocator<std::string>{&first});
+    inlineVec.push_back("i");
+    SwapVector heapVec(SwappingAllocator<std::string>{&second});
+    for (int i = 0; i < 4; ++i) {
+      heapVec.push_back("h");
+    }
+    const auto allocations = first.allocations + second.allocations;
+
+    inlineVec.swap(heapVec);
+    EXPECT_EQ(first.allocations + second.allocations, allocations); // Nothing copied
+    EXPECT_EQ(inlineVec.get_allocator().resource, &second);
+    EXPECT_EQ(inlineVec.size(), 4);
+    EXPECT_FALSE(inlineVec.isInline());
+    EXPECT_EQ(heapVec.get_allocator().resource, &first);
+    EXPECT_EQ(heapVec.size(), 1);
+    EXPECT_EQ(heapVec[0], "i");
+
+    heapVec.swap(inlineVec);
+    EXPECT_EQ(heapVec.get_allocator().resource, &second);
+    EXPECT_EQ(heapVec.size(), 4);
+  }
+  EXPECT_EQ(first.bytesInUse, 0);
+  EXPECT_EQ(second.bytesInUse, 0);
+}
+
+TEST(SmallVectorTest, EmplaceInMiddleAcrossSpill) {
+  SmallVector<std::string, 2> vec;
+  vec.push_back("a");
+  vec.push_back("c");
+  vec.emplace(vec.begin() + 1, vec[0]);
+  vec.emplace(vec.begin() + 1, "b");
+
+  ASSERT_EQ(vec.size(), 4);
+  EXPECT_EQ(vec[0], "a");
+  EXPECT_EQ(vec[1], "b");
+  EXPECT_EQ(vec[2], "a");
+  EXPECT_EQ(vec[3], "c");
+}
+
+TEST(SmallVectorTest, SpillsMoveOnlyTypeWithThrowingMove) {
+  // Cannot be copied, so growth has to move even though moving may throw
+  struct MoveOnly {
+    std::unique_ptr<int> value;
+    explicit MoveOnly(int v) : value{std::make_unique<int>(v)} {
+    }
+    MoveOnly(MoveOnly&& other) noexcept(false) : value{std::move(other.value)} {
+    }
+    MoveOnly& operator=(MoveOnly&&) = default;
+  };
+
+  SmallVector<MoveOnly, 2> vec;
+  vec.emplace_back(1);
+  vec.emplace_back(3);
+  vec.emplace(vec.begin() + 1, 2);
+
+  ASSERT_EQ(vec.size(), 3);
+  EXPECT_FALSE(vec.isInline());
+  EXPECT_EQ(*vec[0].value, 1);
+  EXPECT_EQ(*vec[1].value, 2);
+  EXPECT_EQ(*vec[2].value, 3);
+}
+
+TEST(SmallVectorTest, ResizeAndClear) {
+  SmallVector<int, 4> vec;
+  vec.resize(10);
+  EXPECT_EQ(vec.size(), 10);
+  EXPECT_EQ(vec[9], 0);
+
+  vec.resize(2);
+  EXPECT_EQ(vec.size(), 2);
+
+  size_t cap = vec.capacity();
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.capacity(), cap);
+}
+
+TEST(SmallVectorTest, AccessorsThrowWhenEmpty) {
+  SmallVector<int, 4> vec;
+  EXPECT_THROW(vec.front(), std::out_of_range);
+  EXPECT_THROW(vec.back(), std::out_of_range);
+  EXPECT_THROW(vec.pop_back(), std::out_of_range);
+  EXPECT_THROW(vec.at(0), std::out_of_range);
+}
@@ -0,0 +1,128 @@
+#include "../al/SimdKernels.h"
+#include "../ds/SoAVector.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace {
+  // Throws when constructed from a negative value
+  struct Picky {
+    int value;
+    Picky() : value{0} {}
+    Picky(int v) : value{v} { // NOLINT: implicit on purpose
+      if (v < 0) {
+        throw std::runtime_error("negative");
+      }
+    }
+  };
+} // namespace
+
+TEST(SoAVectorTest, PushBackKeepsColumnsInSync) {
+  SoAVector<int, double, std::string> soa;
+  soa.push_back(1, 1.5, "one");
+  soa.push_back(std::make_tuple(2, 2.5, std::string("two")));
+
+  ASSERT_EQ(soa.size(), 2u);
+  EXPECT_EQ(soa.column<0>().size(), 2u);
+  EXPECT_EQ(soa.column<2>().size(), 2u);
+
+  auto [id, price, name] = soa[1];
+  EXPECT_EQ(id, 2);
+  EXPECT_EQ(price, 2.5);
+  EXPECT_EQ(name, "two");
+
+  id = 20; // Bindings refer into the columns
+  EXPECT_EQ(soa.column<0>()[1], 20);
+}
+
+TEST(SoAVectorTest, ColumnsAreAlignedAndDense) {
+  SoAVector<std::uint8_t, std::int32_t, float> soa;
+  for (int i = 0; i < 1000; ++i) {
+    soa.push_back(static_cast<std::uint8_t>(i), i, static_cast<float>(i));
+  }
+
+  auto ids = soa.column<1>();
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ids.data()) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(soa.column<0>().data()) % 64, 0u);
+  EXPECT_EQ(ids.end() - ids.begin(), 1000);
+
+  EXPECT_EQ(simdSum(ids.data(), ids.size()), 999 * 1000 / 2);
+  EXPECT_EQ(simdMax(soa.column<2>().data(), soa.size()), 999.0f);
+}
+
+TEST(SoAVectorTest, ReserveAndResizeTouchAllColumns) {
+  SoAVector<int, std::string> soa;
+  soa.reserve(100);
+  EXPECT_GE(soa.capacity(), 100u);
+
+  soa.resize(10);
+  EXPECT_EQ(soa.size(), 10u);
+  EXPECT_EQ(std::get<0>(soa[9]), 0);
+  EXPECT_TRUE(std::get<1>(soa[9]).empty());
+
+  soa.resize(3);
+  EXPECT_EQ(soa.column<1>().size(), 3u);
+
+  soa.pop_back();
+  EXPECT_EQ(soa.size(), 2u);
+  soa.clear();
+  EXPECT_TRUE(soa.empty());
+  EXPECT_THROW(soa.pop_back(), std::out_of_range);
+}
+
+TEST(SoAVectorTest, ThrowingFieldLeavesRowsUnchanged) {
+  SoAVector<std::string, Picky> soa;
+  soa.push_back("ok", 1);
+
+  EXPECT_THROW(soa.push_back("bad", -1), std::runtime_error);
+  ASSERT_EQ(soa.size(), 1u);
+  EXPECT_EQ(soa.column<0>().size(), 1u);
+  EXPECT_EQ(std::get<0>(soa[0]), "ok");
+}
+
+TEST(SoAVectorTest, PushBackOwnRowWhileFull) {
+  SoAVector<std::string, int> soa;
+  for (int i = 0; i < 16; ++i) {
+    soa.push_back(std::string(40, static_cast<char>('a' + i)), i); // Heap-allocated strings
+  }
+  ASSERT_EQ(soa.size(), soa.capacity());
+
+  auto [name, number] = soa[3];
+  soa.push_back(name, number); // Both arguments refer into columns that grow
+  ASSERT_EQ(soa.size(), 17u);
+  EXPECT_EQ(std::get<0>(soa[16]), std::string(40, 'd'));
+  EXPECT_EQ(std::get<1>(soa[16]), 3);
+}
+
+TEST(SoAVectorTest, RowIteration) {
+  SoAVector<int, int> soa;
+  for (int i = 0; i < 5; ++i) {
+    soa.push_back(i, i * i);
+  }
+
+  int sum = 0;
+  for (auto [key, square] : soa) {
+    sum += square - key;
+    square = 0;
+  }
+  EXPECT_EQ(sum, 30 - 10);
+
+  const auto& view = soa;
+  for (auto row : view) {
+    EXPECT_EQ(std::get<1>(row), 0);
+  }
+  EXPECT_THROW(view.at(5), std::out_of_range);
+}
+
+TEST(SoAVectorTest, Swap) {
+  SoAVector<int, char> a;
+  a.push_back(1, 'a');
+  SoAVector<int, char> b;
+
+  a.swap(b);
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(std::get<1>(b.at(0)), 'a');
+}
@@ -0,0 +1,174 @@
+#include "../ds/StaticVector.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+  // Table of squares, computed by the compiler
+  constexpr StaticVector<int, 16> makeSquares() {
+    StaticVector<int, 16> table;
+    for (int i = 0; i < 16; ++i) {
+      table.push_back(i * i);
+    }
+    return table;
+  }
+
+  constexpr StaticVector<int, 16> SQUARES = makeSquares();
+
+  static_assert(SQUARES.size() == 16);
+  static_assert(SQUARES[7] == 49);
+  static_assert(SQUARES.back() == 225);
+
+  constexpr int sumWithEdits() {
+    StaticVector<int, 4> vec(2, 5);
+    vec.emplace(vec.begin(), 1);
+    vec.pop_back();
+    vec.resize(4);
+    StaticVector<int, 4> copy = vec;
+    int sum = 0;
+    for (int value : copy) {
+      sum += value;
+    }
+    return sum + (vec.try_push_back(9) == nullptr ? 100 : 0);
+  }
+
+  static_assert(sumWithEdits() == 106);
+
+  struct Counted {
+    static inline int live = 0;
+    int value;
+    explicit Counted(int v) : value{v} {
+      ++live;
+    }
+    Counted(const Counted& other) : value{other.value} {
+      ++live;
+    }
+    Counted(Counted&& other) noexcept : value{other.value} {
+      ++live;
+    }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) noexcept = default;
+    ~Counted() {
+      --live;
+    }
+  };
+} // namespace
+
+TEST(StaticVectorTest, StorageIsInline) {
+  StaticVector<int, 8> vec;
+  EXPECT_EQ(vec.capacity(), 8u);
+  EXPECT_EQ(sizeof(vec), 8 * sizeof(int) + sizeof(std::size_t));
+  EXPECT_TRUE(std::is_trivially_destructible_v<decltype(vec)>);
+  EXPECT_FALSE((std::is_trivially_destructible_v<StaticVector<std::string, 4>>));
+}
+
+TEST(StaticVectorTest, PushBeyondCapacityThrows) {
+  StaticVector<std::string, 2> vec;
+  vec.push_back("a");
+  vec.emplace_back(3, 'b');
+
+  EXPECT_THROW(vec.push_back("c"), std::length_error);
+  EXPECT_THROW(vec.resize(3), std::length_error);
+  EXPECT_THROW(vec.reserve(3), std::length_error);
+  EXPECT_NO_THROW(vec.reserve(2));
+  EXPECT_EQ(vec.size(), 2u);
+  EXPECT_EQ(vec[1], "bbb");
+}
+
+TEST(StaticVectorTest, TryPushBackReportsFull) {
+  StaticVector<std::unique_ptr<int>, 1> vec;
+  auto first = std::make_unique<int>(1);
+  auto second = std::make_unique<int>(2);
+
+  std::unique_ptr<int>* slot = vec.try_push_back(std::move(first));
+  ASSERT_NE(slot, nullptr);
+  EXPECT_EQ(**slot, 1);
+
+  EXPECT_EQ(vec.try_push_back(std::move(second)), nullptr);
+  ASSERT_NE(second, nullptr); // Not moved from when full
+  EXPECT_EQ(vec.try_emplace_back(), nullptr);
+}
+
+TEST(StaticVectorTest, ConstexprTableMatchesRuntime) {
+  for (std::size_t i = 0; i < SQUARES.size(); ++i) {
+    EXPECT_EQ(SQUARES[i], static_cast<int>(i * i));
+  }
+}
+
+TEST(StaticVectorTest, ElementLifetimes) {
+  {
+    StaticVector<Counted, 8> vec;
+    for (int i = 0; i < 5; ++i) {
+      vec.emplace_back(i);
+    }
+    EXPECT_EQ(Counted::live, 5);
+
+    vec.pop_back();
+    vec.resize(2, Counted(9));
+    EXPECT_EQ(Counted::live, 2);
+
+    StaticVector<Counted, 8> copy(vec);
+    EXPECT_EQ(Counted::live, 4);
+
+    StaticVector<Counted, 8> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(Counted::live, 4);
+    EXPECT_EQ(moved[1].value, 1);
+  }
+  EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(StaticVectorTest, EmplaceShiftsAndMayAlias) {
+  StaticVector<std::string, 6> vec;
+  vec.push_back("a");
+  vec.push_back("c");
+  vec.emplace(vec.begin() + 1, "b");
+  vec.emplace(vec.begin(), vec[2]); // Aliases an element that shifts
+
+  ASSERT_EQ(vec.size(), 4u);
+  EXPECT_EQ(vec[0], "c");
+  EXPECT_EQ(vec[1], "a");
+  EXPECT_EQ(vec[2], "b");
+  EXPECT_EQ(vec[3], "c");
+
+  vec.emplace(vec.end(), "d");
+  EXPECT_EQ(vec.back(), "d");
+}
+
+TEST(StaticVectorTest, SwapDifferentSizes) {
+  StaticVector<std::string, 4> a;
+  a.push_back("x");
+  StaticVector<std::string, 4> b;
+  b.push_back("1");
+  b.push_back("2");
+  b.push_back("3");
+
+  a.swap(b);
+  ASSERT_EQ(a.size(), 3u);
+  ASSERT_EQ(b.size(), 1u);
+  EXPECT_EQ(a[2], "3");
+  EXPECT_EQ(b[0], "x");
+}
+
+TEST(StaticVectorTest, AssignmentReplacesContents) {
+  StaticVector<std::string, 3> a(3, "old");
+  StaticVector<std::string, 3> b(1, "new");
+
+  a = b;
+  ASSERT_EQ(a.size(), 1u);
+  EXPECT_EQ(a[0], "new");
+
+  a = std::move(b);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(a.front(), "new");
+}
+
+TEST(StaticVectorTest, AccessorsThrowWhenEmpty) {
+  StaticVector<int, 2> vec;
+  EXPECT_THROW(vec.front(), std::out_of_range);
+  EXPECT_THROW(vec.back(), std::out_of_range);
+  EXPECT_THROW(vec.pop_back(), std::out_of_range);
+  EXPECT_THROW(vec.at(0), std::out_of_range);
+}
@@ -0,0 +1,78 @@
+#include "../al/ThreadPool.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(ThreadPoolTest, RunsSubmittedTasks) {
+  std::atomic<int> counter{0};
+  {
+    ThreadPool pool(4);
+    for (int i = 0; i < 1000; ++i) {
+      pool.submit([&counter] { counter.fetch_add(1); });
+    }
+  } // Destructor drains the queues
+
+  EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPoolTest, ZeroWorkersRunsOnWaitingThread) {
+  ThreadPool pool(0);
+  EXPECT_EQ(pool.workerCount(), 0u);
+  EXPECT_EQ(pool.concurrency(), 1u);
+
+  int counter = 0;
+  TaskGroup group(pool);
+  for (int i = 0; i < 10; ++i) {
+    group.run([&counter] { ++counter; });
+  }
+  group.wait();
+
+  EXPECT_EQ(counter, 10);
+}
+
+namespace {
+  long fib(ThreadPool& pool, int n) {
+    if (n < 12) {
+      return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+    }
+
+    long left = 0;
+    TaskGroup group(pool);
+    group.run([&] { left = fib(pool, n - 1); });
+    const long right = fib(pool, n - 2);
+    group.wait();
+    return left + right;
+  }
+} // namespace
+
+TEST(ThreadPoolTest, NestedGroupsDoNotDeadlock) {
+  ThreadPool pool(3);
+  EXPECT_EQ(fib(pool, 25), 75025);
+}
+
+TEST(ThreadPoolTest, WaitRethrowsTaskException) {
+  ThreadPool pool(2);
+  std::atomic<int> completed{0};
+
+  TaskGroup group(pool);
+  for (int i = 0; i < 20; ++i) {
+    group.run([i, &completed] {
+      if (i == 7) {
+        throw std::runtime_error("task failed");
+      }
+      completed.fetch_add(1);
+    });
+  }
+
+  EXPECT_THROW(group.wait(), std::runtime_error);
+  EXPECT_EQ(completed.load(), 19);
+
+  // The error is consumed by the first wait
+  EXPECT_NO_THROW(group.wait());
+}
+
+TEST(ThreadPoolTest, DefaultPoolIsShared) {
+  EXPECT_EQ(&defaultThreadPool(), &defaultThreadPool());
+  EXPECT_EQ(defaultThreadPool().workerCount(), ThreadPool::defaultWorkerCount());
+}
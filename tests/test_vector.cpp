@@ -1,7 +1,113 @@
 #include "../ds/Vector.h"
+#include "CountingResource.h"
 
 #include <gtest/gtest.h>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+namespace {
+  // Counts live instances so tests can observe element lifetimes.
+  struct Tracked {
+    static inline int live = 0;
+    static inline int constructed = 0;
+
+    int value;
+
+    Tracked() : value{0} {
+      ++live;
+      ++constructed;
+    }
+    explicit Tracked(int v) : value{v} {
+      ++live;
+      ++constructed;
+    }
+    Tracked(const Tracked& other) : value{other.value} {
+      ++live;
+      ++constructed;
+    }
+    Tracked(Tracked&& other) noexcept : value{other.value} {
+      ++live;
+      ++constructed;
+    }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) noexcept = default;
+    ~Tracked() {
+      --live;
+    }
+
+    static void reset() {
+      live = 0;
+      constructed = 0;
+    }
+  };
+
+  // The copy constructor throws once copiesLeft reaches zero (never while negative).
+  struct ThrowingCopy {
+    static inline int copiesLeft = -1;
+
+    int value;
+
+    explicit ThrowingCopy(int v) : value{v} {
+    }
+    ThrowingCopy(const ThrowingCopy& other) : value{other.value} {
+      if (copiesLeft == 0) {
+        throw std::runtime_error("copy failed");
+      }
+      if (copiesLeft > 0) {
+        --copiesLeft;
+      }
+    }
+    ThrowingCopy(ThrowingCopy&&) noexcept = default;
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    ThrowingCopy& operator=(ThrowingCopy&&) noexcept = default;
+  };
+
+  // Walks an array as a single-pass input iterator
+  template <typename T>
+  struct InputOnly {
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const T* current;
+
+    reference operator*() const {
+      return *current;
+    }
+    InputOnly& operator++() {
+      ++current;
+      return *this;
+    }
+    InputOnly operator++(int) {
+      InputOnly old = *this;
+      ++current;
+      return old;
+    }
+    friend bool operator==(InputOnly a, InputOnly b) {
+      return a.current == b.current;
+    }
+    friend bool operator!=(InputOnly a, InputOnly b) {
+      return a.current != b.current;
+    }
+  };
+
+  template <typename Vec>
+  std::vector<int> valuesOf(const Vec& vec) {
+    std::vector<int> values;
+    for (const auto& item : vec) {
+      values.push_back(item.value);
+    }
+    return values;
+  }
+} // namespace
 
 // Construction Tests
 TEST(VectorTest, DefaultConstruction) {
@@ -371,3 +477,493 @@ TEST(VectorTest, WithComplexType) {
   EXPECT_EQ(vec[0], "hello");
   EXPECT_EQ(vec[1], "world");
 }
+
+// Element Lifetime Tests
+TEST(VectorTest, CapacityDoesNotConstructElements) {
+  Tracked::reset();
+  {
+    Vector<Tracked> vec(1000);
+    vec.reserve(5000);
+    EXPECT_EQ(Tracked::constructed, 0);
+    EXPECT_EQ(Tracked::live, 0);
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(VectorTest, OnlyLiveElementsExist) {
+  Tracked::reset();
+  {
+    Vector<Tracked> vec;
+    for (int i = 0; i < 20; ++i) {
+      vec.push_back(Tracked(i));
+    }
+    EXPECT_EQ(Tracked::live, 20);
+
+    vec.pop_back();
+    EXPECT_EQ(Tracked::live, 19);
+
+    vec.resize(5);
+    EXPECT_EQ(Tracked::live, 5);
+
+    vec.resize(8);
+    EXPECT_EQ(Tracked::live, 8);
+    EXPECT_EQ(vec[7].value, 0);
+
+    vec.shrink_to_fit();
+    EXPECT_EQ(Tracked::live, 8);
+    EXPECT_EQ(vec[4].value, 4);
+
+    vec.clear();
+    EXPECT_EQ(Tracked::live, 0);
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(VectorTest, ShrinkToFitEmptyReleasesStorage) {
+  Vector<std::string> vec;
+  vec.push_back("a");
+  vec.clear();
+  vec.shrink_to_fit();
+
+  EXPECT_EQ(vec.capacity(), 0);
+  EXPECT_EQ(vec.data(), nullptr);
+}
+
+// Emplace Tests
+TEST(VectorTest, EmplaceBackConstructsInPlace) {
+  Vector<std::pair<int, std::string>> vec;
+  auto& ref = vec.emplace_back(1, "one");
+  vec.emplace_back(2, "two");
+
+  EXPECT_EQ(ref.first, 1);
+  EXPECT_EQ(vec.size(), 2);
+  EXPECT_EQ(vec[1].second, "two");
+}
+
+TEST(VectorTest, EmplaceBackSkipsTemporaries) {
+  Tracked::reset();
+  Vector<Tracked> vec(4);
+  for (int i = 0; i < 4; ++i) {
+    vec.emplace_back(i);
+  }
+
+  EXPECT_EQ(Tracked::constructed, 4);
+  EXPECT_EQ(vec[3].value, 3);
+}
+
+TEST(VectorTest, PushBackOwnElementDuringGrowth) {
+  Vector<std::string> vec;
+  vec.push_back("first");
+  vec.shrink_to_fit();
+
+  vec.push_back(vec[0]);
+  EXPECT_EQ(vec.size(), 2);
+  EXPECT_EQ(vec[1], "first");
+}
+
+TEST(VectorTest, EmplaceInMiddle) {
+  Vector<std::string> vec;
+  vec.push_back("a");
+  vec.push_back("c");
+
+  auto it = vec.emplace(vec.begin() + 1, "b");
+  EXPECT_EQ(*it, "b");
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec[0], "a");
+  EXPECT_EQ(vec[1], "b");
+  EXPECT_EQ(vec[2], "c");
+}
+
+TEST(VectorTest, EmplaceAtFrontWhenFull) {
+  Vector<std::string> vec;
+  vec.push_back("b");
+  vec.push_back("c");
+  vec.shrink_to_fit();
+
+  vec.emplace(vec.begin(), 1, 'a');
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec[0], "a");
+  EXPECT_EQ(vec[1], "b");
+  EXPECT_EQ(vec[2], "c");
+}
+
+TEST(VectorTest, EmplaceAtEnd) {
+  Vector<int> vec;
+  vec.emplace(vec.end(), 1);
+  vec.emplace(vec.end(), 2);
+
+  EXPECT_EQ(vec.size(), 2);
+  EXPECT_EQ(vec[1], 2);
+}
+
+TEST(VectorTest, EmplaceAliasingElement) {
+  Vector<std::string> vec;
+  vec.reserve(8);
+  vec.push_back("x");
+  vec.push_back("y");
+
+  vec.emplace(vec.begin(), vec[1]);
+  EXPECT_EQ(vec[0], "y");
+  EXPECT_EQ(vec[1], "x");
+  EXPECT_EQ(vec[2], "y");
+}
+
+// Relocation Tests
+TEST(VectorTest, GrowWithTriviallyRelocatableElements) {
+  Vector<std::unique_ptr<int>> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(std::make_unique<int>(i));
+  }
+  vec.emplace(vec.begin() + 50, std::make_unique<int>(-1));
+  vec.shrink_to_fit();
+
+  EXPECT_EQ(vec.size(), 101);
+  EXPECT_EQ(*vec[0], 0);
+  EXPECT_EQ(*vec[50], -1);
+  EXPECT_EQ(*vec[100], 99);
+}
+
+// Allocator Tests
+TEST(VectorTest, PolymorphicAllocatorRoutesAllStorage) {
+  CountingResource resource;
+  {
+    Vector<int, std::pmr::polymorphic_allocator<int>> vec(&resource);
+    for (int i = 0; i < 100; ++i) {
+      vec.push_back(i);
+    }
+    EXPECT_GT(resource.allocations, 0);
+    EXPECT_EQ(vec.get_allocator().resource(), &resource);
+    EXPECT_EQ(vec[99], 99);
+  }
+  EXPECT_EQ(resource.allocations, resource.deallocations);
+  EXPECT_EQ(resource.bytesInUse, 0);
+}
+
+TEST(VectorTest, PolymorphicAllocatorUsesAllocatorConstruction) {
+  CountingResource resource;
+  Vector<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>> vec(&resource);
+  vec.emplace_back("a string long enough to defeat the small string optimization");
+
+  EXPECT_EQ(vec[0].get_allocator().resource(), &resource);
+}
+
+TEST(VectorTest, MoveAssignBetweenUnequalAllocators) {
+  CountingResource first;
+  CountingResource second;
+  using PmrVector = Vector<std::string, std::pmr::polymorphic_allocator<std::string>>;
+
+  PmrVector source(&first);
+  source.push_back("x");
+  source.push_back("y");
+
+  PmrVector target(&second);
+  target = std::move(source);
+
+  EXPECT_EQ(target.get_allocator().resource(), &second);
+  EXPECT_EQ(target.size(), 2);
+  EXPECT_EQ(target[1], "y");
+  EXPECT_TRUE(source.empty());
+}
+
+TEST(VectorTest, CopyKeepsOwnAllocatorWithoutPropagation) {
+  CountingResource first;
+  CountingResource second;
+  using PmrVector = Vector<int, std::pmr::polymorphic_allocator<int>>;
+
+  PmrVector source(3, 7, &first);
+  PmrVector target(&second);
+  target = source;
+
+  EXPECT_EQ(target.get_allocator().resource(), &second);
+  EXPECT_EQ(target[2], 7);
+  EXPECT_GT(second.allocations, 0);
+}
+
+// Growth Policy Tests
+TEST(VectorTest, DefaultGrowthDoubles) {
+  Vector<int> vec;
+  vec.push_back(1);
+  EXPECT_EQ(vec.capacity(), 16);
+
+  for (int i = 0; i < 16; ++i) {
+    vec.push_back(i);
+  }
+  EXPECT_EQ(vec.capacity(), 32);
+}
+
+TEST(VectorTest, HalfAgainGrowthPolicy) {
+  Vector<int, std::allocator<int>, HalfAgainGrowth> vec;
+  for (int i = 0; i < 17; ++i) {
+    vec.push_back(i);
+  }
+
+  EXPECT_EQ(vec.capacity(), 24);
+  EXPECT_EQ(vec[16], 16);
+}
+
+TEST(VectorTest, AdditiveGrowthPolicy) {
+  Vector<int, std::allocator<int>, AdditiveGrowth<100>> vec;
+  for (int i = 0; i < 250; ++i) {
+    vec.push_back(i);
+  }
+
+  EXPECT_EQ(vec.capacity(), 300); // 100, 200, 300
+}
+
+// Resize Variant Tests
+TEST(VectorTest, ResizeWithValue) {
+  Vector<std::string> vec;
+  vec.push_back("a");
+
+  vec.resize(4, "fill");
+  EXPECT_EQ(vec.size(), 4);
+  EXPECT_EQ(vec[0], "a");
+  EXPECT_EQ(vec[3], "fill");
+
+  vec.resize(2, "ignored");
+  EXPECT_EQ(vec.size(), 2);
+  EXPECT_EQ(vec[1], "fill");
+}
+
+TEST(VectorTest, ResizeWithOwnElementAcrossReallocation) {
+  Vector<std::string> vec;
+  vec.push_back("self");
+  vec.shrink_to_fit();
+
+  vec.resize(3, vec[0]);
+  EXPECT_EQ(vec[1], "self");
+  EXPECT_EQ(vec[2], "self");
+}
+
+TEST(VectorTest, ResizeDefaultInitLeavesStorageUntouched) {
+  Vector<int> vec(8);
+  vec.resize(8, 7);
+  vec.clear();
+
+  vec.resize_default_init(8); // Same storage, not zero-filled
+  EXPECT_EQ(vec.size(), 8);
+  for (int value : vec) {
+    EXPECT_EQ(value, 7);
+  }
+
+  vec.resize_default_init(2);
+  EXPECT_EQ(vec.size(), 2);
+}
+
+TEST(VectorTest, ResizeDefaultInitConstructsNonTrivialTypes) {
+  Vector<std::string> vec;
+  vec.resize_default_init(3);
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_TRUE(vec[2].empty());
+}
+
+// Range Tests
+TEST(VectorTest, RangeConstructor) {
+  const std::vector<std::string> source{"a", "b", "c"};
+  Vector<std::string> vec(source.begin(), source.end());
+
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec.capacity(), 3);
+  EXPECT_EQ(vec[2], "c");
+}
+
+TEST(VectorTest, InsertRangeInPlace) {
+  Vector<int> vec;
+  vec.reserve(10);
+  for (int i = 0; i < 4; ++i) {
+    vec.push_back(i);
+  }
+  const int* storage = vec.data();
+
+  const std::vector<int> extra{10, 11, 12};
+  auto it = vec.insert(vec.begin() + 1, extra.begin(), extra.end());
+
+  EXPECT_EQ(vec.data(), storage);
+  EXPECT_EQ(it, vec.begin() + 1);
+  EXPECT_EQ(std::vector<int>(vec.begin(), vec.end()), (std::vector<int>{0, 10, 11, 12, 1, 2, 3}));
+}
+
+TEST(VectorTest, InsertRangeGrowsOnce) {
+  Vector<std::string> vec;
+  vec.push_back("front");
+  vec.push_back("back");
+  vec.shrink_to_fit();
+
+  const std::vector<std::string> extra(100, "mid");
+  vec.insert(vec.begin() + 1, extra.begin(), extra.end());
+
+  EXPECT_EQ(vec.size(), 102);
+  EXPECT_EQ(vec.capacity(), 102); // Doubling from 2 is not enough: exactly the new size
+  EXPECT_EQ(vec[0], "front");
+  EXPECT_EQ(vec[100], "mid");
+  EXPECT_EQ(vec[101], "back");
+}
+
+TEST(VectorTest, InsertOwnElements) {
+  for (std::size_t spare : {0, 10}) {
+    Vector<std::string> vec;
+    vec.reserve(3 + spare);
+    vec.push_back("a");
+    vec.push_back("b");
+    vec.push_back("c");
+
+    vec.insert(vec.begin() + 1, vec.begin(), vec.end());
+    EXPECT_EQ(std::vector<std::string>(vec.begin(), vec.end()),
+              (std::vector<std::string>{"a", "a", "b", "c", "b", "c"}));
+
+    vec.insert(vec.begin(), 2, vec[5]);
+    EXPECT_EQ(vec[0], "c");
+    EXPECT_EQ(vec[1], "c");
+    EXPECT_EQ(vec[2], "a");
+  }
+}
+
+TEST(VectorTest, InsertInputRange) {
+  Vector<int> vec;
+  vec.push_back(1);
+  vec.push_back(5);
+
+  std::istringstream input("2 3 4");
+  auto it = vec.insert(vec.begin() + 1, std::istream_iterator<int>(input),
+                       std::istream_iterator<int>());
+
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(std::vector<int>(vec.begin(), vec.end()), (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST(VectorTest, InsertLeavesVectorUnchangedWhenCopyThrows) {
+  const std::vector<ThrowingCopy> extra(5, ThrowingCopy(9));
+
+  for (std::size_t spare : {0, 10}) {
+    Vector<ThrowingCopy> vec;
+    vec.reserve(3 + spare);
+    for (int i = 0; i < 3; ++i) {
+      vec.emplace_back(i);
+    }
+
+    ThrowingCopy::copiesLeft = 2;
+    EXPECT_THROW(vec.insert(vec.begin() + 1, extra.begin(), extra.end()), std::runtime_error);
+    ThrowingCopy::copiesLeft = -1;
+
+    EXPECT_EQ(vec.capacity(), 3 + spare);
+    EXPECT_EQ(valuesOf(vec), (std::vector<int>{0, 1, 2}));
+  }
+}
+
+TEST(VectorTest, InsertInputRangeRollsBackWhenCopyThrows) {
+  const ThrowingCopy extra[] = {ThrowingCopy(7), ThrowingCopy(8), ThrowingCopy(9)};
+  Vector<ThrowingCopy> vec;
+  for (int i = 0; i < 3; ++i) {
+    vec.emplace_back(i);
+  }
+
+  ThrowingCopy::copiesLeft = 2;
+  EXPECT_THROW(vec.insert(vec.begin() + 1, InputOnly<ThrowingCopy>{extra},
+                          InputOnly<ThrowingCopy>{extra + 3}),
+               std::runtime_error);
+  ThrowingCopy::copiesLeft = -1;
+
+  EXPECT_EQ(valuesOf(vec), (std::vector<int>{0, 1, 2}));
+}
+
+TEST(VectorTest, EraseRange) {
+  Tracked::reset();
+  {
+    Vector<Tracked> vec;
+    for (int i = 0; i < 6; ++i) {
+      vec.emplace_back(i);
+    }
+
+    auto it = vec.erase(vec.begin() + 1, vec.begin() + 4);
+    EXPECT_EQ(it->value, 4);
+    EXPECT_EQ(valuesOf(vec), (std::vector<int>{0, 4, 5}));
+    EXPECT_EQ(Tracked::live, 3);
+
+    it = vec.erase(vec.end() - 1);
+    EXPECT_EQ(it, vec.end());
+    EXPECT_EQ(vec.erase(vec.begin(), vec.begin()), vec.begin());
+    EXPECT_EQ(valuesOf(vec), (std::vector<int>{0, 4}));
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(VectorTest, AssignRangeAndCount) {
+  Vector<std::string> vec;
+  const std::vector<std::string> many(20, "x");
+  vec.assign(many.begin(), many.end());
+  EXPECT_EQ(vec.size(), 20);
+  EXPECT_EQ(vec.capacity(), 20);
+
+  vec.assign(3, std::string("y"));
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec.capacity(), 20);
+  EXPECT_EQ(vec[2], "y");
+
+  vec.push_back("z");
+  vec.assign(vec.begin() + 2, vec.end()); // Own sub-range
+  EXPECT_EQ(std::vector<std::string>(vec.begin(), vec.end()),
+            (std::vector<std::string>{"y", "z"}));
+
+  vec.assign(30, vec[1]);
+  EXPECT_EQ(vec.size(), 30);
+  EXPECT_EQ(vec[29], "z");
+}
+
+TEST(VectorTest, AppendForwardRangeAllocatesOnce) {
+  std::vector<int> source(1 << 20);
+  std::iota(source.begin(), source.end(), 0);
+
+  CountingResource resource;
+  Vector<int, std::pmr::polymorphic_allocator<int>> vec(&resource);
+  vec.append(source.begin(), source.end());
+
+  EXPECT_EQ(resource.allocations, 1);
+  EXPECT_EQ(vec.size(), source.size());
+  EXPECT_EQ(vec[12345], 12345);
+
+  vec.append(3, -1);
+  EXPECT_EQ(resource.allocations, 2);
+  EXPECT_EQ(vec.back(), -1);
+}
+
+#ifdef DS_CONSTEXPR_CONTAINERS
+
+namespace {
+  // Grows through several reallocations and an emplace, all during constant evaluation
+  constexpr int constexprVectorSum() {
+    Vector<int> vec;
+    for (int i = 1; i <= 40; ++i) {
+      vec.push_back(i);
+    }
+    vec.emplace(vec.begin(), 1000);
+    vec.pop_back();
+
+    Vector<int> copy(vec);
+    int sum = 0;
+    for (int value : copy) {
+      sum += value;
+    }
+    return sum;
+  }
+
+  static_assert(constexprVectorSum() == 1000 + 39 * 40 / 2);
+
+  // Range insert (including from the vector itself) and erase at compile time
+  constexpr int constexprRangeOps() {
+    Vector<int> vec;
+    vec.append(3, 1);
+    vec.reserve(16);
+    vec.insert(vec.begin() + 1, vec.begin(), vec.end());
+    vec.erase(vec.begin(), vec.begin() + 2);
+    vec.insert(vec.end(), 2, 5);
+    return static_cast<int>(vec.size()) * 100 + vec[0] + vec[vec.size() - 1];
+  }
+
+  static_assert(constexprRangeOps() == 606);
+} // namespace
+
+TEST(VectorTest, ConstexprEvaluation) {
+  EXPECT_EQ(constexprVectorSum(), 1780);
+}
+
+#endif // DS_CONSTEXPR_CONTAINERS